@@ -27,12 +27,14 @@ void print_node_details(Node *node, size_t index, FILE *out) {
     fprintf(out, "    Incoming weight sum: %.4f\n", node->incoming_weight_sum);
     
     if (node->payload_size > 0 && node->payload_size <= 64) {
+        uint8_t payload[64];
+        size_t payload_size = node_payload_read(node, 0, payload, sizeof(payload));
         fprintf(out, "    Payload preview: ");
-        for (size_t i = 0; i < node->payload_size; i++) {
-            if (node->payload[i] >= 32 && node->payload[i] < 127) {
-                fprintf(out, "%c", node->payload[i]);
+        for (size_t i = 0; i < payload_size; i++) {
+            if (payload[i] >= 32 && payload[i] < 127) {
+                fprintf(out, "%c", payload[i]);
             } else {
-                fprintf(out, "\\x%02x", node->payload[i]);
+                fprintf(out, "\\x%02x", payload[i]);
             }
         }
         fprintf(out, "\n");
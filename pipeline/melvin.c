@@ -15,6 +15,8 @@
  * - Self-regulating: automatically saves after each adaptation
  */
 
+#define _POSIX_C_SOURCE 200809L  /* clock_gettime / CLOCK_MONOTONIC */
+
 #include "melvin.h"
 #include "melvin_gpu.h"
 #include "melvin_threads.h"
@@ -72,7 +74,8 @@ static MelvinGPUContext* get_cached_gpu_context(void) {
         pthread_mutex_lock(&g_gpu_mutex);
         if (!g_gpu_checked) {
             g_gpu_ctx = melvin_gpu_get_context();
-            g_gpu_available = (g_gpu_ctx && melvin_gpu_is_available(g_gpu_ctx));
+            /* Batch backend = CUDA or vectorized CPU (selected automatically when CUDA is absent) */
+            g_gpu_available = melvin_gpu_has_batch_backend(g_gpu_ctx);
             g_gpu_checked = true;
         }
         pthread_mutex_unlock(&g_gpu_mutex);
@@ -160,6 +163,116 @@ static int compare_priority_candidates(const void *a, const void *b) {
     return 0;
 }
 
+/* SPARSE PROPAGATION: Partial selection of the k highest scores (quickselect, O(n) average) */
+/* Reorders indices so indices[0..k-1] reference the k largest scores (unordered among themselves) */
+/* Avoids a full O(n log n) sort when only the strongest k candidates are needed */
+static void select_top_k_indices(const float *scores, size_t *indices, size_t count, size_t k) {
+    if (!scores || !indices || k == 0 || k >= count) return;
+    
+    size_t target = k - 1;
+    size_t lo = 0;
+    size_t hi = count - 1;
+    
+    while (lo < hi) {
+        /* Median-of-three pivot (robust against already-ordered edge arrays) */
+        size_t mid = lo + (hi - lo) / 2;
+        float a = scores[indices[lo]];
+        float b = scores[indices[mid]];
+        float c = scores[indices[hi]];
+        float pivot = (a > b) ? ((b > c) ? b : ((a > c) ? c : a)) :
+                                ((a > c) ? a : ((b > c) ? c : b));
+        
+        /* Three-way partition (descending): [lo,lt) > pivot, [lt,gt) == pivot, [gt,hi] < pivot */
+        size_t lt = lo, i = lo, gt = hi + 1;
+        while (i < gt) {
+            float score = scores[indices[i]];
+            if (score > pivot) {
+                size_t tmp = indices[lt]; indices[lt] = indices[i]; indices[i] = tmp;
+                lt++; i++;
+            } else if (score < pivot) {
+                gt--;
+                size_t tmp = indices[gt]; indices[gt] = indices[i]; indices[i] = tmp;
+            } else {
+                i++;
+            }
+        }
+        
+        if (target < lt) {
+            hi = lt - 1;
+        } else if (target >= gt) {
+            lo = gt;
+        } else {
+            return;  /* Target falls inside the pivot run - selection complete */
+        }
+    }
+}
+
+/* ========================================
+ * OUTPUT SAMPLING PRNG (xoshiro256**, per brain)
+ * ======================================== */
+
+/* SplitMix64 step: expands a 64-bit seed into well-mixed state words */
+static uint64_t splitmix64_next(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static void melvin_rng_seed(MelvinRng *rng, uint64_t seed) {
+    uint64_t x = seed;
+    for (int i = 0; i < 4; i++) {
+        rng->s[i] = splitmix64_next(&x);  /* Never all-zero (SplitMix64 is a bijection of distinct inputs) */
+    }
+}
+
+static inline uint64_t rng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/* xoshiro256**: a few shifts/xors per draw, no locks, state owned by the caller */
+static uint64_t melvin_rng_next(MelvinRng *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+    return result;
+}
+
+/* Uniform float in [0, 1) from the top 24 bits (exactly representable) */
+static float melvin_rng_float(MelvinRng *rng) {
+    return (float)(melvin_rng_next(rng) >> 40) * (1.0f / 16777216.0f);
+}
+
+/* Seed the brain's output sampling (same seed + same inputs = same outputs) */
+void graph_set_seed(MelvinGraph *g, uint64_t seed) {
+    if (!g) return;
+    g->output_seed = seed;
+    melvin_rng_seed(&g->output_rng, seed);
+}
+
+/* SAMPLING: Fast output sampling for nodes with at least alias_min_degree outgoing edges */
+/* 0 = exact per-step sampling (default, original behavior) */
+void graph_set_fast_sampling(MelvinGraph *g, size_t alias_min_degree) {
+    if (!g) return;
+    g->output_alias_min_degree = alias_min_degree;
+}
+
+/* DECODING: Default mode and caps for output generation (NULL = unbounded sampling, original behavior) */
+void graph_set_decoding(MelvinGraph *g, const MelvinDecodeConfig *config) {
+    if (!g) return;
+    if (config) {
+        g->decode = *config;
+    } else {
+        memset(&g->decode, 0, sizeof(g->decode));
+    }
+}
+
 /* ========================================
  * HASH SET FOR NODE POINTERS (O(1) visited tracking)
  * ======================================== */
@@ -322,6 +435,63 @@ static float compute_initial_smoothing(Node *node);
 /* OPTIMIZATION: Forward declaration for cache invalidation */
 static void node_invalidate_avg_cache(Node *node);
 
+/* SAMPLING: Walker alias table over one node's output candidates (fast sampling) */
+/* Scores are stored temperature-free, so a new temperature only re-tempers - no edge is rescored */
+struct OutputAliasTable {
+    size_t count;        /* Candidates (edges with a positive score) */
+    size_t capacity;
+    bool valid;          /* Cleared with the node's averages whenever its edge weights change */
+    float exponent;      /* Quantized 1/temperature the tempered weights were built for (0 = none) */
+    float total;         /* Sum of tempered weights */
+    Node **targets;
+    float *base;         /* Temperature-free score (transform at activation 1 x co-activation share) */
+    float *tempered;     /* base^exponent */
+    float *prob;         /* Alias acceptance threshold per slot */
+    uint32_t *alias;     /* Alias candidate per slot */
+};
+
+static void output_alias_free(OutputAliasTable *table) {
+    if (!table) return;
+    free(table->targets);
+    free(table->base);
+    free(table->tempered);
+    free(table->prob);
+    free(table->alias);
+    free(table);
+}
+
+/* MEMOIZATION: One finished output, valid while the graph's structure_version is unchanged */
+typedef struct OutputCacheEntry {
+    Node *start;                 /* First direct input node (where the walk began) */
+    uint64_t context_hash;       /* last_activated fingerprint */
+    MelvinDecodeConfig decode;   /* Mode and caps the output was generated with */
+    uint64_t structure_version;  /* Graph structure the walk saw */
+    uint8_t *output;
+    size_t output_size;
+    size_t newer, older;         /* LRU list (SIZE_MAX = end) */
+    size_t chain;                /* Next entry in the same bucket (SIZE_MAX = end) */
+} OutputCacheEntry;
+
+/* MEMOIZATION: Bounded LRU of outputs - entries grow on demand up to capacity, then the least */
+/* recently used one is reused. Chained buckets on (start, context, decode); links are indices */
+struct OutputCache {
+    OutputCacheEntry *entries;
+    size_t count;
+    size_t entries_capacity;
+    size_t capacity;       /* Entry bound set by the caller */
+    size_t *buckets;       /* Head entry per bucket (SIZE_MAX = empty) */
+    size_t bucket_count;   /* Power of two */
+    size_t newest, oldest; /* LRU ends (SIZE_MAX = empty) */
+};
+
+static void output_cache_free(OutputCache *cache) {
+    if (!cache) return;
+    for (size_t i = 0; i < cache->count; i++) free(cache->entries[i].output);
+    free(cache->entries);
+    free(cache->buckets);
+    free(cache);
+}
+
 /* ========================================
  * UTILITY FUNCTIONS
  * ======================================== */
@@ -330,11 +500,44 @@ static void node_invalidate_avg_cache(Node *node);
  * CACHED STATE MAINTENANCE (O(1) incremental updates)
  * ======================================== */
 
+/* LAZY: Mark the efficiency order dirty only if edge's new weight crossed a neighbour */
+/* While clean, outgoing_edges is weight-descending with edge still at its old_weight slot: */
+/* binary search finds that slot (O(log degree)), then only the two neighbours are compared. */
+/* Not finding it (several weights changed before their checks) conservatively marks dirty. */
+/* Edges are never moved here - callers iterate outgoing_edges by index while updating weights */
+static void node_check_outgoing_order(Node *node, Edge *edge, float old_weight) {
+    if (node->outgoing_order_dirty || node->outgoing_count < 2) return;
+    Edge **edges = node->outgoing_edges;
+    size_t count = node->outgoing_count;
+    
+    /* First slot whose weight is <= old_weight (NULLs sort last) */
+    size_t lo = 0, hi = count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        float mid_weight = (edges[mid] == edge) ? old_weight : (edges[mid] ? (float)edges[mid]->weight : -FLT_MAX);
+        if (mid_weight > old_weight) lo = mid + 1;
+        else hi = mid;
+    }
+    size_t i = lo;
+    while (i < count && edges[i] != edge && edges[i] && edges[i]->weight == old_weight) i++;  /* Ties */
+    if (i >= count || edges[i] != edge) {
+        node->outgoing_order_dirty = true;
+        return;
+    }
+    
+    float weight = edge->weight;
+    if ((i > 0 && edges[i - 1]->weight < weight) ||
+        (i + 1 < count && edges[i + 1] && edges[i + 1]->weight > weight)) {
+        node->outgoing_order_dirty = true;
+    }
+}
+
 /* Update cached outgoing weight sum when edge weight changes (O(1)) */
-static void node_update_outgoing_weight_sum(Node *node, float old_weight, float new_weight) {
+static void node_update_outgoing_weight_sum(Node *node, Edge *edge, float old_weight, float new_weight) {
     if (!node) return;
     node->outgoing_weight_sum = node->outgoing_weight_sum - old_weight + new_weight;
     node_invalidate_avg_cache(node);  /* OPTIMIZATION: Invalidate cache when weights change */
+    if (old_weight != new_weight) node_check_outgoing_order(node, edge, old_weight);  /* Efficiency order may change */
 }
 
 /* Update cached incoming weight sum when edge weight changes (O(1)) */
@@ -349,6 +552,12 @@ static void node_add_outgoing_weight(Node *node, float weight) {
     if (!node) return;
     node->outgoing_weight_sum += weight;
     node_invalidate_avg_cache(node);  /* OPTIMIZATION: Invalidate cache when edges added */
+    
+    /* LAZY: The appended edge is in efficiency order if it's no stronger than the last one */
+    if (node->outgoing_count > 1 && !node->outgoing_order_dirty) {
+        Edge *last = node->outgoing_edges[node->outgoing_count - 2];
+        if (!last || last->weight < weight) node->outgoing_order_dirty = true;
+    }
 }
 
 /* Add edge weight to cached sums when edge is added (O(1)) */
@@ -358,6 +567,109 @@ static void node_add_incoming_weight(Node *node, float weight) {
     node_invalidate_avg_cache(node);  /* OPTIMIZATION: Invalidate cache when edges added */
 }
 
+/* DELTA-DRIVEN: Re-transform edge input and push the difference into to_node's running sum */
+/* Called whenever the edge weight or the source activation changes - O(1) per edge */
+static void edge_refresh_input_contribution(Edge *edge) {
+    if (!edge || !edge->connected || !edge->from_node || !edge->to_node) return;
+    
+    float contribution = edge_transform_activation(edge, edge->from_node->activation_strength);
+    edge->to_node->incoming_activation_sum += contribution - edge->input_contribution;
+    edge->input_contribution = contribution;
+}
+
+/* DELTA-DRIVEN: Refresh every outgoing contribution of a node (source-side reconciliation) */
+static void node_refresh_outgoing_contributions(Node *node) {
+    if (!node) return;
+    for (size_t i = 0; i < node->outgoing_count; i++) {
+        edge_refresh_input_contribution(node->outgoing_edges[i]);
+    }
+}
+
+/* DELTA-DRIVEN: List an edge at its target as needing a re-transform (O(1), once until read) */
+static void edge_mark_contribution_stale(Edge *edge) {
+    if (edge->contribution_stale) return;
+    Node *to = edge->to_node;
+    if (!to) return;
+    if (to->stale_input_count >= to->stale_input_capacity) {
+        size_t new_cap = (to->stale_input_capacity == 0) ? 1 : to->stale_input_capacity * 2;  /* Minimal context: start at 1 */
+        Edge **new_list = (Edge**)realloc(to->stale_inputs, new_cap * sizeof(Edge*));
+        if (!new_list) {
+            to->inputs_all_stale = true;  /* Can't list it - the next read re-transforms every input */
+            return;
+        }
+        to->stale_inputs = new_list;
+        to->stale_input_capacity = new_cap;
+    }
+    to->stale_inputs[to->stale_input_count++] = edge;
+    edge->contribution_stale = true;
+    if (edge->from_node) edge->from_node->stale_output_count++;
+}
+
+/* DELTA-DRIVEN: A node's averages or weight moved. edge_transform_activation reads the source's */
+/* averages (inhibition, similarity threshold) and pattern similarity reads both endpoints' */
+/* averages and weights, so every contribution at this node, in or out, is now stale. */
+/* Incoming: one flag (O(1)). Outgoing: each edge is listed at its target once until that target */
+/* reads - a node whose outgoing edges are all listed already costs O(1) */
+static void node_mark_contributions_changed(Node *node) {
+    node->inputs_all_stale = true;
+    if (node->stale_output_count >= node->outgoing_count) return;
+    for (size_t i = 0; i < node->outgoing_count; i++) {
+        Edge *edge = node->outgoing_edges[i];
+        if (edge) edge_mark_contribution_stale(edge);
+    }
+}
+
+/* DELTA-DRIVEN: Clear an edge's stale listing (its target is reconciling it) */
+static void edge_clear_contribution_stale(Edge *edge) {
+    if (!edge->contribution_stale) return;
+    edge->contribution_stale = false;
+    if (edge->from_node) edge->from_node->stale_output_count--;
+}
+
+/* DELTA-DRIVEN: Re-transform the incoming edges listed stale since the last read (or all of them */
+/* when this node itself moved), so incoming_activation_sum matches a full recompute. Touches only */
+/* what changed. An inactive source contributes 0 whatever its state - no transform needed. */
+static void node_reconcile_input_contributions(Node *node) {
+    if (node->inputs_all_stale) {
+        node->inputs_all_stale = false;
+        for (size_t i = 0; i < node->incoming_count; i++) {
+            Edge *edge = node->incoming_edges[i];
+            if (!edge) continue;
+            edge_clear_contribution_stale(edge);
+            if (edge->from_node && edge->from_node->activation_strength != 0.0f) {
+                edge_refresh_input_contribution(edge);
+            }
+        }
+        node->stale_input_count = 0;
+        return;
+    }
+    
+    for (size_t i = 0; i < node->stale_input_count; i++) {
+        Edge *edge = node->stale_inputs[i];
+        edge_clear_contribution_stale(edge);
+        if (edge->from_node && edge->from_node->activation_strength != 0.0f) {
+            edge_refresh_input_contribution(edge);
+        }
+    }
+    node->stale_input_count = 0;
+}
+
+/* DELTA-DRIVEN: Weighted input sum with stale contributions reconciled (gathers read this) */
+float node_get_input_sum(Node *node) {
+    if (!node) return 0.0f;
+    node_reconcile_input_contributions(node);
+    return fmaxf(node->incoming_activation_sum, 0.0f);  /* Clamp float rounding drift */
+}
+
+/* DELTA-DRIVEN: Set node activation and propagate the change to outgoing edge contributions */
+/* Receivers read their running sum in O(1) instead of re-summing all incoming edges */
+void node_set_activation_strength(Node *node, float activation) {
+    if (!node || node->activation_strength == activation) return;  /* No change = no delta */
+    
+    node->activation_strength = activation;
+    node_refresh_outgoing_contributions(node);
+}
+
 /* ========================================
  * NODE OPERATIONS (Local Only)
  * ======================================== */
@@ -386,6 +698,7 @@ Node* node_create(const uint8_t *payload_data, size_t payload_size) {
     
     /* Store payload size */
     node->payload_size = payload_size;
+    node->payload_inline = true;
     
     /* Copy payload data directly into node (stored inline) */
     if (payload_data && payload_size > 0) {
@@ -401,21 +714,24 @@ Node* node_create(const uint8_t *payload_data, size_t payload_size) {
     /* Initialize cached state */
     node->outgoing_weight_sum = 0.0f;
     node->incoming_weight_sum = 0.0f;
+    node->incoming_activation_sum = 0.0f;
     
     /* OPTIMIZATION: Initialize cache fields */
     node->cached_local_outgoing_avg = 0.0f;
     node->cached_local_incoming_avg = 0.0f;
     node->avg_cache_valid = false;
+    node->stale_inputs = NULL;
+    node->stale_input_count = 0;
+    node->stale_input_capacity = 0;
+    node->stale_output_count = 0;
+    node->inputs_all_stale = false;
+    node->outgoing_order_dirty = false;  /* No edges yet - trivially ordered */
     node->last_edge_lookup_target = NULL;
     node->last_edge_lookup_result = NULL;
     node->edge_lookup_cache_hits = 0;
     
-    /* Initialize adaptive learning rate tracking */
-    /* RELATIVE: Use minimal context - start with 1, grows immediately like nature */
-    node->weight_change_capacity = 1;  /* Absolute minimum, grows immediately when data arrives */
+    /* Initialize adaptive learning rate tracking (streaming estimator, no history yet) */
     node->weight_change_count = 0;
-    node->recent_weight_changes = (float*)calloc(node->weight_change_capacity, sizeof(float));
-    node->weight_change_index = 0;
     node->change_rate_avg = 0.0f;
     
     /* Initialize edge arrays */
@@ -435,6 +751,277 @@ Node* node_create(const uint8_t *payload_data, size_t payload_size) {
     return node;
 }
 
+/* ========================================
+ * ROPE PAYLOADS (Hierarchy nodes reference their parts)
+ * ======================================== */
+
+/* READ-ONLY: Set while this thread serves a query - shared caches are read, never filled */
+/* (queries run concurrently against one graph, so lazily cached state must not be written) */
+static _Thread_local bool tls_read_only_query = false;
+
+/* ROPE: Bytes directly addressable for this node (inline or flattened), NULL = walk the parts */
+static inline const uint8_t* node_payload_direct(const Node *node) {
+    if (node->payload_inline) return node->payload;
+    return __atomic_load_n(&node->payload_flat, __ATOMIC_ACQUIRE);
+}
+
+/* Visit bytes [offset, offset + len) of a node as contiguous spans, in order */
+/* visit returns false to stop early; the walk returns false if it was stopped */
+typedef bool (*PayloadSpanVisit)(const uint8_t *bytes, size_t len, size_t position, void *ctx);
+
+static bool payload_walk(const Node *node, size_t offset, size_t len, size_t position,
+                         PayloadSpanVisit visit, void *ctx) {
+    while (len > 0) {
+        const uint8_t *bytes = node_payload_direct(node);
+        if (bytes) return visit(bytes + offset, len, position, ctx);
+        
+        const Node *left = node->payload_left;
+        size_t left_size = left->payload_size;
+        if (offset >= left_size) {
+            offset -= left_size;
+            node = node->payload_right;
+        } else if (offset + len <= left_size) {
+            node = left;
+        } else {
+            /* Span crosses the split: left part here, continue into the right part */
+            size_t head = left_size - offset;
+            if (!payload_walk(left, offset, head, position, visit, ctx)) return false;
+            node = node->payload_right;
+            offset = 0;
+            len -= head;
+            position += head;
+        }
+    }
+    return true;
+}
+
+static bool payload_visit_copy(const uint8_t *bytes, size_t len, size_t position, void *ctx) {
+    memcpy((uint8_t*)ctx + position, bytes, len);
+    return true;
+}
+
+/* Materialize a rope node's bytes into its flattening cache (safe against concurrent readers) */
+static const uint8_t* node_payload_flatten(Node *node) {
+    const uint8_t *bytes = node_payload_direct(node);
+    if (bytes || node->payload_size == 0) return bytes;
+    
+    uint8_t *flat = (uint8_t*)malloc(node->payload_size);
+    if (!flat) return NULL;
+    payload_walk(node, 0, node->payload_size, 0, payload_visit_copy, flat);
+    
+    /* First writer wins; a concurrent flatten of the same node frees its copy */
+    uint8_t *expected = NULL;
+    if (!__atomic_compare_exchange_n(&node->payload_flat, &expected, flat, false,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        free(flat);
+        return expected;
+    }
+    return flat;
+}
+
+/* ROPE: A streamed read of an unflattened node. A flat copy costs one byte per payload byte, */
+/* so a node is hot once it has been read more times than it has bytes (copy paid per read) */
+static void node_payload_note_read(Node *node) {
+    if (node->payload_inline || tls_read_only_query) return;
+    uint32_t reads = __atomic_add_fetch(&node->payload_reads, 1, __ATOMIC_RELAXED);
+    if ((size_t)reads >= node->payload_size) {
+        node_payload_flatten(node);
+    }
+}
+
+/* Visit bytes [offset, offset + len) of node (len clamped to the payload) */
+static bool node_payload_visit(Node *node, size_t offset, size_t len, PayloadSpanVisit visit, void *ctx) {
+    if (offset >= node->payload_size) return true;
+    if (len > node->payload_size - offset) len = node->payload_size - offset;
+    if (len == 0) return true;
+    
+    const uint8_t *bytes = node_payload_direct(node);
+    if (bytes) return visit(bytes + offset, len, 0, ctx);
+    
+    node_payload_note_read(node);
+    return payload_walk(node, offset, len, 0, visit, ctx);
+}
+
+size_t node_payload_read(Node *node, size_t offset, uint8_t *dst, size_t len) {
+    if (!node || !dst || offset >= node->payload_size) return 0;
+    if (len > node->payload_size - offset) len = node->payload_size - offset;
+    node_payload_visit(node, offset, len, payload_visit_copy, dst);
+    return len;
+}
+
+uint8_t node_payload_at(Node *node, size_t index) {
+    uint8_t byte = 0;
+    node_payload_read(node, index, &byte, 1);
+    return byte;
+}
+
+const uint8_t* node_payload_data(Node *node) {
+    if (!node || node->payload_size == 0) return NULL;
+    const uint8_t *bytes = node_payload_direct(node);
+    if (bytes) return bytes;
+    return node_payload_flatten(node);
+}
+
+typedef struct PayloadCompare {
+    const uint8_t *bytes;  /* Bytes to compare against (indexed by span position) */
+    size_t match_bytes;
+    size_t mismatches;
+    size_t max_mismatches; /* Stop once exceeded (SIZE_MAX = count everything) */
+} PayloadCompare;
+
+static bool payload_visit_equal(const uint8_t *bytes, size_t len, size_t position, void *ctx) {
+    PayloadCompare *cmp = (PayloadCompare*)ctx;
+    return memcmp(bytes, cmp->bytes + position, len) == 0;
+}
+
+/* Node bytes [offset, offset + len) equal `bytes` (false if the node is shorter) */
+static bool node_payload_equals(Node *node, size_t offset, const uint8_t *bytes, size_t len) {
+    if (offset > node->payload_size || len > node->payload_size - offset) return false;
+    const uint8_t *direct = node_payload_direct(node);
+    if (direct) return memcmp(direct + offset, bytes, len) == 0;
+    PayloadCompare cmp = { bytes, 0, 0, 0 };
+    return node_payload_visit(node, offset, len, payload_visit_equal, &cmp);
+}
+
+typedef struct PayloadNodeCompare {
+    Node *node;     /* Node whose bytes are compared */
+    size_t offset;  /* Where the other node's bytes start within it */
+} PayloadNodeCompare;
+
+static bool payload_visit_equal_node(const uint8_t *bytes, size_t len, size_t position, void *ctx) {
+    PayloadNodeCompare *cmp = (PayloadNodeCompare*)ctx;
+    return node_payload_equals(cmp->node, cmp->offset + position, bytes, len);
+}
+
+/* Node bytes starting at offset equal all of part's bytes (no copies of either side) */
+static bool node_payload_equals_node(Node *node, size_t offset, Node *part) {
+    if (offset > node->payload_size || part->payload_size > node->payload_size - offset) return false;
+    PayloadNodeCompare cmp = { node, offset };
+    return node_payload_visit(part, 0, part->payload_size, payload_visit_equal_node, &cmp);
+}
+
+/* Node is exactly left's bytes followed by right's (structurally, or byte for byte) */
+static bool node_payload_is_combination(Node *node, Node *left, Node *right) {
+    if (node->payload_left == left && node->payload_right == right) return true;
+    if (node->payload_size != left->payload_size + right->payload_size) return false;
+    return node_payload_equals_node(node, 0, left) &&
+           node_payload_equals_node(node, left->payload_size, right);
+}
+
+static inline bool payload_count_span(PayloadCompare *cmp, const uint8_t *bytes, size_t len, size_t position) {
+    const uint8_t *pattern = cmp->bytes + position;
+    
+    /* CPU OPTIMIZATION: Use SIMD for large comparisons, scalar for small ones */
+    if (len >= 16) {
+        size_t match_bytes = 0, mismatches = 0;
+        simd_compare_bytes(bytes, pattern, len, &match_bytes, &mismatches);
+        cmp->match_bytes += match_bytes;
+        cmp->mismatches += mismatches;
+        return cmp->mismatches <= cmp->max_mismatches;
+    }
+    size_t match_bytes = 0;
+    if (cmp->max_mismatches == SIZE_MAX) {
+        for (size_t i = 0; i < len; i++) match_bytes += (bytes[i] == pattern[i]);
+        cmp->match_bytes += match_bytes;
+        cmp->mismatches += len - match_bytes;
+        return true;
+    }
+    size_t mismatches = cmp->mismatches;
+    bool within = true;
+    for (size_t i = 0; i < len; i++) {
+        if (bytes[i] == pattern[i]) {
+            match_bytes++;
+        } else if (++mismatches > cmp->max_mismatches) {
+            within = false;  /* Early exit - mismatch rate exceeds the caller's threshold */
+            break;
+        }
+    }
+    cmp->match_bytes += match_bytes;
+    cmp->mismatches = mismatches;
+    return within;
+}
+
+static bool payload_visit_count_matches(const uint8_t *bytes, size_t len, size_t position, void *ctx) {
+    return payload_count_span((PayloadCompare*)ctx, bytes, len, position);
+}
+
+/* Count positions where node bytes [0, len) equal pattern, stopping past max_mismatches */
+static inline size_t node_payload_count_matches(Node *node, const uint8_t *pattern, size_t len,
+                                                size_t max_mismatches, size_t *mismatches) {
+    PayloadCompare cmp = { pattern, 0, 0, max_mismatches };
+    const uint8_t *bytes = node_payload_direct(node);
+    if (bytes) {
+        /* OPTIMIZATION: Flat bytes (the common case) compare in place - no span walk */
+        if (len > node->payload_size) len = node->payload_size;
+        payload_count_span(&cmp, bytes, len, 0);
+    } else {
+        node_payload_visit(node, 0, len, payload_visit_count_matches, &cmp);
+    }
+    if (mismatches) *mismatches = cmp.mismatches;
+    return cmp.match_bytes;
+}
+
+/* Contiguous view of a node's bytes for APIs that take a pattern pointer: direct when stored */
+/* flat, otherwise streamed into scratch (or a heap copy returned in *owned - caller frees) */
+static const uint8_t* node_payload_borrow(Node *node, uint8_t *scratch, size_t scratch_size, uint8_t **owned) {
+    *owned = NULL;
+    const uint8_t *bytes = node_payload_direct(node);
+    if (bytes || node->payload_size == 0) return bytes;
+    
+    uint8_t *dst = scratch;
+    if (node->payload_size > scratch_size) {
+        dst = *owned = (uint8_t*)malloc(node->payload_size);
+        if (!dst) return NULL;
+    }
+    node_payload_read(node, 0, dst, node->payload_size);
+    return dst;
+}
+
+/* ROPE: Payloads up to one cache line stay inline - copying them costs less than walking parts */
+#define ROPE_INLINE_MAX 64
+
+/* Create a node whose payload is left's bytes followed by right's */
+/* ROPE: Only the two part references are stored - bytes beneath are shared, not copied. */
+/* Short payloads are copied inline (see ROPE_INLINE_MAX), the parts are still recorded. */
+Node* node_create_rope(Node *left, Node *right) {
+    if (!left || !right) return NULL;
+    
+    size_t combined_size = left->payload_size + right->payload_size;
+    Node *node;
+    if (combined_size <= ROPE_INLINE_MAX) {
+        uint8_t bytes[ROPE_INLINE_MAX];
+        node_payload_read(left, 0, bytes, left->payload_size);
+        node_payload_read(right, 0, bytes + left->payload_size, right->payload_size);
+        node = node_create(bytes, combined_size);
+    } else {
+        node = node_create(NULL, 0);
+        if (node) {
+            node->payload_size = combined_size;
+            node->payload_inline = false;
+        }
+    }
+    if (!node) return NULL;
+    
+    node->payload_left = left;
+    node->payload_right = right;
+    
+    /* Abstraction level: max of parts + 1 */
+    node->abstraction_level = ((left->abstraction_level > right->abstraction_level) ?
+        left->abstraction_level : right->abstraction_level) + 1;
+    return node;
+}
+
+void graph_release_payload_caches(MelvinGraph *g) {
+    if (!g) return;
+    for (size_t i = 0; i < g->node_count; i++) {
+        Node *node = g->nodes[i];
+        if (!node || !node->payload_flat) continue;
+        free(node->payload_flat);
+        node->payload_flat = NULL;
+        node->payload_reads = 0;
+    }
+}
+
 /* Compute median of adaptive-size array */
 static float compute_median_adaptive(float *values, size_t count) {
     if (!values || count == 0) return 0.0f;
@@ -807,132 +1394,35 @@ static float compute_initial_smoothing(Node *node) {
 
 /* Compute adaptive bucket growth trigger based on data variance (relative adaptive stability, no fallbacks) */
 
-/* Adapt rolling window size based on observed change rate (self-regulating) */
-static void node_adapt_rolling_window(Node *node) {
-    if (!node || !node->recent_weight_changes || node->weight_change_count == 0) return;
-    
-    /* DATA-DRIVEN: Compute average change rate from observed changes */
-    float avg_change = 0.0f;
-    for (size_t i = 0; i < node->weight_change_count; i++) {
-        avg_change += node->recent_weight_changes[i];
-    }
-    avg_change /= node->weight_change_count;
-    node->change_rate_avg = avg_change;
-    
-    /* DATA-DRIVEN: Adapt window size based on change rate */
-    /* Fast changes (high rate) → smaller window (focus on recent) */
-    /* Slow changes (low rate) → larger window (need more history) */
-    /* RELATIVE: Compute window size from data, not hardcoded values */
-    size_t optimal_size = 1;  /* Start with minimum, compute from data */
-    if (node->weight_change_count > 1) {
-        /* Use median of observed changes as threshold */
-        float *sorted = (float*)malloc(node->weight_change_count * sizeof(float));
-        if (sorted) {
-            memcpy(sorted, node->recent_weight_changes, node->weight_change_count * sizeof(float));
-            qsort(sorted, node->weight_change_count, sizeof(float), compare_float);
-            float median_change = sorted[node->weight_change_count / 2];
-            free(sorted);
-            
-            /* RELATIVE: Compute window size from change rate relative to median */
-            /* Use change rate relative to median to determine window size */
-            if (median_change > 0.0f) {
-                float relative_rate = avg_change / (median_change + compute_adaptive_epsilon(median_change));
-                
-                /* Window size scales inversely with relative change rate */
-                /* High relative rate → smaller window, low relative rate → larger window */
-                /* Use x / (x + 1.0f) pattern for normalization */
-                float window_factor = relative_rate / (relative_rate + 1.0f);
-                /* Invert: high rate → small window, so use (1 - factor) */
-                float window_scale = 1.0f - window_factor;
-                
-                /* Compute base window size from current data count */
-                /* Window size relative to data available */
-                size_t base_window = node->weight_change_count;
-                /* Scale window based on relative change rate */
-                optimal_size = (size_t)(base_window * window_scale);
-                /* Ensure minimum of 1 */
-                if (optimal_size < 1) optimal_size = 1;
-                /* Cap at reasonable maximum relative to data count */
-                if (optimal_size > base_window) optimal_size = base_window;
-            } else {
-                /* Median is zero: use minimal context (data count itself) */
-                optimal_size = (node->weight_change_count > 1) ? node->weight_change_count : 1;
-            }
-        }
-    } else if (node->weight_change_count == 1) {
-        /* RELATIVE: Single value - use it as minimal context */
-        /* Window size relative to single observed value */
-        float single_change = node->recent_weight_changes[0];
-        if (single_change > 0.0f && avg_change > 0.0f) {
-            /* Compute relative to single change */
-            float relative_rate = avg_change / (single_change + compute_adaptive_epsilon(single_change));
-            float window_factor = relative_rate / (relative_rate + 1.0f);
-            float window_scale = 1.0f - window_factor;
-            optimal_size = (size_t)(node->weight_change_count * window_scale);
-            if (optimal_size < 1) optimal_size = 1;
-        } else {
-            optimal_size = 1;  /* Minimal context: one data point */
-        }
-    } else {
-        /* RELATIVE: No history - compute from node's current state relative to neighbors */
-        float local_avg = (node_get_local_outgoing_weight_avg(node) + 
-                          node_get_local_incoming_weight_avg(node)) / 2.0f;
-        float baseline = (node->weight > 0.0f && local_avg > 0.0f) ?
-                        (node->weight + local_avg) / 2.0f : node->weight;
-        
-        if (baseline > 0.0f && avg_change > 0.0f) {
-            /* Compute window size relative to baseline */
-            float relative_rate = avg_change / (baseline + compute_adaptive_epsilon(baseline));
-            float window_factor = relative_rate / (relative_rate + 1.0f);
-            float window_scale = 1.0f - window_factor;
-            
-            /* Use node weight as minimal context for window size */
-            float weight_context = (node->weight > 0.0f) ? node->weight : 1.0f;
-            optimal_size = (size_t)(weight_context * window_scale);
-            if (optimal_size < 1) optimal_size = 1;
-        } else {
-            optimal_size = 1;  /* Minimal context when no data */
-        }
+/* STREAMING: Fold one observed |relative weight change| into the node's inline estimator */
+/* EWMA with an adaptive horizon (replaces the rolling window + median): the horizon grows with */
+/* samples seen and shrinks for surprising changes, like the old self-sizing window. O(1), no heap. */
+/* Each sample advances weight_change_count, so the learning rate and smoothing trust the history */
+static void node_record_weight_change(Node *node, float change) {
+    node->weight_change_count++;
+    float avg = node->change_rate_avg;
+    
+    /* Minimal context: first observation (or no signal yet) is the estimate */
+    if (node->weight_change_count == 1 || avg <= 0.0f) {
+        node->change_rate_avg = change;
+        return;
     }
     
-    /* Resize if needed */
-    if (optimal_size != node->weight_change_capacity) {
-        float *new_window = (float*)calloc(optimal_size, sizeof(float));
-        if (new_window) {
-            /* Copy existing values (circular buffer) */
-            size_t copy_count = (node->weight_change_count < optimal_size) ? 
-                               node->weight_change_count : optimal_size;
-            for (size_t i = 0; i < copy_count; i++) {
-                size_t src_idx = (node->weight_change_index - copy_count + i + node->weight_change_capacity) % node->weight_change_capacity;
-                new_window[i] = node->recent_weight_changes[src_idx];
-            }
-            free(node->recent_weight_changes);
-            node->recent_weight_changes = new_window;
-            node->weight_change_capacity = optimal_size;
-            node->weight_change_count = copy_count;
-            node->weight_change_index = copy_count % optimal_size;
-        }
-    }
+    /* RELATIVE: Surprise of this change relative to the running average */
+    /* High relative rate -> short horizon (track fast changes), low -> long horizon (stable) */
+    float relative_rate = change / (avg + compute_adaptive_epsilon(avg));
+    float window_scale = 1.0f - relative_rate / (relative_rate + 1.0f);
+    float window = (float)node->weight_change_count * window_scale;  /* Effective samples */
+    float alpha = 1.0f / fmaxf(window, 1.0f);
+    
+    node->change_rate_avg = avg + alpha * (change - avg);
 }
 
-/* Get adaptive learning rate from rolling window (O(1)) */
-static float node_get_adaptive_learning_rate(Node *node) {
+/* Get adaptive learning rate from streaming change estimator (O(1)) */
+float node_get_adaptive_learning_rate(Node *node) {
     if (!node) return 0.0f;
     
-    /* DATA-DRIVEN: Adapt window size based on observed change rate */
-    if (node->weight_change_count >= node->weight_change_capacity) {
-        node_adapt_rolling_window(node);
-    }
-    
-    /* Count non-zero values in rolling window */
-    size_t valid_count = 0;
-    for (size_t i = 0; i < node->weight_change_count; i++) {
-        if (node->recent_weight_changes[i] != 0.0f) {
-            valid_count++;
-        }
-    }
-    
-    if (valid_count == 0) {
+    if (node->weight_change_count == 0 || node->change_rate_avg <= 0.0f) {
         /* No history yet - use local context (relative adaptive stability) */
         float local_avg = (node_get_local_outgoing_weight_avg(node) + 
                            node_get_local_incoming_weight_avg(node)) / 2.0f;
@@ -945,8 +1435,8 @@ static float node_get_adaptive_learning_rate(Node *node) {
         return 0.0f;
     }
     
-    /* Compute median rate from rolling window (adaptive size) */
-    float median_rate = compute_median_adaptive(node->recent_weight_changes, node->weight_change_count);
+    /* Typical change rate from streaming estimator (replaces rolling-window median) */
+    float history_rate = node->change_rate_avg;
     
     /* Combine with local context for stability (relative adaptive stability) */
     float local_avg = (node_get_local_outgoing_weight_avg(node) + 
@@ -978,98 +1468,438 @@ static float node_get_adaptive_learning_rate(Node *node) {
         }
     }
     float context_weight = 1.0f - history_weight;
-    float result = median_rate * history_weight + context_rate * context_weight;
+    float result = history_rate * history_weight + context_rate * context_weight;
     return result;
 }
 
-/* Local edge decay: Nodes optimize their edges during weight updates */
-/* Decay is relative - weaker edges decay faster relative to local context */
-/* No hardcoded thresholds - all comparisons relative to local average */
-/* O(degree) operation - only iterates node's own edges, not O(n) */
-static void node_optimize_edges_locally(Node *node) {
-    if (!node || node->outgoing_count == 0) return;
+/* LAZY DECAY: Closed-form decay of one edge over `elapsed` decay steps */
+/* Per-step factor is computed from the current local context and held constant over the gap */
+static float edge_decayed_weight(float weight, float local_avg, float learning_rate, uint32_t elapsed) {
+    if (elapsed == 0 || weight <= 0.0f || local_avg <= 0.0f) return weight;
     
-    /* LOCAL: Get local context (average outgoing edge weight) */
-    float local_avg = node_get_local_outgoing_weight_avg(node);
-    if (local_avg <= 0.0f) return;  /* No local context yet - nothing to optimize */
+    /* RELATIVE: Compute decay rate from edge weight relative to local context */
+    /* Weaker edges (relative to local average) decay faster */
+    float edge_relative = weight / local_avg;
+    
+    /* Strong edges (above average) don't decay - they stay strong */
+    if (edge_relative >= 1.0f) return weight;
+    
+    /* Weaker edges decay faster - use normalized distance from average */
+    float distance_from_avg = 1.0f - edge_relative;  /* How far below average */
+    float decay_rate = distance_from_avg / (distance_from_avg + 1.0f);  /* Normalize: 0.0-0.5 range */
     
-    /* Get adaptive learning rate for decay scaling */
+    /* Decay scales with learning rate (faster learning → faster decay of weak edges) */
+    float decay_factor = fmaxf(1.0f - (decay_rate * learning_rate * 0.1f), 0.0f);  /* Small decay per update */
+    
+    /* CLOSED FORM: elapsed steps of w *= factor collapse to one power */
+    return (elapsed == 1) ? weight * decay_factor : weight * powf(decay_factor, (float)elapsed);
+}
+
+/* Learning rate used to scale decay (minimal decay from local context when no rate yet) */
+static float node_decay_learning_rate(Node *node, float local_avg) {
     float learning_rate = node_get_adaptive_learning_rate(node);
     if (learning_rate <= 0.0f) {
         /* No learning rate yet - compute minimal decay from local context */
         learning_rate = local_avg / (local_avg + 1.0f);
     }
+    return learning_rate;
+}
+
+/* Set edge weight and keep cached sums / contributions consistent (O(1)) */
+/* COMPACT WEIGHTS: The stored weight may be rounded (half precision) - sums, the no-change */
+/* check and the order check all use the value read back, so they track what edges hold */
+static void edge_store_weight(Edge *edge, float new_weight) {
+    float old_weight = edge->weight;
+    edge->weight = new_weight;
+    new_weight = edge->weight;
+    if (new_weight == old_weight) return;
+    
+    /* Update cached sums (unconnected edges aren't in the sums yet) */
+    if (edge->connected && edge->from_node) {
+        node_update_outgoing_weight_sum(edge->from_node, edge, old_weight, new_weight);
+    }
+    if (edge->connected && edge->to_node) {
+        node_update_incoming_weight_sum(edge->to_node, old_weight, new_weight);
+    }
+}
+
+/* LAZY DECAY: Bring one edge up to its source's decay clock before its weight is used (O(1)) */
+static void edge_catch_up_decay(Edge *edge) {
+    if (!edge || !edge->from_node) return;
+    
+    Node *from = edge->from_node;
+    uint32_t elapsed = from->decay_tick - edge->decay_tick;  /* Wraparound-safe */
+    edge->decay_tick = from->decay_tick;
+    if (elapsed == 0 || !edge->connected) return;
+    
+    float local_avg = node_get_local_outgoing_weight_avg(from);
+    float learning_rate = node_decay_learning_rate(from, local_avg);
+    edge_store_weight(edge, edge_decayed_weight(edge->weight, local_avg, learning_rate, elapsed));
+}
+
+/* LAZY DECAY: Edge weight with the decay it still owes applied, without storing it (O(1)) */
+/* Readers that decide on a weight (transform, sampling, edge formation) see what a settled */
+/* edge would hold. READ-ONLY: writes nothing, so queries can use it. */
+/* Aggregate readers (match strength, variance limits, cached sums, averages) read the raw */
+/* weight: an edge lags by at most 1 + log2(its source's degree) steps of a small per-step */
+/* factor before its source reconciles, and that lag is shared by the source's siblings, so */
+/* ratios and rankings over it barely move. */
+static float edge_get_decayed_weight(Edge *edge) {
+    if (!edge || !edge->from_node || !edge->connected) return edge ? edge->weight : 0.0f;
+    
+    Node *from = edge->from_node;
+    uint32_t elapsed = from->decay_tick - edge->decay_tick;  /* Wraparound-safe */
+    if (elapsed == 0) return edge->weight;
+    
+    float local_avg = node_get_local_outgoing_weight_avg(from);
+    if (local_avg <= 0.0f) return edge->weight;
+    return edge_decayed_weight(edge->weight, local_avg, node_decay_learning_rate(from, local_avg), elapsed);
+}
+
+/* LAZY DECAY: Apply all pending decay to a node's outgoing edges (one O(degree) pass) */
+/* Activated edges already skipped their step in node_optimize_edges_locally */
+static void node_reconcile_edge_decay(Node *node) {
+    if (!node) return;
+    uint32_t now = node->decay_tick;
+    if (node->decay_reconciled_tick == now) return;  /* Nothing pending */
+    node->decay_reconciled_tick = now;
+    if (node->outgoing_count == 0) return;
+    
+    /* LOCAL: Get local context (average outgoing edge weight) */
+    float local_avg = node_get_local_outgoing_weight_avg(node);
+    float learning_rate = (local_avg > 0.0f) ? node_decay_learning_rate(node, local_avg) : 0.0f;
     
     /* LOCAL: Iterate through node's own outgoing edges (O(degree), not O(n)) */
     for (size_t i = 0; i < node->outgoing_count; i++) {
         Edge *edge = node->outgoing_edges[i];
         if (!edge) continue;
         
-        /* Store old weight for incremental cache update */
-        float old_weight = edge->weight;
-        
-        /* If edge was activated, no decay (strengthening happens in edge_update_weight_local) */
-        if (edge->activation) {
-            edge->activation = false;  /* Reset for next cycle */
-            continue;
-        }
+        uint32_t elapsed = now - edge->decay_tick;
+        edge->decay_tick = now;
         
-        /* RELATIVE: Compute decay rate from edge weight relative to local context */
-        /* Weaker edges (relative to local average) decay faster */
-        float edge_relative = (local_avg > 0.0f) ? edge->weight / local_avg : 0.0f;
-        
-        /* RELATIVE: Decay rate computed from edge's position relative to local average */
-        /* Edge weight far below local average → faster decay (relative, not absolute) */
-        float decay_rate = 0.0f;
-        if (edge_relative < 1.0f && edge->weight > 0.0f) {
-            /* Weaker edges decay faster - use normalized distance from average */
-            float distance_from_avg = 1.0f - edge_relative;  /* How far below average */
-            decay_rate = distance_from_avg / (distance_from_avg + 1.0f);  /* Normalize: 0.0-0.5 range */
+        if (local_avg > 0.0f) {
+            edge_store_weight(edge, edge_decayed_weight(edge->weight, local_avg, learning_rate, elapsed));
         }
-        /* Strong edges (above average) don't decay - they stay strong */
-        
-        /* Apply decay: weak edges decay toward zero (relative to local context) */
-        /* Decay scales with learning rate (faster learning → faster decay of weak edges) */
-        float decay_factor = 1.0f - (decay_rate * learning_rate * 0.1f);  /* Small decay per update */
-        float new_weight = edge->weight * fmaxf(decay_factor, 0.0f);  /* Never go negative */
-        
-        /* Update edge weight */
-        edge->weight = new_weight;
-        
-        /* Update cached outgoing weight sum (O(1) incremental update) */
-        node_update_outgoing_weight_sum(node, old_weight, new_weight);
-        
-        /* Update cached incoming weight sum in to_node (O(1)) */
-        if (edge->to_node) {
-            node_update_incoming_weight_sum(edge->to_node, old_weight, new_weight);
+    }
+    
+    /* DELTA-DRIVEN: Decay shifted this node's outgoing average and its targets' incoming ones - */
+    /* edge_store_weight marked them; receivers reconcile when they next read their sums */
+}
+
+/* LAZY DECAY: Remember an activated outgoing edge so the next update settles just these (O(1)) */
+static void node_note_activated_edge(Node *node, Edge *edge) {
+    if (node->activated_overflow) return;  /* Next update scans every edge anyway */
+    if (node->activated_count >= node->activated_capacity) {
+        size_t new_cap = (node->activated_capacity == 0) ? 1 : node->activated_capacity * 2;  /* Minimal context: start at 1 */
+        Edge **new_list = (Edge**)realloc(node->activated_edges, new_cap * sizeof(Edge*));
+        if (!new_list) {
+            node->activated_overflow = true;  /* Fall back to one full scan rather than losing the edge */
+            return;
         }
+        node->activated_edges = new_list;
+        node->activated_capacity = new_cap;
     }
+    node->activated_edges[node->activated_count++] = edge;
 }
 
-/* Update node weight based on local activation history (relative to local context) */
-void node_update_weight_local(Node *node) {
-    if (!node) return;
-    
-    float old_weight = node->weight;
-    
-    /* DATA-DRIVEN: Learning rate from adaptive rolling window (no hardcoded fallback) */
-    float rate = node_get_adaptive_learning_rate(node);
-    
-    /* Weight updates relative to activation strength (continuous, not binary) */
-    float new_weight = node->weight * (1.0f - rate) + node->activation_strength * rate;
-    node->weight = new_weight;
-    
-    /* Track weight change in rolling window (O(1)) */
-    if (old_weight > 0.0f) {
-        float change = (new_weight - old_weight) / old_weight;  /* Relative change */
-        node->recent_weight_changes[node->weight_change_index] = fabsf(change);
-        node->weight_change_index = (node->weight_change_index + 1) % node->weight_change_capacity;  /* Circular buffer - adaptive size */
+/* Mark an edge activated: its source's next weight update skips its decay step (O(1)) */
+/* The flag doubles as list membership - a connected edge is listed once until it is settled; */
+/* edges activated before they connect are listed by graph_add_edge */
+static void edge_mark_activated(Edge *edge) {
+    if (!edge || edge->activation) return;
+    edge->activation = true;
+    if (edge->connected && edge->from_node) {
+        node_note_activated_edge(edge->from_node, edge);
     }
-    
-    /* LOCAL OPTIMIZATION: Node optimizes its edges locally (O(degree), not O(n)) */
-    /* Edges decay if not activated, relative to local context */
-    /* No hardcoded thresholds - decay rate computed from local edge weight distribution */
-    node_optimize_edges_locally(node);
+}
+
+/* If edge was activated, no decay for this step (reset for next cycle) */
+/* Settle what it owed before, then start its clock after this step */
+static void edge_settle_activated(Edge *edge, uint32_t next_tick) {
+    edge->activation = false;
+    edge_catch_up_decay(edge);
+    edge->decay_tick = next_tick;
+}
+
+/* LAZY DECAY: Advance a node's decay clock by steps weight updates (the per-update edge bookkeeping) */
+/* Edges activated since the last update skip the first step - settled here, they decay with the */
+/* rest (O(activated), not O(degree)); the decay pass runs once every 1 + log2(degree) steps */
+/* (amortized O(1)), or earlier when the edges are propagated through. */
+/* Small nodes (degree 1) still reconcile on every update. */
+static void node_advance_decay_clock(Node *node, uint32_t steps) {
+    if (!node || node->outgoing_count == 0 || steps == 0) return;
+    
+    uint32_t next_tick = node->decay_tick + 1;
+    if (node->activated_overflow) {
+        for (size_t i = 0; i < node->outgoing_count; i++) {
+            Edge *edge = node->outgoing_edges[i];
+            if (edge && edge->activation) edge_settle_activated(edge, next_tick);
+        }
+        node->activated_overflow = false;
+    } else {
+        for (size_t i = 0; i < node->activated_count; i++) {
+            edge_settle_activated(node->activated_edges[i], next_tick);
+        }
+    }
+    node->activated_count = 0;
+    node->decay_tick += steps;
+    
+    /* SAMPLING: Pending decay moved this node's effective weights - scores must be rebuilt */
+    if (node->output_alias) node->output_alias->valid = false;
+    node_mark_contributions_changed(node);  /* DELTA-DRIVEN: Transforms read the decayed weights too */
+    
+    /* DATA-DRIVEN: Reconcile interval grows logarithmically with fan-out */
+    uint32_t interval = 1 + (uint32_t)log2f((float)node->outgoing_count);
+    if (node->decay_tick - node->decay_reconciled_tick >= interval) {
+        node_reconcile_edge_decay(node);
+    }
+}
+
+/* Local edge decay: Nodes optimize their edges during weight updates */
+/* Decay is relative - weaker edges decay faster relative to local context */
+/* No hardcoded thresholds - all comparisons relative to local average */
+static void node_optimize_edges_locally(Node *node) {
+    node_advance_decay_clock(node, 1);
+}
+
+/* Apply all pending lazy edge decay in the graph (O(edges)) */
+void graph_reconcile_edge_decay(MelvinGraph *g) {
+    if (!g) return;
+    for (size_t i = 0; i < g->node_count; i++) {
+        node_reconcile_edge_decay(g->nodes[i]);
+    }
+}
+
+/* ========================================
+ * DEFERRED WEIGHT UPDATES (record during a step, commit after it)
+ * ======================================== */
+
+/* One pending update per edge/node: all updates in a step are merged into one affine map */
+/* w -> w * keep + add (composing w*(1-r) + t*r steps in record order, so merging is exact) */
+typedef struct {
+    Edge *edge;
+    float keep;
+    float add;
+    float old_weight;  /* Set at commit (for cached-sum maintenance) */
+} EdgeWeightUpdate;
+
+typedef struct {
+    Node *node;
+    float keep;
+    float add;
+    uint32_t updates;  /* Merged update count (advances the lazy decay clock) */
+} NodeWeightUpdate;
+
+struct WeightUpdateBuffer {
+    EdgeWeightUpdate *edges;
+    size_t edge_count;
+    size_t edge_capacity;
+    NodeWeightUpdate *nodes;
+    size_t node_count;
+    size_t node_capacity;
+    void **items;  /* Scratch pointer array for the parallel commit */
+    size_t items_capacity;
+};
+
+/* DEFERRED: Buffer the calling thread records into (NULL = updates apply in place) */
+/* Per thread, so concurrent graphs on different threads never share pending updates */
+static _Thread_local WeightUpdateBuffer *tls_weight_updates = NULL;
+
+/* Record an edge update, merging with an earlier one for the same edge (O(1)) */
+static bool weight_updates_record_edge(WeightUpdateBuffer *buf, Edge *edge, float keep, float add) {
+    if (edge->deferred_slot > 0) {
+        EdgeWeightUpdate *u = &buf->edges[edge->deferred_slot - 1];
+        u->add = u->add * keep + add;  /* Later update applies on top of the earlier one */
+        u->keep *= keep;
+        return true;
+    }
+    if (buf->edge_count >= buf->edge_capacity) {
+        size_t new_capacity = (buf->edge_capacity == 0) ? 1 : buf->edge_capacity * 2;  /* Minimal context: start at 1 */
+        EdgeWeightUpdate *new_edges = (EdgeWeightUpdate*)realloc(buf->edges, new_capacity * sizeof(EdgeWeightUpdate));
+        if (!new_edges) return false;  /* Caller applies in place */
+        buf->edges = new_edges;
+        buf->edge_capacity = new_capacity;
+    }
+    buf->edges[buf->edge_count] = (EdgeWeightUpdate){edge, keep, add, 0.0f};
+    edge->deferred_slot = (uint32_t)++buf->edge_count;
+    return true;
+}
+
+/* Record a node update, merging with an earlier one for the same node (O(1)) */
+static bool weight_updates_record_node(WeightUpdateBuffer *buf, Node *node, float keep, float add) {
+    if (node->deferred_slot > 0) {
+        NodeWeightUpdate *u = &buf->nodes[node->deferred_slot - 1];
+        u->add = u->add * keep + add;
+        u->keep *= keep;
+        u->updates++;
+        return true;
+    }
+    if (buf->node_count >= buf->node_capacity) {
+        size_t new_capacity = (buf->node_capacity == 0) ? 1 : buf->node_capacity * 2;  /* Minimal context: start at 1 */
+        NodeWeightUpdate *new_nodes = (NodeWeightUpdate*)realloc(buf->nodes, new_capacity * sizeof(NodeWeightUpdate));
+        if (!new_nodes) return false;
+        buf->nodes = new_nodes;
+        buf->node_capacity = new_capacity;
+    }
+    buf->nodes[buf->node_count] = (NodeWeightUpdate){node, keep, add, 1};
+    node->deferred_slot = (uint32_t)++buf->node_count;
+    return true;
+}
+
+/* PARALLEL: Commit one merged edge update - touches only the edge itself */
+static void weight_updates_commit_edge(void *item, size_t index, void *context) {
+    (void)index;
+    (void)context;
+    EdgeWeightUpdate *u = (EdgeWeightUpdate*)item;
+    u->old_weight = u->edge->weight;
+    u->edge->weight = u->old_weight * u->keep + u->add;
+}
+
+/* PARALLEL: Commit one merged node update - touches only the node itself */
+static void weight_updates_commit_node(void *item, size_t index, void *context) {
+    (void)index;
+    (void)context;
+    NodeWeightUpdate *u = (NodeWeightUpdate*)item;
+    Node *node = u->node;
+    float old_weight = node->weight;
+    node->weight = old_weight * u->keep + u->add;
+    
+    /* One merged change feeds the streaming estimator (same as one larger in-place step) */
+    if (old_weight > 0.0f) {
+        node_record_weight_change(node, fabsf((node->weight - old_weight) / old_weight));
+    }
+}
+
+/* Run a commit worker over n records: thread pool for large batches, inline otherwise */
+static void weight_updates_run(WeightUpdateBuffer *buf, void *records, size_t record_size, size_t n,
+                               ProcessItemFunc func) {
+    ThreadPool *pool = get_thread_pool();
+    if (!pool || n < pool->thread_count) {
+        for (size_t i = 0; i < n; i++) func((char*)records + i * record_size, i, NULL);
+        return;
+    }
+    if (buf->items_capacity < n) {
+        void **new_items = (void**)realloc(buf->items, n * sizeof(void*));
+        if (!new_items) {
+            for (size_t i = 0; i < n; i++) func((char*)records + i * record_size, i, NULL);
+            return;
+        }
+        buf->items = new_items;
+        buf->items_capacity = n;
+    }
+    for (size_t i = 0; i < n; i++) buf->items[i] = (char*)records + i * record_size;
+    thread_pool_process_array(pool, buf->items, n, func, NULL);
+}
+
+/* Enable/disable deferred weight updates (pending updates are committed when disabling) */
+void graph_set_deferred_weight_updates(MelvinGraph *g, bool enabled) {
+    if (!g) return;
+    if (!enabled) graph_commit_weight_updates(g);
+    g->deferred_weight_updates = enabled;
+}
+
+/* Start recording weight updates on the calling thread (no-op unless deferred mode is on) */
+void graph_begin_weight_updates(MelvinGraph *g) {
+    if (!g || !g->deferred_weight_updates || tls_weight_updates) return;  /* Already recording */
+    if (!g->weight_updates) {
+        g->weight_updates = (WeightUpdateBuffer*)calloc(1, sizeof(WeightUpdateBuffer));
+        if (!g->weight_updates) return;  /* No buffer - updates stay in place */
+    }
+    tls_weight_updates = g->weight_updates;
+}
+
+/* Commit recorded updates: weights first (parallel, each record owns its edge/node), then the */
+/* shared neighbour state (cached sums, activation contributions, decay clocks) in record order. */
+/* Every value is folded in the same order for any thread count, so results are deterministic. */
+void graph_commit_weight_updates(MelvinGraph *g) {
+    if (!g || !g->weight_updates || tls_weight_updates != g->weight_updates) return;
+    WeightUpdateBuffer *buf = g->weight_updates;
+    tls_weight_updates = NULL;  /* Stop recording - everything below applies in place */
+    
+    /* LAZY DECAY: Catch edges up to their source's clock first (touches shared sums - serial) */
+    for (size_t i = 0; i < buf->edge_count; i++) {
+        edge_catch_up_decay(buf->edges[i].edge);
+    }
+    
+    weight_updates_run(buf, buf->edges, sizeof(EdgeWeightUpdate), buf->edge_count, weight_updates_commit_edge);
+    weight_updates_run(buf, buf->nodes, sizeof(NodeWeightUpdate), buf->node_count, weight_updates_commit_node);
+    
+    for (size_t i = 0; i < buf->edge_count; i++) {
+        EdgeWeightUpdate *u = &buf->edges[i];
+        Edge *edge = u->edge;
+        edge->deferred_slot = 0;
+        
+        /* Unconnected edges aren't in the sums yet - graph_add_edge adds their final weight */
+        if (edge->connected && edge->from_node) {
+            node_update_outgoing_weight_sum(edge->from_node, edge, u->old_weight, edge->weight);
+        }
+        if (edge->connected && edge->to_node) {
+            node_update_incoming_weight_sum(edge->to_node, u->old_weight, edge->weight);
+        }
+        /* DELTA-DRIVEN: Both endpoints are marked changed - receivers reconcile when read */
+    }
+    
+    for (size_t i = 0; i < buf->node_count; i++) {
+        Node *node = buf->nodes[i].node;
+        node->deferred_slot = 0;
+        node_mark_contributions_changed(node);  /* Similarity at its edges reads the weight */
+        
+        /* LAZY DECAY: The edge bookkeeping of every merged update, same as in place */
+        node_advance_decay_clock(node, buf->nodes[i].updates);
+    }
+    
+    buf->edge_count = 0;
+    buf->node_count = 0;
+}
+
+/* Free a graph's update buffer (pending updates are dropped with the graph) */
+static void weight_updates_free(MelvinGraph *g) {
+    WeightUpdateBuffer *buf = g->weight_updates;
+    if (!buf) return;
+    if (tls_weight_updates == buf) tls_weight_updates = NULL;
+    free(buf->edges);
+    free(buf->nodes);
+    free(buf->items);
+    free(buf);
+    g->weight_updates = NULL;
+}
+
+/* Update node weight based on local activation history (relative to local context) */
+void node_update_weight_local(Node *node) {
+    if (!node) return;
+    
+    /* DATA-DRIVEN: Learning rate from adaptive rolling window (no hardcoded fallback) */
+    float rate = node_get_adaptive_learning_rate(node);
+    
+    /* Weight updates relative to activation strength (continuous, not binary) */
+    node_apply_weight_update(node, rate, node->weight * (1.0f - rate) + node->activation_strength * rate);
+}
+
+/* Apply one node weight update computed at rate (new_weight = w * (1 - rate) + activation * rate) */
+/* and its local bookkeeping. Batch backends compute new_weight in bulk and apply it here */
+void node_apply_weight_update(Node *node, float rate, float new_weight) {
+    if (!node) return;
+    
+    /* DEFERRED: Record instead of applying while a wave step is in progress */
+    if (tls_weight_updates &&
+        weight_updates_record_node(tls_weight_updates, node, 1.0f - rate, node->activation_strength * rate)) {
+        return;
+    }
+    
+    float old_weight = node->weight;
+    node->weight = new_weight;
+    if (new_weight != old_weight) node_mark_contributions_changed(node);  /* Similarity at its edges reads it */
+    
+    /* Track weight change in streaming estimator (O(1), no heap traffic) */
+    if (old_weight > 0.0f) {
+        float change = (new_weight - old_weight) / old_weight;  /* Relative change */
+        node_record_weight_change(node, fabsf(change));
+    }
+    
+    /* LOCAL OPTIMIZATION: Node optimizes its edges locally (O(degree), not O(n)) */
+    /* Edges decay if not activated, relative to local context */
+    /* No hardcoded thresholds - decay rate computed from local edge weight distribution */
+    node_optimize_edges_locally(node);
 }
 
 /* Calculate match strength - UNIVERSAL for all node types (no special cases) */
@@ -1079,7 +1909,7 @@ float node_calculate_match_strength(Node *node, const uint8_t *pattern, size_t p
     
     /* OPTIMIZATION 1: Early exit on exact match - skip all similarity calculations */
     if (node->payload_size == pattern_size) {
-        if (memcmp(node->payload, pattern, pattern_size) == 0) {
+        if (node_payload_equals(node, 0, pattern, pattern_size)) {
             /* Exact match - return 1.0f immediately, skip connection matching */
             return 1.0f;
         }
@@ -1114,30 +1944,9 @@ float node_calculate_match_strength(Node *node, const uint8_t *pattern, size_t p
         size_t max_mismatches = (size_t)(check_size * (1.0f - mismatch_threshold));
         size_t mismatches = 0;
         
-        /* CPU OPTIMIZATION: Use SIMD for large comparisons, scalar for small ones */
-        if (check_size >= 16) {
-            /* SIMD-optimized comparison for large payloads */
-            simd_compare_bytes(node->payload, pattern, check_size, &match_bytes, &mismatches);
-            
-            /* Early exit check after SIMD comparison */
-            if (mismatches > max_mismatches) {
-                /* Unlikely to be a good match - already computed, just use result */
-            }
-        } else {
-            /* Scalar comparison for small payloads (SIMD overhead not worth it) */
-            for (size_t i = 0; i < check_size; i++) {
-                if (node->payload[i] == pattern[i]) {
-                    match_bytes++;
-                } else {
-                    mismatches++;
-                    /* OPTIMIZATION: Early exit if mismatch rate exceeds adaptive threshold */
-                    if (mismatches > max_mismatches) {
-                        /* Unlikely to be a good match - exit early */
-                        break;
-                    }
-                }
-            }
-        }
+        /* CPU OPTIMIZATION: SIMD for large spans, scalar with early exit for small ones */
+        /* (OPTIMIZATION: stops once the mismatch rate exceeds the adaptive threshold) */
+        match_bytes = node_payload_count_matches(node, pattern, check_size, max_mismatches, &mismatches);
         
         float direct_similarity = (check_size > 0) ? (float)match_bytes / (float)check_size : 0.0f;
         match_score = direct_similarity;
@@ -1165,6 +1974,7 @@ float node_calculate_match_strength(Node *node, const uint8_t *pattern, size_t p
     
     /* UNIVERSAL: All nodes can also match through connections (relative to local context) */
     /* This works for blank nodes (no payload) and regular nodes (additional context) */
+    /* LAZY DECAY: Raw edge weights here - a weighted average tolerates the bounded pending decay */
     float connection_match = 0.0f;
     float connection_weight = 0.0f;
     
@@ -1217,14 +2027,7 @@ float node_calculate_match_strength(Node *node, const uint8_t *pattern, size_t p
                 size_t check_size = (connected->payload_size < pattern_size) ? connected->payload_size : pattern_size;
                 
                 /* CPU OPTIMIZATION: Use SIMD for large comparisons */
-                if (check_size >= 16) {
-                    simd_compare_bytes(connected->payload, pattern, check_size, &match_bytes, NULL);
-                } else {
-                    /* Scalar for small comparisons */
-                    for (size_t j = 0; j < check_size; j++) {
-                        if (connected->payload[j] == pattern[j]) match_bytes++;
-                    }
-                }
+                match_bytes = node_payload_count_matches(connected, pattern, check_size, SIZE_MAX, NULL);
                 connected_similarity = (check_size > 0) ? (float)match_bytes / (float)check_size : 0.0f;
             }
             
@@ -1272,9 +2075,7 @@ float node_calculate_match_strength(Node *node, const uint8_t *pattern, size_t p
             if (connected->payload_size > 0 && pattern_size > 0) {
                 size_t match_bytes = 0;
                 size_t check_size = (connected->payload_size < pattern_size) ? connected->payload_size : pattern_size;
-                for (size_t j = 0; j < check_size; j++) {
-                    if (connected->payload[j] == pattern[j]) match_bytes++;
-                }
+                match_bytes = node_payload_count_matches(connected, pattern, check_size, SIZE_MAX, NULL);
                 connected_similarity = (check_size > 0) ? (float)match_bytes / (float)check_size : 0.0f;
             }
             
@@ -1319,7 +2120,10 @@ float node_calculate_match_strength(Node *node, const uint8_t *pattern, size_t p
 
 /* OPTIMIZATION: Invalidate cache when edges change */
 static void node_invalidate_avg_cache(Node *node) {
-    if (node) node->avg_cache_valid = false;
+    if (!node) return;
+    node->avg_cache_valid = false;
+    node_mark_contributions_changed(node);  /* DELTA-DRIVEN: Transforms at this node read these averages */
+    if (node->output_alias) node->output_alias->valid = false;  /* SAMPLING: Scores read the same averages */
 }
 
 /* Get local average weight from outgoing edges (O(1) - reads cached state) */
@@ -1331,6 +2135,11 @@ float node_get_local_outgoing_weight_avg(Node *node) {
         return node->cached_local_outgoing_avg;
     }
     
+    /* READ-ONLY: Same value, not cached */
+    if (tls_read_only_query) {
+        return node->outgoing_weight_sum / (float)node->outgoing_count;
+    }
+    
     /* Compute and cache (O(1) - just division) */
     node->cached_local_outgoing_avg = node->outgoing_weight_sum / (float)node->outgoing_count;
     node->cached_local_incoming_avg = (node->incoming_count > 0) ? 
@@ -1348,6 +2157,11 @@ float node_get_local_incoming_weight_avg(Node *node) {
         return node->cached_local_incoming_avg;
     }
     
+    /* READ-ONLY: Same value, not cached */
+    if (tls_read_only_query) {
+        return node->incoming_weight_sum / (float)node->incoming_count;
+    }
+    
     /* Compute and cache (O(1) - just division) */
     node->cached_local_outgoing_avg = (node->outgoing_count > 0) ? 
         node->outgoing_weight_sum / (float)node->outgoing_count : 0.0f;
@@ -1356,24 +2170,10 @@ float node_get_local_incoming_weight_avg(Node *node) {
     return node->cached_local_incoming_avg;
 }
 
-/* Compute node activation from weighted inputs (mini neural net) */
-/* Philosophy: Local-only computation, self-regulating bias, no thresholds */
-float node_compute_activation_strength(Node *node) {
-    if (!node) return 0.0f;
-    
-    /* Sum weighted inputs from incoming edges (local-only computation) */
-    float input_sum = 0.0f;
-    float total_weight = 0.0f;
-    
-    for (size_t i = 0; i < node->incoming_count; i++) {
-        Edge *edge = node->incoming_edges[i];
-        if (!edge || !edge->from_node) continue;
-        
-        /* Edge transforms activation as it flows (use intelligent transformer) */
-        float transformed = edge_transform_activation(edge, edge->from_node->activation_strength);
-        input_sum += transformed;
-        total_weight += edge->weight;
-    }
+/* Activation for a given weighted input sum (stores nothing - bias goes to bias_out if non-NULL) */
+/* Shared by learning (input = node's pushed sum) and read-only queries (input = query-local sum) */
+static float node_activation_from_input(Node *node, float input_sum, float *bias_out) {
+    float total_weight = node->incoming_weight_sum;
     
     /* Normalize by total weight (relative, no hardcoded normalization) */
     if (total_weight > 0.0f) {
@@ -1383,16 +2183,29 @@ float node_compute_activation_strength(Node *node) {
     /* RELATIVE: Self-regulating bias (relative to local context, no hardcoded fallback) */
     float local_avg = node_get_local_incoming_weight_avg(node);
     /* Bias emerges from weight relative to context - no fixed value */
-    node->bias = (node->weight + local_avg > 0.0f) ? 
+    float bias = (node->weight + local_avg > 0.0f) ? 
                  node->weight / (node->weight + local_avg) : 
                  (node->weight > 0.0f ? node->weight / (node->weight + 1.0f) : 0.0f);
+    if (bias_out) *bias_out = bias;
     
     /* Compute activation: input_sum + bias with soft non-linearity */
     /* Uses relative comparison - no hardcoded threshold */
-    float raw_activation = input_sum + node->bias;
+    float raw_activation = input_sum + bias;
     return raw_activation / (1.0f + raw_activation);  /* Soft sigmoid-like, self-limiting */
 }
 
+/* Compute node activation from weighted inputs (mini neural net) */
+/* Philosophy: Local-only computation, self-regulating bias, no thresholds */
+float node_compute_activation_strength(Node *node) {
+    if (!node) return 0.0f;
+    
+    /* DELTA-DRIVEN: Weighted input sum is maintained incrementally - each incoming edge pushes */
+    /* its transformed activation when its source's activation changes; weight changes only mark */
+    /* their endpoints and are reconciled here */
+    float input_sum = node_get_input_sum(node);
+    return node_activation_from_input(node, input_sum, &node->bias);
+}
+
 /* REMOVED: blank_node_compute_category_match - now integrated into universal node_calculate_match_strength */
 /* All nodes (including blank nodes) use the same universal matching function */
 
@@ -1410,10 +2223,12 @@ void node_free(Node *node) {
     if (node->incoming_edges) {
         free(node->incoming_edges);
     }
-    if (node->recent_weight_changes) {
-        free(node->recent_weight_changes);
-    }
+    free(node->activated_edges);
+    free(node->stale_inputs);
     /* Payload is stored inline (flexible array member), so freeing node frees payload */
+    /* ROPE: Parts are separate graph nodes - only this node's flattening cache is owned */
+    free(node->payload_flat);
+    output_alias_free(node->output_alias);
     free(node);
 }
 
@@ -1436,19 +2251,67 @@ Edge* edge_create(Node *from, Node *to, bool direction) {
     edge->direction = direction;
     edge->activation = false;
     edge->weight = 0.0f;
+    edge->input_contribution = 0.0f;  /* Not yet contributing (pushed on graph_add_edge) */
+    edge->connected = false;
+    edge->decay_tick = from->decay_tick;  /* No decay owed from before the edge existed */
     
     return edge;
 }
 
-/* Update edge weight based on local activation history (self-relative, no global state) */
-/* Edge only knows itself - weight updates are relative to edge's own state */
-/* Maintains cached weight sums in nodes (O(1) incremental update) */
-void edge_update_weight_local(Edge *edge) {
-    if (!edge) return;
-    
-    /* Store old weight for incremental cache update */
-    float old_weight = edge->weight;
+/* COMPACT WEIGHTS: float -> IEEE half bits (round to nearest even, overflow saturates to inf) */
+/* Bit-level so the .m edge section is portable to compilers without _Float16 */
+uint16_t melvin_weight_to_half(float weight) {
+    uint32_t x;
+    memcpy(&x, &weight, sizeof(x));
+    uint16_t sign = (uint16_t)((x >> 16) & 0x8000u);
+    uint32_t abs_bits = x & 0x7FFFFFFFu;
+    
+    if (abs_bits >= 0x7F800000u) {  /* Inf / NaN */
+        return sign | 0x7C00u | (abs_bits > 0x7F800000u ? 0x200u : 0u);
+    }
+    if (abs_bits >= 0x477FF000u) return sign | 0x7C00u;  /* >= 65520 rounds past the half range */
+    if (abs_bits < 0x38800000u) {  /* Below 2^-14: half subnormal (or zero) */
+        if (abs_bits < 0x33000000u) return sign;  /* Below half of the smallest subnormal */
+        uint32_t mantissa = (abs_bits & 0x7FFFFFu) | 0x800000u;
+        uint32_t shift = 126u - (abs_bits >> 23);  /* 14..24 */
+        uint32_t half = mantissa >> shift;
+        uint32_t rest = mantissa & ((1u << shift) - 1u);
+        uint32_t halfway = 1u << (shift - 1u);
+        if (rest > halfway || (rest == halfway && (half & 1u))) half++;
+        return sign | (uint16_t)half;
+    }
+    
+    /* Normal: rebias exponent (127 -> 15), keep 10 mantissa bits (carry may bump the exponent) */
+    uint32_t half = (abs_bits >> 13) - (112u << 10);
+    uint32_t rest = abs_bits & 0x1FFFu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) half++;
+    return sign | (uint16_t)half;
+}
+
+/* COMPACT WEIGHTS: IEEE half bits -> float (exact) */
+float melvin_half_to_weight(uint16_t bits) {
+    uint32_t sign = (uint32_t)(bits & 0x8000u) << 16;
+    uint32_t exponent = (bits >> 10) & 0x1Fu;
+    uint32_t mantissa = bits & 0x3FFu;
+    uint32_t x;
+    
+    if (exponent == 0) {
+        /* Zero / subnormal: mantissa * 2^-24 */
+        float value = (float)mantissa * 5.9604644775390625e-8f;
+        return sign ? -value : value;
+    } else if (exponent == 31) {
+        x = sign | 0x7F800000u | (mantissa << 13);  /* Inf / NaN */
+    } else {
+        x = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    }
     
+    float value;
+    memcpy(&value, &x, sizeof(value));
+    return value;
+}
+
+/* Edge learning rate (shared by in-place and deferred updates) */
+static float edge_compute_learning_rate(Edge *edge) {
     /* DATA-DRIVEN: Learning rate from from_node's adaptive rolling window (no hardcoded base) */
     /* NO HARDCODED THRESHOLD: Compute rate even when weight = 0.0f using minimal context */
     float rate = 0.0f;
@@ -1493,6 +2356,14 @@ void edge_update_weight_local(Edge *edge) {
             rate = 0.0f;
         }
     }
+    return rate;
+}
+
+/* Update edge weight based on local activation history (self-relative, no global state) */
+/* Edge only knows itself - weight updates are relative to edge's own state */
+/* Maintains cached weight sums in nodes (O(1) incremental update) */
+void edge_update_weight_local(Edge *edge) {
+    if (!edge) return;
     
     /* Weight updates relative to activation state (local measurement only) */
     /* Use activation strength from from_node (continuous, not binary) */
@@ -1500,23 +2371,34 @@ void edge_update_weight_local(Edge *edge) {
     if (edge->from_node) {
         target = edge->from_node->activation_strength;
     }
+    
+    /* DEFERRED: Record instead of applying while a wave step is in progress */
+    /* (rate and target are read now, so the update reflects this step's state) */
+    if (tls_weight_updates) {
+        float deferred_rate = edge_compute_learning_rate(edge);
+        if (weight_updates_record_edge(tls_weight_updates, edge, 1.0f - deferred_rate,
+                                       target * deferred_rate)) {
+            return;
+        }
+    }
+    
+    /* LAZY DECAY: Apply decay owed since this edge was last touched before learning on it */
+    edge_catch_up_decay(edge);
+    
+    float rate = edge_compute_learning_rate(edge);
     float new_weight = edge->weight * (1.0f - rate) + target * rate;
     
-    /* Update edge weight */
-    edge->weight = new_weight;
+    /* Update edge weight and cached sums in nodes (O(1) incremental update) */
+    /* Unconnected edges aren't in the sums yet - graph_add_edge adds their final weight */
+    edge_store_weight(edge, new_weight);
     
-    /* Update cached sums in nodes (O(1) incremental update) */
-    if (edge->from_node) {
-        node_update_outgoing_weight_sum(edge->from_node, old_weight, new_weight);
-    }
-    if (edge->to_node) {
-        node_update_incoming_weight_sum(edge->to_node, old_weight, new_weight);
-    }
+    /* DELTA-DRIVEN: Both endpoints are now marked changed - this edge's contribution and every */
+    /* other one that read their averages reconcile when a receiver next reads its sum */
 }
 
 /* Compute pattern similarity between two nodes (observable from payloads) */
 /* Philosophy: Local-only computation, uses node_calculate_match_strength */
-static float edge_compute_pattern_similarity(Node *node1, Node *node2) {
+float edge_compute_pattern_similarity(Node *node1, Node *node2) {
     if (!node1 || !node2) return 0.0f;
     
     /* Skip blank nodes - similarity computed differently for them */
@@ -1524,10 +2406,21 @@ static float edge_compute_pattern_similarity(Node *node1, Node *node2) {
     
     /* Use existing node_calculate_match_strength for similarity */
     /* Check similarity in both directions and take average */
-    float similarity1 = node_calculate_match_strength(node1, node2->payload, node2->payload_size);
-    float similarity2 = node_calculate_match_strength(node2, node1->payload, node1->payload_size);
-    
-    return (similarity1 + similarity2) / 2.0f;
+    /* ROPE: Each side is matched as a pattern - rope nodes stream into a scratch view */
+    uint8_t scratch1[256], scratch2[256];
+    uint8_t *owned1, *owned2;
+    const uint8_t *bytes1 = node_payload_borrow(node1, scratch1, sizeof(scratch1), &owned1);
+    const uint8_t *bytes2 = node_payload_borrow(node2, scratch2, sizeof(scratch2), &owned2);
+    float similarity = 0.0f;
+    if (bytes1 && bytes2) {
+        float similarity1 = node_calculate_match_strength(node1, bytes2, node2->payload_size);
+        float similarity2 = node_calculate_match_strength(node2, bytes1, node1->payload_size);
+        similarity = (similarity1 + similarity2) / 2.0f;
+    }
+    free(owned1);
+    free(owned2);
+    
+    return similarity;
 }
 
 /* Check if edge already exists between two nodes (local check - no global search) */
@@ -1538,7 +2431,7 @@ static Edge* node_find_edge_to(Node *from, Node *to) {
     
     /* OPTIMIZATION 7: Check cache first (local-only, no global state) */
     if (from->last_edge_lookup_target == to && from->last_edge_lookup_result) {
-        from->edge_lookup_cache_hits++;
+        if (!tls_read_only_query) from->edge_lookup_cache_hits++;
         return from->last_edge_lookup_result;
     }
     
@@ -1554,6 +2447,8 @@ static Edge* node_find_edge_to(Node *from, Node *to) {
     }
     
     /* OPTIMIZATION: Cache result (local to node) */
+    /* READ-ONLY: Parallel scorers and queries leave the cache alone */
+    if (tls_read_only_query) return found_edge;
     from->last_edge_lookup_target = to;
     from->last_edge_lookup_result = found_edge;
     return found_edge;
@@ -1811,7 +2706,9 @@ float edge_transform_activation(Edge *edge, float input_activation) {
     if (!edge) return 0.0f;
     
     /* Base transformation: weighted signal */
-    float transformed = edge->weight * input_activation;
+    /* LAZY DECAY: Use the weight with pending decay applied */
+    float weight = edge_get_decayed_weight(edge);
+    float transformed = weight * input_activation;
     
     /* IMPLIED CHECKS: Compute context once per edge transformation */
     /* Like biological systems: compute state once, use for all decisions */
@@ -1867,7 +2764,7 @@ float edge_transform_activation(Edge *edge, float input_activation) {
     /* Like biological systems: strong signals suppress weak ones through local competition */
     /* IMPLIED: Use precomputed context */
     if (has_from_node && has_local_context) {
-        float edge_relative = edge->weight / from_local_avg;
+        float edge_relative = weight / from_local_avg;
         
         /* BRAIN-LIKE: Local competition (is this edge stronger than local average?) */
         /* No sorting, no percentile - just "is it above average?" (O(1)) */
@@ -1895,7 +2792,7 @@ void edge_free(Edge *edge) {
 /* Check if node payload exactly matches pattern (quick exact match check) */
 static bool node_payload_exact_match(Node *node, const uint8_t *pattern, size_t pattern_size) {
     if (!node || node->payload_size != pattern_size) return false;
-    return (memcmp(node->payload, pattern, pattern_size) == 0);
+    return node_payload_equals(node, 0, pattern, pattern_size);
 }
 
 /* Find node via previous node's outgoing edges (local, no global search) */
@@ -2611,6 +3508,175 @@ static Node* wave_find_node_via_exploration(MelvinGraph *g, Node **seed_nodes, s
     return found;
 }
 
+/* ========================================
+ * SEGMENTATION CACHE (repeated input chunks)
+ * ======================================== */
+
+/* MEMOIZATION: Segmentation reads only the input bytes, last_activated and the graph's structure */
+/* (which nodes exist and which edges join them); weights only matter on the blank-node path, */
+/* which always adds a node. A run that adds no node or edge is therefore reproduced exactly by the same bytes in the same */
+/* context while structure_version is unchanged. Its only other effects - activating matched nodes */
+/* that were at rest and recording last_activated - are replayed on a hit */
+typedef struct SegmentCacheEntry {
+    uint64_t data_hash;          /* 0 with nodes == NULL = empty slot */
+    uint64_t context_hash;
+    uint64_t structure_version;
+    uint8_t *data;               /* Input bytes (compared in full - a hash match alone is not trusted) */
+    size_t data_size;
+    Node **nodes;
+    size_t node_count;
+} SegmentCacheEntry;
+
+/* Direct mapped: one input per slot, a new input evicts whatever shared its slot */
+struct SegmentCache {
+    SegmentCacheEntry *slots;
+    size_t slot_count;  /* Power of two */
+};
+
+static void segment_cache_free(SegmentCache *cache) {
+    if (!cache) return;
+    for (size_t i = 0; i < cache->slot_count; i++) {
+        free(cache->slots[i].data);
+        free(cache->slots[i].nodes);
+    }
+    free(cache->slots);
+    free(cache);
+}
+
+/* MEMOIZATION: Cache segmentation results in `slots` slots (rounded up to a power of two, 0 = off) */
+/* Existing entries are dropped, counters are kept */
+bool graph_set_segment_cache(MelvinGraph *g, size_t slots) {
+    if (!g) return false;
+    
+    segment_cache_free(g->segment_cache);
+    g->segment_cache = NULL;
+    if (slots == 0) return true;
+    
+    size_t slot_count = 1;
+    while (slot_count < slots) slot_count *= 2;
+    
+    SegmentCache *cache = (SegmentCache*)calloc(1, sizeof(SegmentCache));
+    if (!cache) return false;
+    cache->slots = (SegmentCacheEntry*)calloc(slot_count, sizeof(SegmentCacheEntry));
+    if (!cache->slots) {
+        free(cache);
+        return false;
+    }
+    cache->slot_count = slot_count;
+    g->segment_cache = cache;
+    return true;
+}
+
+/* FNV-1a over 8-byte words (then the tail), finished with a SplitMix64 step */
+static uint64_t segment_data_hash(const uint8_t *data, size_t data_size) {
+    uint64_t h = 0xCBF29CE484222325ULL ^ (uint64_t)data_size;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= data_size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        h = (h ^ word) * 0x100000001B3ULL;
+    }
+    for (; i < data_size; i++) {
+        h = (h ^ data[i]) * 0x100000001B3ULL;
+    }
+    return splitmix64_next(&h);
+}
+
+/* Fingerprint of the current context (last_activated, in order) */
+static uint64_t graph_context_hash(const MelvinGraph *g) {
+    uint64_t h = (uint64_t)g->last_activated_count;
+    for (size_t i = 0; i < g->last_activated_count; i++) {
+        uint64_t x = h ^ (uint64_t)(uintptr_t)g->last_activated[i];
+        h = splitmix64_next(&x);
+    }
+    return h;
+}
+
+/* Save a sequence as last_activated (activation context for the next input) */
+/* Memory = weights (persistent), Context = activation (current sequence becomes next context) */
+static void graph_remember_context(MelvinGraph *g, Node **sequence, size_t sequence_count) {
+    if (sequence_count == 0) return;
+    
+    /* Resize if needed */
+    if (sequence_count > g->last_activated_capacity) {
+        size_t new_capacity = sequence_count * 2;
+        Node **new_activated = (Node**)realloc(g->last_activated, new_capacity * sizeof(Node*));
+        if (new_activated) {
+            g->last_activated = new_activated;
+            g->last_activated_capacity = new_capacity;
+        }
+    }
+    
+    /* Copy sequence to last_activated (activation context for next input) */
+    if (sequence_count <= g->last_activated_capacity) {
+        memcpy(g->last_activated, sequence, sequence_count * sizeof(Node*));
+        g->last_activated_count = sequence_count;
+    }
+}
+
+/* Hit: a fresh copy of the stored sequence (NULL-terminated, caller frees) with the run's side */
+/* effects applied. Every node of a cached run was an exact match, which activates a node at rest */
+/* to 1.0 - replayed in sequence order so pushed deltas land the same way. NULL = miss */
+static Node** segment_cache_replay(MelvinGraph *g, const uint8_t *data, size_t data_size, uint64_t data_hash,
+                                   uint64_t context_hash, size_t *out_count) {
+    SegmentCache *cache = g->segment_cache;
+    SegmentCacheEntry *e = &cache->slots[data_hash & (cache->slot_count - 1)];
+    if (!e->nodes || e->data_hash != data_hash || e->context_hash != context_hash ||
+        e->structure_version != g->structure_version || e->data_size != data_size ||
+        memcmp(e->data, data, data_size) != 0) {
+        g->segment_cache_stats.misses++;
+        return NULL;
+    }
+    
+    Node **sequence = (Node**)malloc((e->node_count + 1) * sizeof(Node*));
+    if (!sequence) {
+        g->segment_cache_stats.misses++;
+        return NULL;  /* Segment in full instead */
+    }
+    memcpy(sequence, e->nodes, e->node_count * sizeof(Node*));
+    sequence[e->node_count] = NULL;
+    
+    for (size_t i = 0; i < e->node_count; i++) {
+        if (sequence[i]->activation_strength == 0.0f) node_set_activation_strength(sequence[i], 1.0f);
+    }
+    graph_remember_context(g, sequence, e->node_count);
+    
+    g->segment_cache_stats.hits++;
+    *out_count = e->node_count;
+    return sequence;
+}
+
+/* Store a full run in its slot, unless it grew the graph (the same bytes would now segment */
+/* against different structure). Allocation failure just leaves the input uncached */
+static void segment_cache_store(MelvinGraph *g, const uint8_t *data, size_t data_size, uint64_t data_hash,
+                                uint64_t context_hash, uint64_t structure_version, Node **sequence,
+                                size_t sequence_count) {
+    if (g->structure_version != structure_version) {
+        g->segment_cache_stats.uncached++;
+        return;
+    }
+    if (!sequence || sequence_count == 0) return;
+    
+    SegmentCacheEntry *e = &g->segment_cache->slots[data_hash & (g->segment_cache->slot_count - 1)];
+    uint8_t *stored_data = (uint8_t*)realloc(e->data, data_size);
+    if (!stored_data) return;
+    e->data = stored_data;
+    Node **stored_nodes = (Node**)realloc(e->nodes, sequence_count * sizeof(Node*));
+    if (!stored_nodes) {
+        e->data_size = 0;  /* Slot can no longer match */
+        return;
+    }
+    e->nodes = stored_nodes;
+    
+    memcpy(e->data, data, data_size);
+    memcpy(e->nodes, sequence, sequence_count * sizeof(Node*));
+    e->data_size = data_size;
+    e->node_count = sequence_count;
+    e->data_hash = data_hash;
+    e->context_hash = context_hash;
+    e->structure_version = structure_version;
+}
+
 /* Process input data to find sequential patterns and activate/create nodes */
 /* For "CAT", creates/finds nodes for C, A, T and returns them in sequence */
 /* Uses wave propagation to explore graph and discover existing nodes before creating new ones */
@@ -2620,6 +3686,17 @@ Node** wave_process_sequential_patterns(MelvinGraph *g, const uint8_t *data, siz
                                          size_t *out_count) {
     if (!g || !data || data_size == 0 || !out_count) return NULL;
     
+    /* MEMOIZATION: Byte-identical input in the same context and graph structure segments the same way */
+    uint64_t data_hash = 0;
+    uint64_t context_hash = 0;
+    uint64_t structure_version = g->structure_version;
+    if (g->segment_cache) {
+        data_hash = segment_data_hash(data, data_size);
+        context_hash = graph_context_hash(g);
+        Node **replayed = segment_cache_replay(g, data, data_size, data_hash, context_hash, out_count);
+        if (replayed) return replayed;
+    }
+    
     Node **sequence = NULL;
     size_t sequence_count = 0;
     size_t sequence_capacity = 0;
@@ -2710,7 +3787,7 @@ Node** wave_process_sequential_patterns(MelvinGraph *g, const uint8_t *data, siz
             /* Set activation based on match quality when node is found via any method above */
             if (activated_node && activated_node->activation_strength == 0.0f) {
                 float match_strength = node_calculate_match_strength(activated_node, pattern, pattern_size);
-                activated_node->activation_strength = match_strength;  /* Use computed match quality (data-driven) */
+                node_set_activation_strength(activated_node, match_strength);  /* Use computed match quality (data-driven) */
             }
         }
         
@@ -2718,7 +3795,7 @@ Node** wave_process_sequential_patterns(MelvinGraph *g, const uint8_t *data, siz
         node_found_fast_path:
         if (activated_node && activated_node->activation_strength == 0.0f) {
             /* Use exact match strength (1.0f) - no need to recalculate for fast path */
-            activated_node->activation_strength = 1.0f;
+            node_set_activation_strength(activated_node, 1.0f);
         }
         
         /* If no match found in hierarchy-first search, fall back to single-byte pattern matching */
@@ -2776,14 +3853,14 @@ Node** wave_process_sequential_patterns(MelvinGraph *g, const uint8_t *data, siz
                                 Edge *existing = node_find_edge_to(old_edge->from_node, filled_node);
                                 if (existing) {
                                     /* Edge already exists - strengthen it (learning through repetition) */
-                                    existing->activation = true;
+                                    edge_mark_activated(existing);
                                     edge_update_weight_local(existing);
                                 } else {
                                     /* Create new edge */
                                     Edge *new_edge = edge_create(old_edge->from_node, filled_node, true);
                                     if (new_edge) {
                                         new_edge->weight = compute_relative_initial_edge_weight(old_edge->from_node, old_edge->weight);
-                                        new_edge->activation = true;
+                                        edge_mark_activated(new_edge);
                                         graph_add_edge(g, new_edge, old_edge->from_node, filled_node);
                                     }
                                 }
@@ -2795,14 +3872,14 @@ Node** wave_process_sequential_patterns(MelvinGraph *g, const uint8_t *data, siz
                                 Edge *existing = node_find_edge_to(filled_node, old_edge->to_node);
                                 if (existing) {
                                     /* Edge already exists - strengthen it (learning through repetition) */
-                                    existing->activation = true;
+                                    edge_mark_activated(existing);
                                     edge_update_weight_local(existing);
                                 } else {
                                     /* Create new edge */
                                     Edge *new_edge = edge_create(filled_node, old_edge->to_node, true);
                                     if (new_edge) {
                                         new_edge->weight = compute_relative_initial_edge_weight(filled_node, old_edge->weight);
-                                        new_edge->activation = true;
+                                        edge_mark_activated(new_edge);
                                         graph_add_edge(g, new_edge, filled_node, old_edge->to_node);
                                     }
                                 }
@@ -2825,8 +3902,8 @@ Node** wave_process_sequential_patterns(MelvinGraph *g, const uint8_t *data, siz
                         
                         if (existing1 && existing2) {
                             /* Both edges exist - strengthen them (learning through repetition) */
-                            existing1->activation = true;
-                            existing2->activation = true;
+                            edge_mark_activated(existing1);
+                            edge_mark_activated(existing2);
                             edge_update_weight_local(existing1);
                             edge_update_weight_local(existing2);
                         } else {
@@ -2845,17 +3922,17 @@ Node** wave_process_sequential_patterns(MelvinGraph *g, const uint8_t *data, siz
                                 /* Both new - use acceptance strength as initial weight */
                                 edge1->weight = compute_relative_initial_edge_weight(new_pattern_node, acceptance_strength);
                                 edge2->weight = compute_relative_initial_edge_weight(accepting_blank, acceptance_strength);
-                                edge1->activation = true;
-                                edge2->activation = true;
+                                edge_mark_activated(edge1);
+                                edge_mark_activated(edge2);
                                 graph_add_edge(g, edge1, new_pattern_node, accepting_blank);
                                 graph_add_edge(g, edge2, accepting_blank, new_pattern_node);
                             } else if (edge1) {
                                 edge1->weight = compute_relative_initial_edge_weight(new_pattern_node, acceptance_strength);
-                                edge1->activation = true;
+                                edge_mark_activated(edge1);
                                 graph_add_edge(g, edge1, new_pattern_node, accepting_blank);
                             } else if (edge2) {
                                 edge2->weight = compute_relative_initial_edge_weight(accepting_blank, acceptance_strength);
-                                edge2->activation = true;
+                                edge_mark_activated(edge2);
                                 graph_add_edge(g, edge2, accepting_blank, new_pattern_node);
                             } else {
                                 /* Both exist - should have been handled above */
@@ -2865,11 +3942,11 @@ Node** wave_process_sequential_patterns(MelvinGraph *g, const uint8_t *data, siz
                             
                             /* Strengthen existing edges if they exist */
                             if (existing1) {
-                                existing1->activation = true;
+                                edge_mark_activated(existing1);
                                 edge_update_weight_local(existing1);
                             }
                             if (existing2) {
-                                existing2->activation = true;
+                                edge_mark_activated(existing2);
                                 edge_update_weight_local(existing2);
                             }
                         }
@@ -2894,7 +3971,7 @@ Node** wave_process_sequential_patterns(MelvinGraph *g, const uint8_t *data, siz
             if (new_node && graph_add_node(g, new_node)) {
                 activated_node = new_node;
                 /* DATA-DRIVEN: Bootstrap activation_strength based on match quality */
-                activated_node->activation_strength = 1.0f;  /* New pattern, full activation */
+                node_set_activation_strength(activated_node, 1.0f);  /* New pattern, full activation */
             } else {
                 if (new_node) node_free(new_node);
             }
@@ -2906,7 +3983,7 @@ Node** wave_process_sequential_patterns(MelvinGraph *g, const uint8_t *data, siz
             if (activated_node->activation_strength == 0.0f) {
                 /* Use match strength as initial activation if this node was matched */
                 float match_strength = node_calculate_match_strength(activated_node, pattern, pattern_size);
-                activated_node->activation_strength = match_strength;
+                node_set_activation_strength(activated_node, match_strength);
             }
             
             /* Always add node to sequence (even if same node appears multiple times in input) */
@@ -2931,45 +4008,316 @@ Node** wave_process_sequential_patterns(MelvinGraph *g, const uint8_t *data, siz
     }
     
     /* Update graph context: save current sequence as last_activated for next input */
-    /* Memory = weights (persistent), Context = activation (current sequence becomes next context) */
-    if (sequence_count > 0) {
-        /* Resize if needed */
-        if (sequence_count > g->last_activated_capacity) {
-            size_t new_capacity = sequence_count * 2;
-            Node **new_activated = (Node**)realloc(g->last_activated, new_capacity * sizeof(Node*));
-            if (new_activated) {
-                g->last_activated = new_activated;
-                g->last_activated_capacity = new_capacity;
-            }
-        }
-        
-        /* Copy sequence to last_activated (activation context for next input) */
-        if (sequence_count <= g->last_activated_capacity) {
-            memcpy(g->last_activated, sequence, sequence_count * sizeof(Node*));
-            g->last_activated_count = sequence_count;
-        }
+    graph_remember_context(g, sequence, sequence_count);
+    
+    /* MEMOIZATION: Remember the sequence if segmenting it left the graph's structure unchanged */
+    if (g->segment_cache) {
+        segment_cache_store(g, data, data_size, data_hash, context_hash, structure_version, sequence, sequence_count);
     }
     
     *out_count = sequence_count;
     return sequence;
 }
 
-/* Create edges between similar patterns (structural similarity) */
-/* Philosophy: Similar patterns should connect even if they rarely co-activate */
-void wave_create_edges_from_similarity(MelvinGraph *g, Node *node, float similarity_threshold) {
-    if (!g || !node) return;  /* UNIVERSAL: All nodes can form similarity edges */
-    
-    /* README: Brain-like - only check local neighbors for similar patterns (O(degree), not O(n)) */
-    /* Similar patterns are found through local connections, not global search */
-    Node *similar = NULL;
-    float best_similarity = 0.0f;
+/* ========================================
+ * GROWTH BUDGET (structural growth governor)
+ * ======================================== */
+
+/* GROWTH BUDGET: Optional structure (combined and generalization nodes, edges inherited by */
+/* hierarchy nodes, context/similarity/homeostatic/hierarchy edges) is admitted against a */
+/* per-input allowance; input segmentation and co-activation edges are the input itself and are */
+/* never capped. While a budget is armed the laws only propose: every law's candidates for the */
+/* input are queued, ranked together at settle and admitted strongest first, so a strong */
+/* candidate from a late law is not crowded out by weak ones from an earlier law */
+void graph_set_growth_budget(MelvinGraph *g, float nodes_per_byte) {
+    if (!g) return;
+    g->growth_per_byte = (nodes_per_byte > 0.0f) ? nodes_per_byte : 0.0f;
+}
+
+/* Arm the caps for one input: nodes scale with input size, edges with input size times log2 of */
+/* the graph size (enough for a new node to stay reachable without copying its parts' degree) */
+void graph_begin_growth_budget(MelvinGraph *g, size_t input_size) {
+    if (!g) return;
+    g->growth_budget_armed = (g->growth_per_byte > 0.0f);
+    if (!g->growth_budget_armed) return;
     
-    /* LOCAL-ONLY: Check outgoing edges (1-hop neighbors) - O(degree), not O(n) */
-    for (size_t i = 0; i < node->outgoing_count; i++) {
-        Edge *edge = node->outgoing_edges[i];
-        if (!edge || !edge->to_node || edge->to_node == node) continue;
-        
-        Node *candidate = edge->to_node;
+    float nodes = ceilf(g->growth_per_byte * (float)input_size);
+    float reach = log2f((float)g->node_count + 2.0f);
+    g->growth_nodes_left = (size_t)nodes;
+    g->growth_edges_left = (size_t)ceilf(nodes * reach);
+}
+
+void graph_end_growth_budget(MelvinGraph *g) {
+    if (!g) return;
+    graph_settle_growth(g);  /* Proposals not settled yet (no-op after graph_settle_growth) */
+    g->growth_budget_armed = false;
+}
+
+/* Admit one optional node (blank = generalization); refused once the input's allowance is spent */
+static bool growth_admit_node(MelvinGraph *g, bool blank) {
+    if (g->growth_budget_armed && g->growth_nodes_left == 0) {
+        if (blank) g->growth_stats.blank_nodes_suppressed++;
+        else g->growth_stats.nodes_suppressed++;
+        return false;
+    }
+    if (g->growth_budget_armed) g->growth_nodes_left--;
+    if (blank) g->growth_stats.blank_nodes_accepted++;
+    else g->growth_stats.nodes_accepted++;
+    return true;
+}
+
+/* Admit one optional edge */
+static bool growth_admit_edge(MelvinGraph *g) {
+    if (g->growth_budget_armed && g->growth_edges_left == 0) {
+        g->growth_stats.edges_suppressed++;
+        return false;
+    }
+    if (g->growth_budget_armed) g->growth_edges_left--;
+    g->growth_stats.edges_accepted++;
+    return true;
+}
+
+/* Edges that come with an admitted node (a generalization's member links) - counted and drawn */
+/* from the allowance, never refused (the node would be unreachable without them) */
+static void growth_note_edges(MelvinGraph *g, size_t count) {
+    g->growth_stats.edges_accepted += count;
+    if (!g->growth_budget_armed) return;
+    g->growth_edges_left = (g->growth_edges_left > count) ? g->growth_edges_left - count : 0;
+}
+
+typedef struct GrowthRank {
+    float strength;
+    size_t index;
+} GrowthRank;
+
+static int growth_rank_compare(const void *a, const void *b) {
+    const GrowthRank *ra = (const GrowthRank*)a;
+    const GrowthRank *rb = (const GrowthRank*)b;
+    if (ra->strength != rb->strength) return (ra->strength > rb->strength) ? -1 : 1;
+    return (ra->index < rb->index) ? -1 : (ra->index > rb->index);
+}
+
+/* Visit order for n candidates: strongest first (ties keep their order) while a budget is armed */
+/* NULL = visit in the original order (no budget armed, fewer than 2 candidates, or no memory) */
+static size_t* growth_rank_order(MelvinGraph *g, const float *strength, size_t n) {
+    if (!g->growth_budget_armed || !strength || n < 2) return NULL;
+    
+    GrowthRank *ranks = (GrowthRank*)malloc(n * sizeof(GrowthRank));
+    size_t *order = (size_t*)malloc(n * sizeof(size_t));
+    if (!ranks || !order) {
+        free(ranks);
+        free(order);
+        return NULL;
+    }
+    for (size_t i = 0; i < n; i++) {
+        ranks[i].strength = strength[i];
+        ranks[i].index = i;
+    }
+    qsort(ranks, n, sizeof(GrowthRank), growth_rank_compare);
+    for (size_t i = 0; i < n; i++) order[i] = ranks[i].index;
+    free(ranks);
+    return order;
+}
+
+/* Structure a law proposes while a budget is armed */
+typedef enum GrowthKind {
+    GROWTH_PAIR_EDGES,      /* Similarity/context law: missing directions between a and b */
+    GROWTH_GENERALIZATION,  /* Blank node joined to a and b */
+    GROWTH_COMBINATION,     /* Hierarchy node for parts a, b (with inherited edges) */
+    GROWTH_HOMEOSTATIC      /* One weak edge a -> b from an isolated node */
+} GrowthKind;
+
+struct GrowthCandidate {
+    GrowthKind kind;
+    float strength;  /* Common scale across laws - see growth_margin */
+    Node *a;
+    Node *b;
+    float score;     /* Similarity the new edges are weighted from (pair edges, generalizations) */
+    bool activate;   /* Combination: compute the new node's activation (combination law) */
+};
+
+/* Commits, defined with their laws - also used directly when nothing is armed */
+static void pair_edges_commit(MelvinGraph *g, Node *node1, Node *node2, float similarity);
+static void generalization_commit(MelvinGraph *g, Node *node1, Node *node2, float similarity);
+static void combination_commit(MelvinGraph *g, Node *node1, Node *node2, bool activate);
+static bool homeostatic_edge_commit(MelvinGraph *g, Node *isolated_node, Node *well_connected);
+
+/* RELATIVE: How clearly a candidate clears its own law's bar, value / (value + bar) - 1/2 at */
+/* the bar, towards 1 above it, 1 when the law has no bar - so laws that measure in different */
+/* units (similarity, edge weight, degree) rank on one scale */
+static float growth_margin(float value, float bar) {
+    if (bar <= 0.0f) return 1.0f;
+    return (value > 0.0f) ? value / (value + bar) : 0.0f;
+}
+
+/* Queue a candidate while a budget is armed; false = commit it now (nothing armed, or the */
+/* queue could not grow - admission then falls back to first come, first served) */
+static bool growth_propose(MelvinGraph *g, GrowthKind kind, Node *a, Node *b, float score,
+                           bool activate, float strength) {
+    if (!g->growth_budget_armed) return false;
+    if (g->growth_pending_count >= g->growth_pending_capacity) {
+        /* Minimal context: start at 1, double on growth */
+        size_t new_capacity = (g->growth_pending_capacity > 0) ? g->growth_pending_capacity * 2 : 1;
+        GrowthCandidate *grown = (GrowthCandidate*)realloc(g->growth_pending,
+                                                           new_capacity * sizeof(GrowthCandidate));
+        if (!grown) return false;
+        g->growth_pending = grown;
+        g->growth_pending_capacity = new_capacity;
+    }
+    GrowthCandidate *c = &g->growth_pending[g->growth_pending_count++];
+    c->kind = kind;
+    c->strength = strength;
+    c->a = a;
+    c->b = b;
+    c->score = score;
+    c->activate = activate;
+    return true;
+}
+
+static void growth_commit(MelvinGraph *g, const GrowthCandidate *c) {
+    switch (c->kind) {
+        case GROWTH_PAIR_EDGES:     pair_edges_commit(g, c->a, c->b, c->score); break;
+        case GROWTH_GENERALIZATION: generalization_commit(g, c->a, c->b, c->score); break;
+        case GROWTH_COMBINATION:    combination_commit(g, c->a, c->b, c->activate); break;
+        case GROWTH_HOMEOSTATIC:    homeostatic_edge_commit(g, c->a, c->b); break;
+    }
+}
+
+/* Admit this input's proposals, strongest first across all laws (ties in proposal order). */
+/* Each commit re-checks what its law checked against the graph as it is now (an earlier */
+/* commit may have created the same structure) and draws on the allowance as before; what a */
+/* committed node brings along (inherited and hierarchy edges) is admitted with it */
+void graph_settle_growth(MelvinGraph *g) {
+    if (!g || g->growth_pending_count == 0) return;
+    
+    /* Detach first - commits never propose, and the queue is empty for the next input */
+    GrowthCandidate *pending = g->growth_pending;
+    size_t count = g->growth_pending_count;
+    g->growth_pending = NULL;
+    g->growth_pending_count = 0;
+    g->growth_pending_capacity = 0;
+    
+    float *strength = (float*)malloc(count * sizeof(float));
+    size_t *order = NULL;
+    if (strength) {
+        for (size_t i = 0; i < count; i++) strength[i] = pending[i].strength;
+        order = growth_rank_order(g, strength, count);
+        free(strength);
+    }
+    for (size_t k = 0; k < count; k++) {
+        growth_commit(g, &pending[order ? order[k] : k]);
+    }
+    free(order);
+    free(pending);
+}
+
+/* ========================================
+ * PARALLEL EDGE FORMATION
+ * ======================================== */
+
+/* PARALLEL EDGE FORMATION: The similarity and generalization laws spend most of their time */
+/* scoring candidates (pattern similarity), which only reads the graph. Scores are computed on */
+/* the thread pool against the graph as it stood when the law started (workers run read-only, */
+/* so no cache is written), split into contiguous runs of candidates - one run per thread, so */
+/* each source node is owned by exactly one worker. Edges are then created serially, in */
+/* candidate order. Each commit records the nodes it changed; a later candidate whose score */
+/* read one of them is rescored in place, so the graph matches the single-threaded loop. */
+/* Not partitioned: co-activation is a chain (each pair shares a node with the one before), */
+/* context pairs mostly read a node an earlier pair of the same call strengthened (70-75% on */
+/* text), and the homeostatic law checks one sampled node - together 4-16% of formation time, */
+/* so these laws stay serial and create their edges directly */
+typedef struct EdgeScore {
+    Node *node;       /* Source node (similarity law) or first member (generalization law) */
+    Node *partner;    /* Best neighbor (similarity law - set by scoring) or second member */
+    float score;
+} EdgeScore;
+
+typedef void (*EdgeScoreFunc)(EdgeScore *entry);
+
+typedef struct EdgeScoreBatch {
+    EdgeScore *entries;  /* One per candidate, in commit order (NULL node = not a candidate) */
+    size_t count;
+    VisitedSet *touched; /* Nodes changed by commits since scoring */
+    bool precomputed;    /* false = every candidate is scored at commit (serial path) */
+} EdgeScoreBatch;
+
+static void edge_score_worker(void *item, size_t index, void *context) {
+    (void)index;
+    EdgeScoreFunc score = *(EdgeScoreFunc*)context;
+    bool previous_read_only = tls_read_only_query;
+    tls_read_only_query = true;
+    score((EdgeScore*)item);
+    tls_read_only_query = previous_read_only;
+}
+
+static bool edge_score_batch_init(EdgeScoreBatch *batch, size_t count) {
+    memset(batch, 0, sizeof(*batch));
+    if (count == 0) return true;
+    batch->entries = (EdgeScore*)calloc(count, sizeof(EdgeScore));
+    if (!batch->entries) return false;
+    batch->count = count;
+    return true;
+}
+
+/* Score every candidate on the thread pool (skipped with one thread or fewer candidates than */
+/* threads - those are scored at commit, exactly as before) */
+/* Scope: scoring is about 30-40% of edge-formation time on text (the rest is the serial commit */
+/* and the serial laws), so the pool can speed formation up by at most about 1.4-1.6x */
+static void edge_score_batch_precompute(EdgeScoreBatch *batch, EdgeScoreFunc score) {
+    ThreadPool *pool = get_thread_pool();
+    if (!pool || pool->thread_count < 2 || batch->count < pool->thread_count) return;
+    
+    void **items = (void**)malloc(batch->count * sizeof(void*));
+    if (!items) return;
+    size_t active = 0;
+    for (size_t i = 0; i < batch->count; i++) {
+        if (batch->entries[i].node) items[active++] = &batch->entries[i];
+    }
+    
+    /* A touched set we can't record into would let stale scores through - score at commit instead */
+    batch->touched = (active >= pool->thread_count) ? visited_set_create(active) : NULL;
+    if (batch->touched) {
+        thread_pool_process_array(pool, items, active, edge_score_worker, &score);
+        batch->precomputed = true;
+    }
+    free(items);
+}
+
+/* Record a node changed by a commit (on failure, every later score is recomputed) */
+static void edge_score_batch_touch(EdgeScoreBatch *batch, Node *node) {
+    if (batch->precomputed && !visited_set_add(batch->touched, node)) {
+        batch->precomputed = false;
+    }
+}
+
+static bool edge_score_batch_is_stale(EdgeScoreBatch *batch, Node *node) {
+    return !batch->precomputed || visited_set_contains(batch->touched, node);
+}
+
+static void edge_score_batch_free(EdgeScoreBatch *batch) {
+    free(batch->entries);
+    visited_set_free(batch->touched);
+    memset(batch, 0, sizeof(*batch));
+}
+
+/* Generalization law score: pattern similarity of the member pair */
+static void edge_score_pattern(EdgeScore *entry) {
+    entry->score = edge_compute_pattern_similarity(entry->node, entry->partner);
+}
+
+/* Best-matching 1-hop neighbor of node (reads only - scored by the parallel edge phase) */
+static Node* similarity_find_best_neighbor(Node *node, float *best_similarity_out) {
+    /* README: Brain-like - only check local neighbors for similar patterns (O(degree), not O(n)) */
+    /* Similar patterns are found through local connections, not global search */
+    Node *similar = NULL;
+    float best_similarity = 0.0f;
+    
+    /* LOCAL-ONLY: Check outgoing edges (1-hop neighbors) - O(degree), not O(n) */
+    for (size_t i = 0; i < node->outgoing_count; i++) {
+        Edge *edge = node->outgoing_edges[i];
+        if (!edge || !edge->to_node || edge->to_node == node) continue;
+        
+        Node *candidate = edge->to_node;
         if (candidate->payload_size > 0) {  /* Only check nodes with payloads */
             float similarity = edge_compute_pattern_similarity(node, candidate);
             if (similarity > best_similarity) {
@@ -2994,6 +4342,60 @@ void wave_create_edges_from_similarity(MelvinGraph *g, Node *node, float similar
         }
     }
     
+    *best_similarity_out = best_similarity;
+    return similar;
+}
+
+/* Similarity law score: best neighbor and its similarity */
+static void edge_score_similarity(EdgeScore *entry) {
+    entry->partner = similarity_find_best_neighbor(entry->node, &entry->score);
+}
+
+/* A similarity score read the node and every 1-hop neighbor (its edge lists only change */
+/* when the node itself is touched, so the current lists are the ones that were scored) */
+static bool similarity_score_is_stale(EdgeScoreBatch *batch, Node *node) {
+    if (!batch->precomputed) return true;
+    if (edge_score_batch_is_stale(batch, node)) return true;
+    for (size_t i = 0; i < node->outgoing_count; i++) {
+        Edge *edge = node->outgoing_edges[i];
+        if (edge && edge_score_batch_is_stale(batch, edge->to_node)) return true;
+    }
+    for (size_t i = 0; i < node->incoming_count; i++) {
+        Edge *edge = node->incoming_edges[i];
+        if (edge && edge_score_batch_is_stale(batch, edge->from_node)) return true;
+    }
+    return false;
+}
+
+/* Create whichever directions between node1 and node2 are missing, weighted from similarity */
+/* (similarity and context laws - a direction that exists was strengthened by the law) */
+static void pair_edges_commit(MelvinGraph *g, Node *node1, Node *node2, float similarity) {
+    Edge *edge1 = NULL;
+    Edge *edge2 = NULL;
+    
+    if (!node_find_edge_to(node1, node2) && growth_admit_edge(g)) {
+        edge1 = edge_create(node1, node2, true);
+    }
+    if (!node_find_edge_to(node2, node1) && growth_admit_edge(g)) {
+        edge2 = edge_create(node2, node1, true);
+    }
+    
+    /* RELATIVE: Initial weight relative to local context (no hardcoded multiplier) */
+    if (edge1) {
+        edge1->weight = compute_relative_initial_edge_weight(node1, similarity);
+        edge_mark_activated(edge1);
+    }
+    if (edge2) {
+        edge2->weight = compute_relative_initial_edge_weight(node2, similarity);
+        edge_mark_activated(edge2);
+    }
+    if (edge1) graph_add_edge(g, edge1, node1, node2);
+    if (edge2) graph_add_edge(g, edge2, node2, node1);
+}
+
+/* Strengthen or create the edges between node and its most similar neighbor */
+static void similarity_commit(MelvinGraph *g, Node *node, Node *similar, float best_similarity,
+                              float similarity_threshold) {
     if (!similar || similar == node) return;
     
     /* Check if edges already exist (check both directions for bidirectional edges) */
@@ -3003,8 +4405,8 @@ void wave_create_edges_from_similarity(MelvinGraph *g, Node *node, float similar
     /* If edges exist, strengthen them (compounding learning) */
     if (existing1 && existing2) {
         /* Both directions exist - strengthen both */
-        existing1->activation = true;
-        existing2->activation = true;
+        edge_mark_activated(existing1);
+        edge_mark_activated(existing2);
         edge_update_weight_local(existing1);
         edge_update_weight_local(existing2);
         return;
@@ -3012,11 +4414,11 @@ void wave_create_edges_from_similarity(MelvinGraph *g, Node *node, float similar
         /* One direction exists - strengthen it, but we still need to create the other */
         /* This handles asymmetric edge cases */
         if (existing1) {
-            existing1->activation = true;
+            edge_mark_activated(existing1);
             edge_update_weight_local(existing1);
         }
         if (existing2) {
-            existing2->activation = true;
+            edge_mark_activated(existing2);
             edge_update_weight_local(existing2);
         }
         /* Continue to create missing direction if similarity threshold is met */
@@ -3051,47 +4453,315 @@ void wave_create_edges_from_similarity(MelvinGraph *g, Node *node, float similar
         relative_threshold = (relative_threshold > similarity_threshold) ? relative_threshold : similarity_threshold;
     }
     
-    if (similarity >= relative_threshold) {
-        /* Create bidirectional edge for similar patterns (only if doesn't already exist) */
-        Edge *edge1 = NULL;
-        Edge *edge2 = NULL;
-        
-        if (!existing1) {
-            edge1 = edge_create(node, similar, true);
+    /* Create the missing directions (GROWTH BUDGET: proposed instead while capped) */
+    if (similarity >= relative_threshold &&
+        !growth_propose(g, GROWTH_PAIR_EDGES, node, similar, similarity, false,
+                        growth_margin(similarity, relative_threshold))) {
+        pair_edges_commit(g, node, similar, similarity);
+    }
+}
+
+/* Create edges between similar patterns (structural similarity) */
+/* Philosophy: Similar patterns should connect even if they rarely co-activate */
+void wave_create_edges_from_similarity(MelvinGraph *g, Node *node, float similarity_threshold) {
+    if (!g || !node) return;  /* UNIVERSAL: All nodes can form similarity edges */
+    
+    float best_similarity = 0.0f;
+    Node *similar = similarity_find_best_neighbor(node, &best_similarity);
+    similarity_commit(g, node, similar, best_similarity, similarity_threshold);
+}
+
+/* ========================================
+ * CANDIDATE PAIRS (bucketed, instead of sampled pair loops)
+ * ======================================== */
+
+/* CANDIDATE PAIRS: Index pairs (i < j) into a node set, sorted and unique once finalized */
+/* Laws walk them in the same (i, j) order the old nested loops used, but only over pairs that */
+/* can matter (joined by an edge, sharing a neighbor, sharing payload bytes) - nothing is sampled away */
+typedef struct PairCandidates {
+    size_t *pairs;      /* Two indices per pair */
+    size_t count;
+    size_t capacity;
+} PairCandidates;
+
+/* Node -> first index in the set (sorted by pointer, looked up by binary search) */
+typedef struct NodeIndexEntry {
+    Node *node;
+    size_t index;
+} NodeIndexEntry;
+
+/* Bucket membership: key shared by nodes that may pair up */
+typedef struct PairBucketEntry {
+    uint64_t key;
+    size_t index;
+} PairBucketEntry;
+
+static int compare_node_index_entries(const void *a, const void *b) {
+    const NodeIndexEntry *ea = (const NodeIndexEntry*)a;
+    const NodeIndexEntry *eb = (const NodeIndexEntry*)b;
+    if ((uintptr_t)ea->node != (uintptr_t)eb->node) return ((uintptr_t)ea->node < (uintptr_t)eb->node) ? -1 : 1;
+    if (ea->index != eb->index) return (ea->index < eb->index) ? -1 : 1;
+    return 0;
+}
+
+static int compare_pair_bucket_entries(const void *a, const void *b) {
+    const PairBucketEntry *ea = (const PairBucketEntry*)a;
+    const PairBucketEntry *eb = (const PairBucketEntry*)b;
+    if (ea->key != eb->key) return (ea->key < eb->key) ? -1 : 1;
+    if (ea->index != eb->index) return (ea->index < eb->index) ? -1 : 1;
+    return 0;
+}
+
+static int compare_index_pairs(const void *a, const void *b) {
+    const size_t *pa = (const size_t*)a;
+    const size_t *pb = (const size_t*)b;
+    if (pa[0] != pb[0]) return (pa[0] < pb[0]) ? -1 : 1;
+    if (pa[1] != pb[1]) return (pa[1] < pb[1]) ? -1 : 1;
+    return 0;
+}
+
+static bool pair_candidates_add(PairCandidates *pc, size_t i, size_t j) {
+    if (i == j) return true;
+    if (i > j) {
+        size_t tmp = i; i = j; j = tmp;
+    }
+    if (pc->count >= pc->capacity) {
+        size_t new_capacity = (pc->capacity == 0) ? 1 : pc->capacity * 2;  /* Minimal context: start at 1 */
+        size_t *new_pairs = (size_t*)realloc(pc->pairs, new_capacity * 2 * sizeof(size_t));
+        if (!new_pairs) return false;
+        pc->pairs = new_pairs;
+        pc->capacity = new_capacity;
+    }
+    pc->pairs[pc->count * 2] = i;
+    pc->pairs[pc->count * 2 + 1] = j;
+    pc->count++;
+    return true;
+}
+
+/* Closest pairs first (set order follows the wave, so near indices share a path), then by i */
+static int compare_index_pairs_by_distance(const void *a, const void *b) {
+    const size_t *pa = (const size_t*)a;
+    const size_t *pb = (const size_t*)b;
+    size_t da = pa[1] - pa[0];
+    size_t db = pb[1] - pb[0];
+    if (da != db) return (da < db) ? -1 : 1;
+    return compare_index_pairs(a, b);
+}
+
+/* Unique pair with its bucket overlap (how many edges / shared neighbors / shared bytes found it) */
+typedef struct ScoredPair {
+    size_t pair[2];
+    size_t overlap;
+} ScoredPair;
+
+/* Most overlap first, then closest, then by i */
+static int compare_scored_pairs(const void *a, const void *b) {
+    const ScoredPair *sa = (const ScoredPair*)a;
+    const ScoredPair *sb = (const ScoredPair*)b;
+    if (sa->overlap != sb->overlap) return (sa->overlap > sb->overlap) ? -1 : 1;
+    return compare_index_pairs_by_distance(sa->pair, sb->pair);
+}
+
+/* Sort into nested-loop order and drop pairs found through more than one bucket */
+/* More than max_pairs candidates: keep the max_pairs with the most bucket overlap (ties: closest), */
+/* so the per-call work bound of the old sampled loops still holds, spent on the pairs with the */
+/* most shared structure instead of the set's first √n nodes. Without memory to score, closest. */
+static void pair_candidates_finalize(PairCandidates *pc, size_t max_pairs) {
+    if (pc->count < 2) return;
+    qsort(pc->pairs, pc->count, 2 * sizeof(size_t), compare_index_pairs);
+    
+    /* Overlap is only needed when truncating (unique <= count) */
+    ScoredPair *scored = (pc->count > max_pairs) ? (ScoredPair*)malloc(pc->count * sizeof(ScoredPair)) : NULL;
+    size_t unique = 0;
+    for (size_t p = 0; p < pc->count; p++) {
+        if (unique > 0 && compare_index_pairs(&pc->pairs[p * 2], &pc->pairs[(unique - 1) * 2]) == 0) {
+            if (scored) scored[unique - 1].overlap++;
+            continue;
         }
-        if (!existing2) {
-            edge2 = edge_create(similar, node, true);
+        pc->pairs[unique * 2] = pc->pairs[p * 2];
+        pc->pairs[unique * 2 + 1] = pc->pairs[p * 2 + 1];
+        if (scored) {
+            scored[unique].pair[0] = pc->pairs[p * 2];
+            scored[unique].pair[1] = pc->pairs[p * 2 + 1];
+            scored[unique].overlap = 1;
         }
-        
-        if (edge1 && edge2) {
-            /* RELATIVE: Initial weight relative to local context (no hardcoded multiplier) */
-            float initial_weight1 = compute_relative_initial_edge_weight(node, similarity);
-            float initial_weight2 = compute_relative_initial_edge_weight(similar, similarity);
-            edge1->weight = initial_weight1;
-            edge2->weight = initial_weight2;
-            edge1->activation = true;
-            edge2->activation = true;
-            
-            graph_add_edge(g, edge1, node, similar);
-            graph_add_edge(g, edge2, similar, node);
-        } else if (edge1) {
-            /* Only edge1 needs to be created */
-            float initial_weight1 = compute_relative_initial_edge_weight(node, similarity);
-            edge1->weight = initial_weight1;
-            edge1->activation = true;
-            graph_add_edge(g, edge1, node, similar);
-        } else if (edge2) {
-            /* Only edge2 needs to be created */
-            float initial_weight2 = compute_relative_initial_edge_weight(similar, similarity);
-            edge2->weight = initial_weight2;
-            edge2->activation = true;
-            graph_add_edge(g, edge2, similar, node);
+        unique++;
+    }
+    pc->count = unique;
+    
+    if (pc->count > max_pairs) {
+        if (scored) {
+            qsort(scored, pc->count, sizeof(ScoredPair), compare_scored_pairs);
+            for (size_t p = 0; p < max_pairs; p++) {
+                pc->pairs[p * 2] = scored[p].pair[0];
+                pc->pairs[p * 2 + 1] = scored[p].pair[1];
+            }
         } else {
-            /* Both already exist - should have been handled above, but free if somehow created */
-            if (edge1) edge_free(edge1);
-            if (edge2) edge_free(edge2);
+            qsort(pc->pairs, pc->count, 2 * sizeof(size_t), compare_index_pairs_by_distance);
         }
+        pc->count = max_pairs;
+        qsort(pc->pairs, pc->count, 2 * sizeof(size_t), compare_index_pairs);
     }
+    free(scored);
+}
+
+/* Per-call pair budget: two thirds of the pairs among ~√n nodes the sampled loops checked. Ranked */
+/* candidates pass the laws' thresholds far more often than sampled pairs did, so the full bound */
+/* grew the graph several times faster; two thirds keeps growth near the sampled loops' rate */
+static size_t pair_candidates_budget(size_t count) {
+    size_t sample_size = compute_adaptive_sample_limit(count, 2, count);
+    size_t budget = sample_size * (sample_size - 1) / 3;
+    return (budget > 0) ? budget : 1;  /* Minimal context: at least the closest pair */
+}
+
+static void pair_candidates_free(PairCandidates *pc) {
+    free(pc->pairs);
+    pc->pairs = NULL;
+    pc->count = 0;
+    pc->capacity = 0;
+}
+
+/* Build the node -> index lookup (duplicates keep their first index) */
+static NodeIndexEntry* node_index_build(Node **nodes, size_t count) {
+    NodeIndexEntry *entries = (NodeIndexEntry*)malloc(count * sizeof(NodeIndexEntry));
+    if (!entries) return NULL;
+    for (size_t i = 0; i < count; i++) {
+        entries[i].node = nodes[i];
+        entries[i].index = i;
+    }
+    qsort(entries, count, sizeof(NodeIndexEntry), compare_node_index_entries);
+    return entries;
+}
+
+static bool node_index_find(const NodeIndexEntry *entries, size_t count, Node *node, size_t *index) {
+    size_t lo = 0, hi = count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if ((uintptr_t)entries[mid].node < (uintptr_t)node) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo < count && entries[lo].node == node) {
+        *index = entries[lo].index;
+        return true;
+    }
+    return false;
+}
+
+/* Pairs joined by an edge in either direction: walk each member's outgoing edges (O(sum of degrees)) */
+static bool pair_candidates_from_edges(PairCandidates *pc, Node **nodes, size_t count,
+                                       const NodeIndexEntry *index, size_t index_count) {
+    for (size_t i = 0; i < count; i++) {
+        Node *node = nodes[i];
+        if (!node) continue;
+        for (size_t k = 0; k < node->outgoing_count; k++) {
+            Edge *edge = node->outgoing_edges[k];
+            size_t j;
+            if (!edge || !edge->to_node || edge->to_node == node) continue;
+            if (node_index_find(index, index_count, edge->to_node, &j) &&
+                !pair_candidates_add(pc, i, j)) return false;
+        }
+    }
+    return true;
+}
+
+/* Bucket key: kind-tagged value, mixed so different kinds don't line up */
+static uint64_t pair_bucket_key(uint64_t kind, uint64_t value) {
+    uint64_t x = value ^ (kind * 0xD6E8FEB86659FD93ULL);
+    return splitmix64_next(&x);
+}
+
+/* Pair members that share a bucket key. Within a bucket each member pairs with the next `window` */
+/* members (by set index): a key shared by a large part of the set (a hub neighbor, a common byte) */
+/* says little, so it adds O(window) pairs per member instead of O(bucket) */
+static bool pair_candidates_from_buckets(PairCandidates *pc, PairBucketEntry *entries, size_t entry_count,
+                                         size_t window) {
+    if (entry_count < 2) return true;
+    qsort(entries, entry_count, sizeof(PairBucketEntry), compare_pair_bucket_entries);
+    
+    size_t run_start = 0;
+    while (run_start < entry_count) {
+        size_t run_end = run_start + 1;
+        while (run_end < entry_count && entries[run_end].key == entries[run_start].key) run_end++;
+        
+        for (size_t a = run_start; a < run_end; a++) {
+            for (size_t b = a + 1; b < run_end && b <= a + window; b++) {
+                if (!pair_candidates_add(pc, entries[a].index, entries[b].index)) return false;
+            }
+        }
+        run_start = run_end;
+    }
+    return true;
+}
+
+static bool pair_bucket_push(PairBucketEntry **entries, size_t *count, size_t *capacity,
+                             uint64_t key, size_t index) {
+    if (*count >= *capacity) {
+        size_t new_capacity = (*capacity == 0) ? 1 : *capacity * 2;  /* Minimal context: start at 1 */
+        PairBucketEntry *new_entries = (PairBucketEntry*)realloc(*entries, new_capacity * sizeof(PairBucketEntry));
+        if (!new_entries) return false;
+        *entries = new_entries;
+        *capacity = new_capacity;
+    }
+    (*entries)[*count].key = key;
+    (*entries)[*count].index = index;
+    (*count)++;
+    return true;
+}
+
+#define PAIR_KEY_NEIGHBOR 1ULL  /* Shared neighbor (paths through the same node) */
+#define PAIR_KEY_BYTE     2ULL  /* Same byte at the same payload position (aligned overlap) */
+
+/* Pairs sharing a neighbor (in + out edges); only neighbors in `context` count when it is given */
+/* and/or pairs with a payload byte in common at the same position (finalize before walking) */
+static bool pair_candidates_from_signatures(PairCandidates *pc, Node **nodes, size_t count,
+                                            bool by_neighbor, VisitedSet *context, bool by_payload) {
+    PairBucketEntry *entries = NULL;
+    size_t entry_count = 0;
+    size_t entry_capacity = 0;
+    bool ok = true;
+    
+    for (size_t i = 0; i < count && ok; i++) {
+        Node *node = nodes[i];
+        if (!node) continue;
+        
+        if (by_neighbor) {
+            for (size_t k = 0; k < node->outgoing_count && ok; k++) {
+                Edge *edge = node->outgoing_edges[k];
+                Node *neighbor = edge ? edge->to_node : NULL;
+                if (!neighbor || neighbor == node) continue;
+                if (context && !visited_set_contains(context, neighbor)) continue;
+                ok = pair_bucket_push(&entries, &entry_count, &entry_capacity,
+                                      pair_bucket_key(PAIR_KEY_NEIGHBOR, (uint64_t)(uintptr_t)neighbor), i);
+            }
+            for (size_t k = 0; k < node->incoming_count && ok; k++) {
+                Edge *edge = node->incoming_edges[k];
+                Node *neighbor = edge ? edge->from_node : NULL;
+                if (!neighbor || neighbor == node) continue;
+                if (context && !visited_set_contains(context, neighbor)) continue;
+                ok = pair_bucket_push(&entries, &entry_count, &entry_capacity,
+                                      pair_bucket_key(PAIR_KEY_NEIGHBOR, (uint64_t)(uintptr_t)neighbor), i);
+            }
+        }
+        
+        if (by_payload) {
+            /* ROPE: Bytes streamed in chunks (no flattening needed for rope nodes) */
+            uint8_t chunk[64];
+            for (size_t start = 0; start < node->payload_size && ok; start += sizeof(chunk)) {
+                size_t n = node_payload_read(node, start, chunk, sizeof(chunk));
+                for (size_t b = 0; b < n && ok; b++) {
+                    uint64_t p = start + b;
+                    ok = pair_bucket_push(&entries, &entry_count, &entry_capacity,
+                                          pair_bucket_key(PAIR_KEY_BYTE, (p << 8) | chunk[b]), i);
+                }
+            }
+        }
+    }
+    
+    /* A node with two edges to the same neighbor lands in that bucket twice - harmless (i == j is skipped) */
+    size_t window = compute_adaptive_sample_limit(count, 2, count);
+    if (ok) ok = pair_candidates_from_buckets(pc, entries, entry_count, window);
+    free(entries);
+    return ok;
 }
 
 /* Create edges between nodes based on recent path context */
@@ -3101,286 +4771,361 @@ void wave_create_edges_from_context(MelvinGraph *g, Node **recently_activated, s
     if (!g || !recently_activated || count < 2) return;
     if (!context_visited) return;
     
-    /* Limit to avoid O(n²) complexity - adaptive limit based on data size */
-    /* Use sqrt(n) for O(√n) complexity - follows README: efficient local operations */
-    /* Sample approximately √n nodes and check pairs only among sampled nodes */
-    size_t sample_size = compute_adaptive_sample_limit(count, 2, count);
-    size_t pair_count = 0;
-    size_t max_pairs = sample_size * (sample_size - 1) / 2;  /* Pairs among sampled nodes */
+    /* CANDIDATE PAIRS: Pairs already joined by an edge (strengthened below) plus pairs on a shared */
+    /* traveled path (a common neighbor inside the context) - generated near-linearly from the whole */
+    /* set, closest kept within the per-call budget (on allocation failure, pairs found so far are used) */
+    PairCandidates candidates = {0};
+    NodeIndexEntry *index = node_index_build(recently_activated, count);
+    if (index) {
+        pair_candidates_from_edges(&candidates, recently_activated, count, index, count);
+        free(index);
+    }
+    pair_candidates_from_signatures(&candidates, recently_activated, count, true, context_visited, false);
+    pair_candidates_finalize(&candidates, pair_candidates_budget(count));
     
-    /* Check pairs of recently activated nodes for context similarity (sampled pairs) */
     /* Context = nodes that wave propagation has explored (paths recently traveled) */
-    for (size_t i = 0; i < count - 1 && i < sample_size; i++) {
-        Node *node1 = recently_activated[i];
-        if (!node1) continue;
-        if (pair_count >= max_pairs) break;  /* Stop when we've checked enough pairs */
-        
-        for (size_t j = i + 1; j < count && j < sample_size; j++) {
-            pair_count++;
-            if (pair_count > max_pairs) break;  /* Stop if we exceed limit */
-            Node *node2 = recently_activated[j];
-            if (!node2 || node1 == node2) continue;
-            
-            /* Check if edges already exist (check both directions for bidirectional edges) */
-            Edge *existing1 = node_find_edge_to(node1, node2);
-            Edge *existing2 = node_find_edge_to(node2, node1);
-            
-            /* If edges exist, strengthen them (compounding learning) */
-            if (existing1 && existing2) {
-                /* Both directions exist - strengthen both */
-                existing1->activation = true;
-                existing2->activation = true;
+    for (size_t p = 0; p < candidates.count; p++) {
+        Node *node1 = recently_activated[candidates.pairs[p * 2]];
+        Node *node2 = recently_activated[candidates.pairs[p * 2 + 1]];
+        if (!node1 || !node2 || node1 == node2) continue;
+        
+        /* Check if edges already exist (check both directions for bidirectional edges) */
+        Edge *existing1 = node_find_edge_to(node1, node2);
+        Edge *existing2 = node_find_edge_to(node2, node1);
+        
+        /* If edges exist, strengthen them (compounding learning) */
+        if (existing1 && existing2) {
+            /* Both directions exist - strengthen both */
+            edge_mark_activated(existing1);
+            edge_mark_activated(existing2);
+            edge_update_weight_local(existing1);
+            edge_update_weight_local(existing2);
+            continue;
+        } else if (existing1 || existing2) {
+            /* One direction exists - strengthen it, but we still need to create the other */
+            /* This handles asymmetric edge cases */
+            if (existing1) {
+                edge_mark_activated(existing1);
                 edge_update_weight_local(existing1);
-                edge_update_weight_local(existing2);
-                continue;
-            } else if (existing1 || existing2) {
-                /* One direction exists - strengthen it, but we still need to create the other */
-                /* This handles asymmetric edge cases */
-                if (existing1) {
-                    existing1->activation = true;
-                    edge_update_weight_local(existing1);
-                }
-                if (existing2) {
-                    existing2->activation = true;
-                    edge_update_weight_local(existing2);
-                }
-                /* Continue to create missing direction if context threshold is met */
             }
-            
-            /* Compute context similarity based on wave propagation exploration */
-            /* Context = nodes visited by wave propagation (paths recently traveled) */
-            float context_similarity = edge_compute_context_similarity(node1, node2, context_visited);
-            
-            /* UNIVERSAL: Threshold relative to local context (no hardcoded values) */
-            float local_avg1 = (node_get_local_outgoing_weight_avg(node1) + 
-                               node_get_local_incoming_weight_avg(node1)) / 2.0f;
-            float local_avg2 = (node_get_local_outgoing_weight_avg(node2) + 
-                               node_get_local_incoming_weight_avg(node2)) / 2.0f;
-            float avg_local = (local_avg1 + local_avg2) / 2.0f;
-            
-            /* Relative threshold: context similarity must be meaningful relative to local context */
-            /* Adaptive threshold based on local edge weight distribution */
-            float context_threshold = (avg_local > 0.0f) ? avg_local / (avg_local + 1.0f) : 0.0f;
-            
-            if (context_similarity >= context_threshold) {
-                /* Create bidirectional edge based on context (only if doesn't already exist) */
-                Edge *edge1 = NULL;
-                Edge *edge2 = NULL;
-                
-                if (!existing1) {
-                    edge1 = edge_create(node1, node2, true);
-                }
-                if (!existing2) {
-                    edge2 = edge_create(node2, node1, true);
-                }
-                
-                if (edge1 && edge2) {
-                    /* RELATIVE: Initial weight relative to local context (no hardcoded multiplier) */
-                    float initial_weight1 = compute_relative_initial_edge_weight(node1, context_similarity);
-                    float initial_weight2 = compute_relative_initial_edge_weight(node2, context_similarity);
-                    edge1->weight = initial_weight1;
-                    edge2->weight = initial_weight2;
-                    edge1->activation = true;
-                    edge2->activation = true;
-                    
-                    graph_add_edge(g, edge1, node1, node2);
-                    graph_add_edge(g, edge2, node2, node1);
-                } else if (edge1) {
-                    /* Only edge1 needs to be created */
-                    float initial_weight1 = compute_relative_initial_edge_weight(node1, context_similarity);
-                    edge1->weight = initial_weight1;
-                    edge1->activation = true;
-                    graph_add_edge(g, edge1, node1, node2);
-                } else if (edge2) {
-                    /* Only edge2 needs to be created */
-                    float initial_weight2 = compute_relative_initial_edge_weight(node2, context_similarity);
-                    edge2->weight = initial_weight2;
-                    edge2->activation = true;
-                    graph_add_edge(g, edge2, node2, node1);
-                } else {
-                    /* Both already exist - should have been handled above, but free if somehow created */
-                    if (edge1) edge_free(edge1);
-                    if (edge2) edge_free(edge2);
-                }
+            if (existing2) {
+                edge_mark_activated(existing2);
+                edge_update_weight_local(existing2);
             }
+            /* Continue to create missing direction if context threshold is met */
+        }
+        
+        /* Compute context similarity based on wave propagation exploration */
+        /* Context = nodes visited by wave propagation (paths recently traveled) */
+        float context_similarity = edge_compute_context_similarity(node1, node2, context_visited);
+        
+        /* UNIVERSAL: Threshold relative to local context (no hardcoded values) */
+        float local_avg1 = (node_get_local_outgoing_weight_avg(node1) + 
+                           node_get_local_incoming_weight_avg(node1)) / 2.0f;
+        float local_avg2 = (node_get_local_outgoing_weight_avg(node2) + 
+                           node_get_local_incoming_weight_avg(node2)) / 2.0f;
+        float avg_local = (local_avg1 + local_avg2) / 2.0f;
+        
+        /* Relative threshold: context similarity must be meaningful relative to local context */
+        /* Adaptive threshold based on local edge weight distribution */
+        float context_threshold = (avg_local > 0.0f) ? avg_local / (avg_local + 1.0f) : 0.0f;
+        
+        /* Create the missing directions (GROWTH BUDGET: proposed instead while capped) */
+        if (context_similarity >= context_threshold &&
+            !growth_propose(g, GROWTH_PAIR_EDGES, node1, node2, context_similarity, false,
+                            growth_margin(context_similarity, context_threshold))) {
+            pair_edges_commit(g, node1, node2, context_similarity);
         }
     }
+    
+    pair_candidates_free(&candidates);
 }
 
 /* ========================================
  * UNIVERSAL LAWS: Generalization & Combination
  * ======================================== */
 
-/* UNIVERSAL LAW: Pattern Generalization (Abstraction) */
-/* When multiple nodes share similar patterns, create a generalization node */
-/* Generalization node connects to all similar patterns - represents common abstraction */
-/* All nodes can generalize - no special category nodes */
-void wave_form_universal_generalizations(MelvinGraph *g, Node **co_activated, size_t count) {
-    if (!g || !co_activated || count < 2) return;
+/* CANONICAL: Map from a node pair to the one node built from it - generalizations are keyed */
+/* by their unordered member pair, combinations by their ordered (left, right) part pair. */
+/* Open addressing (linear probing) on the pair pointers; nodes are never removed from a */
+/* graph before graph_free, so stored pointers stay valid for the map's lifetime */
+typedef struct NodePairEntry {
+    Node *first;
+    Node *second;
+    Node *value;  /* NULL = empty slot */
+} NodePairEntry;
+
+struct NodePairMap {
+    NodePairEntry *entries;
+    size_t capacity;  /* Power of two */
+    size_t count;
+};
+
+static size_t node_pair_slot(const NodePairMap *map, Node *first, Node *second) {
+    /* Asymmetric mix: (a, b) and (b, a) are different keys (order matters for combinations) */
+    uint64_t x = (uint64_t)(uintptr_t)first * 0x9E3779B97F4A7C15ULL ^ (uint64_t)(uintptr_t)second;
+    return (size_t)splitmix64_next(&x) & (map->capacity - 1);
+}
+
+/* Node registered for (first, second), or NULL (O(1) average) */
+static Node* node_pair_map_find(const NodePairMap *map, Node *first, Node *second) {
+    if (!map || map->count == 0) return NULL;
     
-    /* Limit to avoid O(n²) complexity - adaptive limit based on data size */
-    /* Use sqrt(n) for O(√n) complexity - follows README: efficient local operations */
-    /* Sample approximately √n nodes and check pairs only among sampled nodes */
-    size_t sample_size = compute_adaptive_sample_limit(count, 2, count);
-    size_t pair_count = 0;
-    size_t max_pairs = sample_size * (sample_size - 1) / 2;  /* Pairs among sampled nodes */
-    
-    /* Find groups of similar nodes (sampled pairs, not all combinations) */
-    for (size_t i = 0; i < count - 1 && i < sample_size; i++) {
-        if (pair_count >= max_pairs) break;  /* Stop when we've checked enough pairs */
-        for (size_t j = i + 1; j < count && j < sample_size; j++) {
-            pair_count++;
-            if (pair_count > max_pairs) break;  /* Stop if we exceed limit */
-            Node *node1 = co_activated[i];
-            Node *node2 = co_activated[j];
-            
-            if (!node1 || !node2 || node1->payload_size == 0 || node2->payload_size == 0) continue;
-            
-            /* Compute similarity */
-            float similarity = edge_compute_pattern_similarity(node1, node2);
-            
-            /* UNIVERSAL: Similarity threshold relative to local context */
-            float local_avg1 = (node_get_local_outgoing_weight_avg(node1) + 
-                               node_get_local_incoming_weight_avg(node1)) / 2.0f;
-            float local_avg2 = (node_get_local_outgoing_weight_avg(node2) + 
-                               node_get_local_incoming_weight_avg(node2)) / 2.0f;
-            float avg_context = (local_avg1 + local_avg2) / 2.0f;
-            
-            /* Relative similarity range - similar but not identical */
-            float min_similarity = avg_context;
-            float max_similarity = (avg_context + 1.0f) / 2.0f;
-            
-            /* Similar but not identical - generalization candidate */
-            if ((min_similarity == 0.0f || similarity >= min_similarity) && 
-                (max_similarity == 1.0f || similarity <= max_similarity)) {
-                
-                /* LOCAL OPERATION: Check if generalization node already exists through local connections */
-                /* Check through node1's and node2's edges (no graph scan) - follows README: local operations only */
-                /* A generalization node that connects to both node1 and node2 would be found via their edges */
-                bool generalization_exists = false;
-                
-                /* Check node1's connections for blank nodes that also connect to node2 */
-                for (size_t k = 0; k < node1->outgoing_count && !generalization_exists; k++) {
-                    Edge *edge1 = node1->outgoing_edges[k];
-                    if (!edge1 || !edge1->to_node) continue;
-                    Node *candidate = edge1->to_node;
-                    
-                    /* Check if candidate is a blank node (generalization nodes are blank) */
-                    if (candidate->payload_size == 0) {
-                        /* Check if this blank also connects to node2 (local check through node2's edges) */
-                        if (node_find_edge_to(node2, candidate) || node_find_edge_to(candidate, node2)) {
-                            generalization_exists = true;
-                            break;
-                        }
-                    }
-                }
-                
-                /* Also check node1's incoming edges (bidirectional connections) */
-                if (!generalization_exists) {
-                    for (size_t k = 0; k < node1->incoming_count; k++) {
-                        Edge *edge1 = node1->incoming_edges[k];
-                        if (!edge1 || !edge1->from_node) continue;
-                        Node *candidate = edge1->from_node;
-                        
-                        /* Check if candidate is a blank node (generalization nodes are blank) */
-                        if (candidate->payload_size == 0) {
-                            /* Check if this blank also connects to node2 (local check through node2's edges) */
-                            if (node_find_edge_to(node2, candidate) || node_find_edge_to(candidate, node2)) {
-                                generalization_exists = true;
-                                break;
-                            }
-                        }
-                    }
-                }
-                
-                /* UNIVERSAL: Create generalization node (blank node = abstract pattern) */
-                if (!generalization_exists) {
-                    Node *generalization = node_create_blank();  /* No payload = abstract representation */
-                    if (generalization && graph_add_node(g, generalization)) {
-                        /* Connect to both similar nodes */
-                        /* LEARN FROM EXISTING: Check if edges already exist before creating */
-                        Edge *e1_existing = node_find_edge_to(node1, generalization);
-                        Edge *e2_existing = node_find_edge_to(generalization, node1);
-                        Edge *e3_existing = node_find_edge_to(node2, generalization);
-                        Edge *e4_existing = node_find_edge_to(generalization, node2);
-                        
-                        Edge *e1 = NULL, *e2 = NULL, *e3 = NULL, *e4 = NULL;
-                        if (!e1_existing) e1 = edge_create(node1, generalization, true);
-                        if (!e2_existing) e2 = edge_create(generalization, node1, true);
-                        if (!e3_existing) e3 = edge_create(node2, generalization, true);
-                        if (!e4_existing) e4 = edge_create(generalization, node2, true);
-                        
-                        if (e1 && e2 && e3 && e4) {
-                            /* All new - create all */
-                            float gen_weight1 = compute_relative_initial_edge_weight(node1, similarity);
-                            float gen_weight2 = compute_relative_initial_edge_weight(generalization, similarity);
-                            float gen_weight3 = compute_relative_initial_edge_weight(node2, similarity);
-                            float gen_weight4 = compute_relative_initial_edge_weight(generalization, similarity);
-                            e1->weight = gen_weight1;
-                            e2->weight = gen_weight2;
-                            e3->weight = gen_weight3;
-                            e4->weight = gen_weight4;
-                            e1->activation = true;
-                            e2->activation = true;
-                            e3->activation = true;
-                            e4->activation = true;
-                            graph_add_edge(g, e1, node1, generalization);
-                            graph_add_edge(g, e2, generalization, node1);
-                            graph_add_edge(g, e3, node2, generalization);
-                            graph_add_edge(g, e4, generalization, node2);
-                        } else {
-                            /* Some exist, create missing ones and strengthen existing */
-                            if (e1) {
-                                e1->weight = compute_relative_initial_edge_weight(node1, similarity);
-                                e1->activation = true;
-                                graph_add_edge(g, e1, node1, generalization);
-                            }
-                            if (e2) {
-                                e2->weight = compute_relative_initial_edge_weight(generalization, similarity);
-                                e2->activation = true;
-                                graph_add_edge(g, e2, generalization, node1);
-                            }
-                            if (e3) {
-                                e3->weight = compute_relative_initial_edge_weight(node2, similarity);
-                                e3->activation = true;
-                                graph_add_edge(g, e3, node2, generalization);
-                            }
-                            if (e4) {
-                                e4->weight = compute_relative_initial_edge_weight(generalization, similarity);
-                                e4->activation = true;
-                                graph_add_edge(g, e4, generalization, node2);
-                            }
-                            
-                            /* Strengthen existing edges */
-                            if (e1_existing) {
-                                e1_existing->activation = true;
-                                edge_update_weight_local(e1_existing);
-                            }
-                            if (e2_existing) {
-                                e2_existing->activation = true;
-                                edge_update_weight_local(e2_existing);
-                            }
-                            if (e3_existing) {
-                                e3_existing->activation = true;
-                                edge_update_weight_local(e3_existing);
-                            }
-                            if (e4_existing) {
-                                e4_existing->activation = true;
-                                edge_update_weight_local(e4_existing);
-                            }
-                            
-                            /* Free any unused edges */
-                            if (!e1 && !e2 && !e3 && !e4) {
-                                if (generalization) {
-                                    node_free(generalization);
-                                }
-                            }
-                        }
-                    }
-                }
+    size_t mask = map->capacity - 1;
+    for (size_t slot = node_pair_slot(map, first, second); ; slot = (slot + 1) & mask) {
+        const NodePairEntry *e = &map->entries[slot];
+        if (!e->value) return NULL;
+        if (e->first == first && e->second == second) return e->value;
+    }
+}
+
+/* Place an entry known to be absent (callers check first; capacity already has room) */
+static void node_pair_map_insert_slot(NodePairMap *map, Node *first, Node *second, Node *value) {
+    size_t mask = map->capacity - 1;
+    size_t slot = node_pair_slot(map, first, second);
+    while (map->entries[slot].value) slot = (slot + 1) & mask;
+    map->entries[slot].first = first;
+    map->entries[slot].second = second;
+    map->entries[slot].value = value;
+    map->count++;
+}
+
+/* Register value for (first, second); an existing entry is kept (first registration is canonical) */
+static bool node_pair_map_add(NodePairMap **map_ptr, Node *first, Node *second, Node *value) {
+    if (!map_ptr || !value) return false;
+    
+    if (!*map_ptr) {
+        *map_ptr = (NodePairMap*)calloc(1, sizeof(NodePairMap));
+        if (!*map_ptr) return false;
+    }
+    NodePairMap *map = *map_ptr;
+    if (node_pair_map_find(map, first, second)) return true;
+    
+    /* Grow at half load (Minimal context: start small, double on demand) */
+    if ((map->count + 1) * 2 > map->capacity) {
+        size_t new_capacity = (map->capacity == 0) ? 2 : map->capacity * 2;
+        NodePairEntry *new_entries = (NodePairEntry*)calloc(new_capacity, sizeof(NodePairEntry));
+        if (!new_entries) return false;
+        NodePairEntry *old_entries = map->entries;
+        size_t old_capacity = map->capacity;
+        map->entries = new_entries;
+        map->capacity = new_capacity;
+        map->count = 0;
+        for (size_t i = 0; i < old_capacity; i++) {
+            if (old_entries[i].value) {
+                node_pair_map_insert_slot(map, old_entries[i].first, old_entries[i].second, old_entries[i].value);
+            }
+        }
+        free(old_entries);
+    }
+    
+    node_pair_map_insert_slot(map, first, second, value);
+    return true;
+}
+
+static void node_pair_map_free(NodePairMap **map_ptr) {
+    if (!map_ptr || !*map_ptr) return;
+    free((*map_ptr)->entries);
+    free(*map_ptr);
+    *map_ptr = NULL;
+}
+
+/* Generalizations: members ordered by address, so (a, b) and (b, a) share one key */
+static Node* generalization_registry_find(const MelvinGraph *g, Node *a, Node *b) {
+    return ((uintptr_t)a <= (uintptr_t)b) ? node_pair_map_find(g->generalizations, a, b)
+                                          : node_pair_map_find(g->generalizations, b, a);
+}
+
+static bool generalization_registry_add(MelvinGraph *g, Node *a, Node *b, Node *generalization) {
+    return ((uintptr_t)a <= (uintptr_t)b) ? node_pair_map_add(&g->generalizations, a, b, generalization)
+                                          : node_pair_map_add(&g->generalizations, b, a, generalization);
+}
+
+/* CANONICAL: Combined node built from (left, right), or NULL - O(1) registry lookup */
+/* Combinations register themselves when added to the graph (graph_add_node), including on .m load. */
+/* Only a graph loaded from an older .m (combined nodes without recorded parts) falls back on a */
+/* miss to the local check through left's outgoing edges; a hit there is registered */
+static Node* combination_find_existing(MelvinGraph *g, Node *left, Node *right) {
+    Node *combined = node_pair_map_find(g->combinations, left, right);
+    if (combined || !g->combinations_unrecorded) return combined;
+    
+    size_t expected_size = left->payload_size + right->payload_size;
+    if (expected_size == 0) return NULL;
+    for (size_t k = 0; k < left->outgoing_count; k++) {
+        Edge *edge = left->outgoing_edges[k];
+        if (!edge || !edge->to_node) continue;
+        Node *candidate = edge->to_node;
+        if (candidate->payload_size == expected_size && node_payload_is_combination(candidate, left, right)) {
+            node_pair_map_add(&g->combinations, left, right, candidate);
+            return candidate;
+        }
+    }
+    return NULL;
+}
+
+/* CANONICAL: Rebuild the generalization registry of a loaded graph (one pass over node edges) */
+/* A generalization is a blank node whose edges reach exactly two payload nodes - the pair it was */
+/* created for. Run once after .m load, so the law only ever consults the registry */
+void graph_register_generalizations(MelvinGraph *g) {
+    if (!g) return;
+    for (size_t i = 0; i < g->node_count; i++) {
+        Node *blank = g->nodes[i];
+        if (!blank || blank->payload_size != 0) continue;
+        
+        Node *members[2] = {NULL, NULL};
+        size_t member_count = 0;
+        bool is_pair = true;
+        size_t degree = blank->outgoing_count + blank->incoming_count;
+        for (size_t k = 0; k < degree && is_pair; k++) {
+            bool outgoing = (k < blank->outgoing_count);
+            Edge *edge = outgoing ? blank->outgoing_edges[k] : blank->incoming_edges[k - blank->outgoing_count];
+            if (!edge) continue;
+            Node *other = outgoing ? edge->to_node : edge->from_node;
+            if (!other || other == members[0] || other == members[1]) continue;
+            if (other->payload_size == 0 || member_count == 2) {
+                is_pair = false;  /* Reaches a blank or a third node - not a pair generalization */
+            } else {
+                members[member_count++] = other;
+            }
+        }
+        if (is_pair && member_count == 2) {
+            generalization_registry_add(g, members[0], members[1], blank);
+        }
+    }
+}
+
+/* UNIVERSAL: Create the generalization node (blank node = abstract pattern) for a member pair */
+static void generalization_commit(MelvinGraph *g, Node *node1, Node *node2, float similarity) {
+    /* CANONICAL: Re-checked - an earlier commit of this input may have built it */
+    if (generalization_registry_find(g, node1, node2) || !growth_admit_node(g, true)) return;
+    
+    Node *generalization = node_create_blank();  /* No payload = abstract representation */
+    
+    /* Connect to both similar nodes */
+    /* A new node has no edges to learn from yet - all four are created before the graph */
+    /* owns it, so a failed allocation frees an unattached node instead of leaving a */
+    /* registered one behind */
+    Edge *e1 = generalization ? edge_create(node1, generalization, true) : NULL;
+    Edge *e2 = generalization ? edge_create(generalization, node1, true) : NULL;
+    Edge *e3 = generalization ? edge_create(node2, generalization, true) : NULL;
+    Edge *e4 = generalization ? edge_create(generalization, node2, true) : NULL;
+    
+    if (e1 && e2 && e3 && e4 && graph_add_node(g, generalization)) {
+        /* CANONICAL: Registered only once it is in the graph with its edges */
+        generalization_registry_add(g, node1, node2, generalization);
+        growth_note_edges(g, 4);
+        
+        e1->weight = compute_relative_initial_edge_weight(node1, similarity);
+        e2->weight = compute_relative_initial_edge_weight(generalization, similarity);
+        e3->weight = compute_relative_initial_edge_weight(node2, similarity);
+        e4->weight = compute_relative_initial_edge_weight(generalization, similarity);
+        edge_mark_activated(e1);
+        edge_mark_activated(e2);
+        edge_mark_activated(e3);
+        edge_mark_activated(e4);
+        graph_add_edge(g, e1, node1, generalization);
+        graph_add_edge(g, e2, generalization, node1);
+        graph_add_edge(g, e3, node2, generalization);
+        graph_add_edge(g, e4, generalization, node2);
+    } else {
+        edge_free(e1);
+        edge_free(e2);
+        edge_free(e3);
+        edge_free(e4);
+        node_free(generalization);
+    }
+}
+
+/* UNIVERSAL LAW: Pattern Generalization (Abstraction) */
+/* When multiple nodes share similar patterns, create a generalization node */
+/* Generalization node connects to all similar patterns - represents common abstraction */
+/* All nodes can generalize - no special category nodes */
+void wave_form_universal_generalizations(MelvinGraph *g, Node **co_activated, size_t count) {
+    if (!g || !co_activated || count < 2) return;
+    
+    /* CANDIDATE PAIRS: Pairs with payload bytes at the same position (direct match) or a shared */
+    /* neighbor (connection match) - where similarity concentrates. Other pairs can still score */
+    /* through their neighbors' bytes but are not generated; the closest candidates are kept */
+    /* within the per-call budget */
+    PairCandidates candidates = {0};
+    pair_candidates_from_signatures(&candidates, co_activated, count, true, NULL, true);
+    pair_candidates_finalize(&candidates, pair_candidates_budget(count));
+    
+    /* PARALLEL EDGE FORMATION: Pair similarities scored on the pool, committed in pair order */
+    EdgeScoreBatch batch;
+    if (edge_score_batch_init(&batch, candidates.count)) {
+        for (size_t p = 0; p < batch.count; p++) {
+            Node *node1 = co_activated[candidates.pairs[p * 2]];
+            Node *node2 = co_activated[candidates.pairs[p * 2 + 1]];
+            if (!node1 || !node2 || node1 == node2 || node1->payload_size == 0 || node2->payload_size == 0) continue;
+            batch.entries[p].node = node1;
+            batch.entries[p].partner = node2;
+        }
+        edge_score_batch_precompute(&batch, edge_score_pattern);
+    }
+    
+    /* Find groups of similar nodes */
+    for (size_t p = 0; p < candidates.count; p++) {
+        Node *node1 = co_activated[candidates.pairs[p * 2]];
+        Node *node2 = co_activated[candidates.pairs[p * 2 + 1]];
+        
+        if (!node1 || !node2 || node1 == node2 || node1->payload_size == 0 || node2->payload_size == 0) continue;
+        
+        /* Compute similarity (precomputed unless an earlier commit changed either member) */
+        float similarity = (edge_score_batch_is_stale(&batch, node1) || edge_score_batch_is_stale(&batch, node2)) ?
+                           edge_compute_pattern_similarity(node1, node2) : batch.entries[p].score;
+        
+        /* UNIVERSAL: Similarity threshold relative to local context */
+        float local_avg1 = (node_get_local_outgoing_weight_avg(node1) + 
+                           node_get_local_incoming_weight_avg(node1)) / 2.0f;
+        float local_avg2 = (node_get_local_outgoing_weight_avg(node2) + 
+                           node_get_local_incoming_weight_avg(node2)) / 2.0f;
+        float avg_context = (local_avg1 + local_avg2) / 2.0f;
+        
+        /* Relative similarity range - similar but not identical */
+        float min_similarity = avg_context;
+        float max_similarity = (avg_context + 1.0f) / 2.0f;
+        
+        /* Similar but not identical - generalization candidate */
+        if ((min_similarity == 0.0f || similarity >= min_similarity) && 
+            (max_similarity == 1.0f || similarity <= max_similarity)) {
+            
+            /* CANONICAL: One generalization per member pair - registry lookup instead of edge scans */
+            /* (loaded generalizations are registered by graph_register_generalizations) */
+            bool generalization_exists = (generalization_registry_find(g, node1, node2) != NULL);
+            
+            /* GROWTH BUDGET: Proposed while capped, ranked by how far it clears the lower bound */
+            if (!generalization_exists &&
+                !growth_propose(g, GROWTH_GENERALIZATION, node1, node2, similarity, false,
+                                growth_margin(similarity, min_similarity))) {
+                /* Both members gain edges - later scores that read them are recomputed */
+                edge_score_batch_touch(&batch, node1);
+                edge_score_batch_touch(&batch, node2);
+                generalization_commit(g, node1, node2, similarity);
             }
         }
     }
+    
+    edge_score_batch_free(&batch);
+    pair_candidates_free(&candidates);
+}
+
+/* UNIVERSAL: Combine two parts into a larger node (hierarchy) that inherits their edges */
+/* activate = compute its activation right away (combination law; co-activation leaves it) */
+static void combination_commit(MelvinGraph *g, Node *node1, Node *node2, bool activate) {
+    /* CANONICAL: Re-checked - an earlier commit of this input may have built it */
+    if (combination_find_existing(g, node1, node2) || !growth_admit_node(g, false)) return;
+    
+    Node *combined = node_combine_payloads(node1, node2);
+    if (combined && graph_add_node(g, combined)) {
+        /* Transfer edges (preserve connectivity) */
+        node_transfer_incoming_to_hierarchy(g, node1, node2, combined);
+        
+        /* UNIVERSAL: Combined node uses universal activation (mini neural net) */
+        if (activate) node_set_activation_strength(combined, node_compute_activation_strength(combined));
+    } else {
+        if (combined) node_free(combined);
+    }
 }
 
 /* UNIVERSAL LAW: Pattern Combination (Hierarchy) */
@@ -3390,99 +5135,101 @@ void wave_form_universal_generalizations(MelvinGraph *g, Node **co_activated, si
 void wave_form_universal_combinations(MelvinGraph *g, Node **co_activated, size_t count) {
     if (!g || !co_activated || count < 2) return;
     
-    /* Limit to avoid O(n²) complexity - adaptive limit based on data size */
-    /* Use sqrt(n) for O(√n) complexity - follows README: efficient local operations */
-    /* Sample approximately √n nodes and check pairs only among sampled nodes */
-    size_t sample_size = compute_adaptive_sample_limit(count, 2, count);
-    size_t pair_count = 0;
-    size_t max_pairs = sample_size * (sample_size - 1) / 2;  /* Pairs among sampled nodes */
-    
-    /* Check pairs of co-activated nodes (sampled pairs, not all combinations) */
-    for (size_t i = 0; i < count - 1 && i < sample_size; i++) {
-        if (pair_count >= max_pairs) break;  /* Stop when we've checked enough pairs */
-        for (size_t j = i + 1; j < count && j < sample_size; j++) {
-            pair_count++;
-            if (pair_count > max_pairs) break;  /* Stop if we exceed limit */
-            Node *node1 = co_activated[i];
-            Node *node2 = co_activated[j];
+    /* CANDIDATE PAIRS: Only pairs joined by an edge can combine - generate exactly those from the */
+    /* members' edge lists (O(sum of degrees)) instead of testing sampled pairs for an edge, */
+    /* closest kept within the per-call budget */
+    PairCandidates candidates = {0};
+    NodeIndexEntry *index = node_index_build(co_activated, count);
+    if (!index) return;
+    pair_candidates_from_edges(&candidates, co_activated, count, index, count);
+    free(index);
+    pair_candidates_finalize(&candidates, pair_candidates_budget(count));
+    
+    /* Check pairs of co-activated nodes */
+    for (size_t p = 0; p < candidates.count; p++) {
+        Node *node1 = co_activated[candidates.pairs[p * 2]];
+        Node *node2 = co_activated[candidates.pairs[p * 2 + 1]];
+        
+        if (!node1 || !node2 || node1 == node2) continue;
+        
+        /* Check if they have a strong connecting edge (co-activation) */
+        Edge *connecting = node_find_edge_to(node1, node2);
+        if (!connecting) {
+            /* Also check reverse direction */
+            connecting = node_find_edge_to(node2, node1);
+        }
+        
+        if (connecting) {
+            /* UNIVERSAL: Threshold relative to local context */
+            float local_avg1 = (node_get_local_outgoing_weight_avg(node1) + 
+                               node_get_local_incoming_weight_avg(node1)) / 2.0f;
+            float local_avg2 = (node_get_local_outgoing_weight_avg(node2) + 
+                               node_get_local_incoming_weight_avg(node2)) / 2.0f;
+            float avg_local = (local_avg1 + local_avg2) / 2.0f;
             
-            if (!node1 || !node2) continue;
+            /* NO HARDCODED THRESHOLD: Use minimal context when no local data exists */
+            /* When avg_local = 0.0, use node's own properties as minimal context */
+            float comparison_value = avg_local;
+            if (comparison_value <= 0.0f) {
+                /* Minimal context: use node weights as baseline (data-driven, not threshold) */
+                float node_weight_avg = (node1->weight + node2->weight) / 2.0f;
+                if (node_weight_avg > 0.0f) {
+                    comparison_value = node_weight_avg;
+                } else {
+                    /* Still no context: use presence of edge (edge exists = positive signal) */
+                    /* Allow combination when edge exists and has any positive weight (bootstrap) */
+                    comparison_value = 0.0f;  /* Will check: connecting->weight > 0.0f */
+                }
+            }
             
-            /* Check if they have a strong connecting edge (co-activation) */
-            Edge *connecting = node_find_edge_to(node1, node2);
-            if (!connecting) {
-                /* Also check reverse direction */
-                connecting = node_find_edge_to(node2, node1);
+            /* UNIVERSAL: If edge is strong relative to available context, combine */
+            /* Relative comparison - no hardcoded threshold, uses minimal context when needed */
+            bool should_combine = false;
+            float connecting_weight = edge_get_decayed_weight(connecting);  /* LAZY DECAY: Settled weight */
+            if (comparison_value > 0.0f) {
+                should_combine = (connecting_weight >= comparison_value);
+            } else {
+                /* No context available: bootstrap with any positive edge weight */
+                should_combine = (connecting_weight > 0.0f);
             }
             
-            if (connecting) {
-                /* UNIVERSAL: Threshold relative to local context */
-                float local_avg1 = (node_get_local_outgoing_weight_avg(node1) + 
-                                   node_get_local_incoming_weight_avg(node1)) / 2.0f;
-                float local_avg2 = (node_get_local_outgoing_weight_avg(node2) + 
-                                   node_get_local_incoming_weight_avg(node2)) / 2.0f;
-                float avg_local = (local_avg1 + local_avg2) / 2.0f;
-                
-                /* NO HARDCODED THRESHOLD: Use minimal context when no local data exists */
-                /* When avg_local = 0.0, use node's own properties as minimal context */
-                float comparison_value = avg_local;
-                if (comparison_value <= 0.0f) {
-                    /* Minimal context: use node weights as baseline (data-driven, not threshold) */
-                    float node_weight_avg = (node1->weight + node2->weight) / 2.0f;
-                    if (node_weight_avg > 0.0f) {
-                        comparison_value = node_weight_avg;
-                    } else {
-                        /* Still no context: use presence of edge (edge exists = positive signal) */
-                        /* Allow combination when edge exists and has any positive weight (bootstrap) */
-                        comparison_value = 0.0f;  /* Will check: connecting->weight > 0.0f */
-                    }
-                }
-                
-                /* UNIVERSAL: If edge is strong relative to available context, combine */
-                /* Relative comparison - no hardcoded threshold, uses minimal context when needed */
-                bool should_combine = false;
-                if (comparison_value > 0.0f) {
-                    should_combine = (connecting->weight >= comparison_value);
-                } else {
-                    /* No context available: bootstrap with any positive edge weight */
-                    should_combine = (connecting->weight > 0.0f);
-                }
+            if (should_combine) {
+                /* Check if combined node already exists (CANONICAL: one per ordered part pair) */
+                bool combination_exists = (combination_find_existing(g, node1, node2) != NULL);
                 
-                if (should_combine) {
-                    /* Check if combined node already exists */
-                    size_t expected_size = node1->payload_size + node2->payload_size;
-                    bool combination_exists = false;
-                    
-                    for (size_t k = 0; k < node1->outgoing_count; k++) {
-                        Edge *e = node1->outgoing_edges[k];
-                        if (!e || !e->to_node) continue;
-                        Node *candidate = e->to_node;
-                        if (candidate->payload_size == expected_size) {
-                            if (memcmp(candidate->payload, node1->payload, node1->payload_size) == 0 &&
-                                memcmp(candidate->payload + node1->payload_size, node2->payload, node2->payload_size) == 0) {
-                                combination_exists = true;
-                                break;
-                            }
-                        }
-                    }
-                    
-                    /* UNIVERSAL: Combine into larger node (hierarchy) */
-                    if (!combination_exists) {
-                        Node *combined = node_combine_payloads(node1, node2);
-                        if (combined && graph_add_node(g, combined)) {
-                            /* Transfer edges (preserve connectivity) */
-                            node_transfer_incoming_to_hierarchy(g, node1, node2, combined);
-                            
-                            /* UNIVERSAL: Combined node uses universal activation (mini neural net) */
-                            combined->activation_strength = node_compute_activation_strength(combined);
-                        } else {
-                            if (combined) node_free(combined);
-                        }
-                    }
+                /* UNIVERSAL: Combine into larger node (hierarchy) - proposed while capped */
+                if (!combination_exists &&
+                    !growth_propose(g, GROWTH_COMBINATION, node1, node2, 0.0f, true,
+                                    growth_margin(connecting_weight, comparison_value))) {
+                    combination_commit(g, node1, node2, true);
                 }
             }
         }
     }
+    
+    pair_candidates_free(&candidates);
+}
+
+/* Create one weak edge from an isolated node to a well-connected one (true = created) */
+static bool homeostatic_edge_commit(MelvinGraph *g, Node *isolated_node, Node *well_connected) {
+    if (node_find_edge_to(isolated_node, well_connected) || !growth_admit_edge(g)) return false;
+    
+    Edge *homeostatic_edge = edge_create(isolated_node, well_connected, true);
+    if (!homeostatic_edge) return false;
+    
+    /* RELATIVE: Very weak initial weight relative to local context (no hardcoded value) */
+    /* Homeostatic edges should be weak - compute relative to local avg, then scale down */
+    float local_avg = node_get_local_outgoing_weight_avg(isolated_node);
+    if (local_avg > 0.0f) {
+        /* Use a very small fraction of local average for weak connection */
+        homeostatic_edge->weight = local_avg / (local_avg + 100.0f);  /* Very weak relative to context */
+    } else {
+        /* No local context: use minimal bootstrap relative to node weight */
+        float node_weight = (isolated_node->weight > 0.0f) ? isolated_node->weight : 1.0f;
+        homeostatic_edge->weight = node_weight / (node_weight + 100.0f);  /* Very weak */
+    }
+    graph_add_edge(g, homeostatic_edge, isolated_node, well_connected);
+    return true;
 }
 
 /* Create edges to prevent node isolation */
@@ -3519,21 +5266,12 @@ void wave_create_homeostatic_edges(MelvinGraph *g, Node *isolated_node) {
                 size_t well_connected_total = well_connected->outgoing_count + well_connected->incoming_count;
                 
                 /* Connect to well-connected nodes (relative adaptive stability) */
+                /* GROWTH BUDGET: Proposed while capped (a proposal counts as a connection) */
                 if (well_connected_total > well_connected_threshold && !node_find_edge_to(isolated_node, well_connected)) {
-                    Edge *homeostatic_edge = edge_create(isolated_node, well_connected, true);
-                    if (homeostatic_edge) {
-                        /* RELATIVE: Very weak initial weight relative to local context (no hardcoded value) */
-                        /* Homeostatic edges should be weak - compute relative to local avg, then scale down */
-                        float local_avg = node_get_local_outgoing_weight_avg(isolated_node);
-                        if (local_avg > 0.0f) {
-                            /* Use a very small fraction of local average for weak connection */
-                            homeostatic_edge->weight = local_avg / (local_avg + 100.0f);  /* Very weak relative to context */
-                        } else {
-                            /* No local context: use minimal bootstrap relative to node weight */
-                            float node_weight = (isolated_node->weight > 0.0f) ? isolated_node->weight : 1.0f;
-                            homeostatic_edge->weight = node_weight / (node_weight + 100.0f);  /* Very weak */
-                        }
-                        graph_add_edge(g, homeostatic_edge, isolated_node, well_connected);
+                    if (growth_propose(g, GROWTH_HOMEOSTATIC, isolated_node, well_connected, 0.0f, false,
+                                       growth_margin((float)well_connected_total, well_connected_threshold))) {
+                        connections_created++;
+                    } else if (homeostatic_edge_commit(g, isolated_node, well_connected)) {
                         connections_created++;
                     }
                 }
@@ -3564,6 +5302,17 @@ void wave_form_intelligent_edges(MelvinGraph *g, Node **activated_nodes, size_t
     /* Create edges for each newly activated node if similar patterns exist */
     /* Limit to avoid O(n²) complexity - adaptive limit based on data size */
     size_t similarity_check_limit = compute_adaptive_sample_limit(activated_count, 1, activated_count);
+    
+    /* PARALLEL EDGE FORMATION: Best neighbors scored on the pool, edges committed in node order */
+    EdgeScoreBatch batch;
+    if (edge_score_batch_init(&batch, similarity_check_limit)) {
+        for (size_t i = 0; i < batch.count; i++) {
+            Node *node = activated_nodes[i];
+            if (node && node->payload_size > 0) batch.entries[i].node = node;
+        }
+        edge_score_batch_precompute(&batch, edge_score_similarity);
+    }
+    
     for (size_t i = 0; i < similarity_check_limit; i++) {
         Node *node = activated_nodes[i];
         if (node && node->payload_size > 0) {
@@ -3573,9 +5322,20 @@ void wave_form_intelligent_edges(MelvinGraph *g, Node **activated_nodes, size_t
             /* Use local average as similarity threshold (local context only) */
             float similarity_threshold = (local_avg > 0.0f) ? local_avg / (local_avg + 1.0f) : 0.0f;
             
-            wave_create_edges_from_similarity(g, node, similarity_threshold);
+            EdgeScore entry = {node, NULL, 0.0f};
+            if (similarity_score_is_stale(&batch, node)) {
+                edge_score_similarity(&entry);
+            } else {
+                entry = batch.entries[i];
+            }
+            similarity_commit(g, node, entry.partner, entry.score, similarity_threshold);
+            if (entry.partner) {
+                edge_score_batch_touch(&batch, node);
+                edge_score_batch_touch(&batch, entry.partner);
+            }
         }
     }
+    edge_score_batch_free(&batch);
     
     /* 4. UNIVERSAL: Pattern Generalization (abstraction) */
     /* All nodes can generalize - creates abstract representations of common patterns */
@@ -3616,8 +5376,8 @@ void wave_create_edges_from_coactivation(MelvinGraph *g, Node **activated_nodes,
         Edge *existing = node_find_edge_to(from, to);
         if (existing) {
             /* Edge exists - co-activation strengthens it (emergent learning) */
-            existing->activation = true;
-            float old_weight = existing->weight;
+            edge_mark_activated(existing);
+            float old_weight = edge_get_decayed_weight(existing);  /* Learning settles decay first */
             edge_update_weight_local(existing);
             
             /* Hierarchy emerges naturally when edges become strong through repetition */
@@ -3636,7 +5396,8 @@ void wave_create_edges_from_coactivation(MelvinGraph *g, Node **activated_nodes,
                     Edge *other_edge = from->outgoing_edges[j];
                     if (!other_edge || other_edge == existing) continue;
                     
-                    float other_relative = (local_avg > 0.0f) ? other_edge->weight / local_avg : other_edge->weight;
+                    float other_weight = edge_get_decayed_weight(other_edge);
+                    float other_relative = (local_avg > 0.0f) ? other_weight / local_avg : other_weight;
                     if (other_relative > max_other) {
                         max_other = other_relative;
                     }
@@ -3656,35 +5417,15 @@ void wave_create_edges_from_coactivation(MelvinGraph *g, Node **activated_nodes,
                 
                 if (should_form_hierarchy) {
                     /* Check if hierarchy node already exists (avoid duplicates) */
-                    /* Simple check: look for existing combined node via outgoing edges */
-                    /* Works for all node types - no special cases */
-                    bool hierarchy_exists = false;
-                    size_t expected_combined_size = from->payload_size + to->payload_size;
-                    
-                    for (size_t j = 0; j < from->outgoing_count; j++) {
-                        Edge *check_edge = from->outgoing_edges[j];
-                        if (!check_edge || !check_edge->to_node) continue;
-                        Node *candidate = check_edge->to_node;
-                        
-                        /* Check if this is a combined hierarchy node (has combined payload) */
-                        /* Works for all abstraction levels - hierarchy nodes can form deeper hierarchies */
-                        if (candidate->payload_size == expected_combined_size && candidate->payload_size > 0) {
-                            /* Check if payload matches combination */
-                            if (memcmp(candidate->payload, from->payload, from->payload_size) == 0 &&
-                                memcmp(candidate->payload + from->payload_size, to->payload, to->payload_size) == 0) {
-                                hierarchy_exists = true;
-                                break;
-                            }
-                        }
-                    }
+                    /* CANONICAL: Registry lookup by (from, to) - works for all abstraction levels */
+                    bool hierarchy_exists = (combination_find_existing(g, from, to) != NULL);
                     
-                    if (!hierarchy_exists) {
-                        /* Edge strengthened and is now dominant - hierarchy naturally emerges */
-                        Node *combined = node_combine_payloads(from, to);
-                        if (combined && graph_add_node(g, combined)) {
-                            /* Natural edge transfer - preserve connectivity */
-                            node_transfer_incoming_to_hierarchy(g, from, to, combined);
-                        }
+                    /* Edge strengthened and is now dominant - hierarchy naturally emerges */
+                    /* GROWTH BUDGET: Proposed while capped, ranked by its lead over the next edge */
+                    if (!hierarchy_exists &&
+                        !growth_propose(g, GROWTH_COMBINATION, from, to, 0.0f, false,
+                                        growth_margin(edge_relative, max_other))) {
+                        combination_commit(g, from, to, false);
                     }
                 }
             }
@@ -3696,7 +5437,7 @@ void wave_create_edges_from_coactivation(MelvinGraph *g, Node **activated_nodes,
         Edge *edge = edge_create(from, to, true);
         if (edge) {
             /* Initial activation - edge created because nodes activated together */
-            edge->activation = true;
+            edge_mark_activated(edge);
             
             /* RELATIVE: Initial edge weight relative to local context (no hardcoded multiplier) */
             /* Use similarity factor of 1.0 for co-activation (direct connection) */
@@ -3753,7 +5494,8 @@ static bool write_nodes(FILE *file, MelvinGraph *graph, uint64_t offset) {
         if (fwrite(&payload_size, sizeof(uint64_t), 1, file) != 1) return false;
         
         if (payload_size > 0) {
-            if (fwrite(node->payload, 1, payload_size, file) != payload_size) return false;
+            const uint8_t *bytes = node_payload_data(node);
+            if (!bytes || fwrite(bytes, 1, payload_size, file) != payload_size) return false;
         }
     }
     return true;
@@ -3823,11 +5565,14 @@ static bool write_edges(FILE *file, MelvinGraph *graph, uint64_t offset) {
         Edge *edge = graph->edges[i];
         if (!edge) continue;
         
+        bool direction = edge->direction;    /* Bit-fields - copy out before writing */
+        bool activation = edge->activation;
+        float weight = edge->weight;
         if (fwrite(edge->from_node->id, 9, 1, file) != 1) return false;
         if (fwrite(edge->to_node->id, 9, 1, file) != 1) return false;
-        if (fwrite(&edge->direction, sizeof(bool), 1, file) != 1) return false;
-        if (fwrite(&edge->activation, sizeof(bool), 1, file) != 1) return false;
-        if (fwrite(&edge->weight, sizeof(float), 1, file) != 1) return false;
+        if (fwrite(&direction, sizeof(bool), 1, file) != 1) return false;
+        if (fwrite(&activation, sizeof(bool), 1, file) != 1) return false;
+        if (fwrite(&weight, sizeof(float), 1, file) != 1) return false;
     }
     return true;
 }
@@ -4134,6 +5879,9 @@ MelvinGraph* graph_create(void) {
     g->ingestion_mode = true;  /* Start in fast mode (no patterns learned yet) */
     g->pattern_maturity_avg = 0.0f;  /* No patterns learned yet */
     
+    /* SAMPLING: Reproducible by default (like an unseeded rand()), reseed via graph_set_seed */
+    graph_set_seed(g, MELVIN_DEFAULT_SEED);
+    
     return g;
 }
 
@@ -4151,6 +5899,13 @@ bool graph_add_node(MelvinGraph *g, Node *node) {
     }
     
     g->nodes[g->node_count++] = node;
+    g->structure_version++;  /* MEMOIZATION: Outputs walked before this node existed are stale */
+    
+    /* CANONICAL: A combined node becomes the one for its part pair (rebuilt this way on .m load) */
+    /* Registration failure only costs a local edge check later (combination_find_existing) */
+    if (node->payload_left && node->payload_right) {
+        node_pair_map_add(&g->combinations, node->payload_left, node->payload_right, node);
+    }
     return true;
 }
 
@@ -4164,7 +5919,7 @@ bool graph_add_edge(MelvinGraph *g, Edge *edge, Node *from, Node *to) {
     Edge *existing = node_find_edge_bidirectional_local(from, to);
     if (existing) {
         /* Edge exists - strengthen it (compounding learning) */
-        existing->activation = true;
+        edge_mark_activated(existing);
         edge_update_weight_local(existing);
         edge_free(edge);  /* Free the duplicate edge we were about to add */
         return true;  /* Return success (edge strengthened, not duplicated) */
@@ -4180,6 +5935,7 @@ bool graph_add_edge(MelvinGraph *g, Edge *edge, Node *from, Node *to) {
     }
     
     g->edges[g->edge_count++] = edge;
+    g->structure_version++;  /* MEMOIZATION: New edge (a strengthened duplicate returned above) */
     
     /* Connect edge to nodes (local to nodes - no searching, direct connection) */
     /* Nodes only know themselves and their edges - this is how they learn about connections */
@@ -4208,6 +5964,12 @@ bool graph_add_edge(MelvinGraph *g, Edge *edge, Node *from, Node *to) {
         
         /* Update cached incoming weight sum (O(1) incremental update) */
         node_add_incoming_weight(to, edge->weight);
+        
+        /* DELTA-DRIVEN: Edge starts contributing its transformed input to to_node */
+        edge->connected = true;
+        edge->decay_tick = from->decay_tick;  /* Decay clock starts when the edge is attached */
+        if (edge->activation) node_note_activated_edge(from, edge);  /* Activated before it was attached */
+        /* Both endpoints are marked changed - to's next read pushes this edge's contribution */
     
     return true;
 }
@@ -4233,6 +5995,13 @@ void graph_free(MelvinGraph *g) {
         free(g->last_activated);
     }
     
+    weight_updates_free(g);
+    free(g->growth_pending);
+    node_pair_map_free(&g->generalizations);
+    node_pair_map_free(&g->combinations);
+    output_cache_free(g->output_cache);
+    segment_cache_free(g->segment_cache);
+    
     free(g);
 }
 
@@ -4256,6 +6025,11 @@ typedef struct EdgeTransformContext {
 /* Forward declaration for parallel edge transformation worker */
 static void transform_edge_parallel(void *item, size_t index, void *context);
 
+/* Forward declarations: energy conservation helpers (defined with energy section below) */
+float compute_energy_cost_edge_exploration(Edge *edge, Node *from_node);
+float compute_energy_modulated_exploration_probability(float edge_cost, float available_energy);
+void node_ensure_efficiency_order(Node *node);
+
 /* Propagate activation from a node through its outgoing edges (local, relative) */
 /* Node acts as mini neural net - "thinks" by combining edge weights + payload structure */
 /* Wave prop "selects" nodes by activating edges based on relative influence - no thresholds */
@@ -4265,10 +6039,25 @@ Node** wave_propagate_from_node(Node *node) {
     return wave_propagate_from_node_with_energy(node, NULL);
 }
 
+static Node** wave_propagate_from_node_bounded(Node *node, float *energy_budget, size_t fanout_k,
+                                               float *allowance, bool *exhausted, float **charged);
+
 /* RIGID ENERGY CONSTRAINT: Energy must be available BEFORE processing each edge */
 /* Like neurons: can't fire without ATP. Like fungi: can't grow without nutrients */
 /* This is the most rigid solution - energy is a physical constraint, not a soft check */
 Node** wave_propagate_from_node_with_energy(Node *node, float *energy_budget) {
+    /* Unbounded fan-out: every edge above the relative threshold may activate */
+    return wave_propagate_from_node_bounded(node, energy_budget, 0, NULL, NULL, NULL);
+}
+
+/* SPARSE PROPAGATION: Same rules as above, but only the fanout_k strongest transformed */
+/* outputs propagate (fanout_k == 0 = unbounded). Selection is partial, not a full sort */
+/* BEST-FIRST: allowance (optional) is a hard budget - each edge's exploration cost is paid */
+/* before it activates its target; the first edge it can't pay sets *exhausted and ends the */
+/* pass, so unpaid targets are neither activated nor learned on. charged (optional) receives */
+/* the cost paid for each returned node, index for index (caller frees) */
+static Node** wave_propagate_from_node_bounded(Node *node, float *energy_budget, size_t fanout_k,
+                                               float *allowance, bool *exhausted, float **charged) {
     if (!node) return NULL;
     
     /* IMPLIED CHECKS: Compute node state once, use for all decisions */
@@ -4276,8 +6065,13 @@ Node** wave_propagate_from_node_with_energy(Node *node, float *energy_budget) {
     bool has_outgoing_edges = (node->outgoing_count > 0);
     bool has_energy_budget = (energy_budget != NULL);
     
+    /* LAZY DECAY: Outgoing weights are about to be read - settle pending decay (O(degree), */
+    /* same order as the propagation pass itself) */
+    node_reconcile_edge_decay(node);
+    
     /* Compute activation strength from inputs (mini neural net) */
-    node->activation_strength = node_compute_activation_strength(node);
+    /* DELTA-DRIVEN: Published once (below) so downstream contributions are pushed once */
+    float activation = node_compute_activation_strength(node);
     
     /* SMOOTH: Compute propagation probability (continuous, not binary threshold) */
     /* Strong activation = high probability, weak = low probability, smooth in between */
@@ -4292,18 +6086,19 @@ Node** wave_propagate_from_node_with_energy(Node *node, float *energy_budget) {
     
     /* SMOOTH: Compute propagation probability (no binary threshold) */
     /* Activation strength relative to threshold determines probability */
-    float propagation_probability = node->activation_strength / 
-        (node->activation_strength + propagation_threshold + 1.0f);  /* Smooth: 0 to 1 */
+    float propagation_probability = activation / 
+        (activation + propagation_threshold + 1.0f);  /* Smooth: 0 to 1 */
     
     /* Use probability to modulate propagation (smooth, not binary) */
     /* Very low probability = don't propagate, but smooth transition */
     if (propagation_probability < 0.1f) {  /* Minimal threshold for efficiency (very low probability) */
+        node_set_activation_strength(node, activation);
         node_update_weight_local(node);
         return NULL;  /* Too weak to propagate */
     }
     
     /* Scale activation strength by probability (smooth modulation) */
-    node->activation_strength *= propagation_probability;
+    node_set_activation_strength(node, activation * propagation_probability);
     
     /* IMPLIED: Use precomputed flag */
     if (!has_outgoing_edges) {
@@ -4313,9 +6108,9 @@ Node** wave_propagate_from_node_with_energy(Node *node, float *energy_budget) {
     
     /* RIGID CONSTRAINT: Sort edges by efficiency (strong edges first = lower cost) */
     /* This ensures we process affordable edges first (like biological systems) */
-    /* IMPLIED: Use precomputed flag */
-    if (has_energy_budget) {
-        sort_edges_by_efficiency(node->outgoing_edges, node->outgoing_count, node);
+    /* BEST-FIRST: An allowance stops at the first edge it can't pay - cheap edges must come first */
+    if (has_energy_budget || allowance) {
+        node_ensure_efficiency_order(node);  /* Lazy: re-sorts only if weights changed */
     }
     
     /* Propagate through outgoing edges */
@@ -4377,9 +6172,29 @@ Node** wave_propagate_from_node_with_energy(Node *node, float *energy_budget) {
         /* GPU check (cached - only checked once, then reused) */
         MelvinGPUContext *gpu_ctx = get_cached_gpu_context();
         if (gpu_ctx && node->outgoing_count > 16) {
-            /* GPU-ACCELERATED: Use GPU for large edge counts */
+            /* GPU-ACCELERATED: Use batch backend (CUDA or SIMD) for large edge counts */
             melvin_gpu_batch_transform_edges(gpu_ctx, node, node->outgoing_edges, 
                                              node->outgoing_count, edge_outputs, &max_edge_output);
+            
+            /* DYNAMIC ENERGY CONSTRAINT: Same modulation as the sequential path (kernel is energy-free) */
+            if (has_energy) {
+                max_edge_output = 0.0f;
+                for (size_t i = 0; i < node->outgoing_count; i++) {
+                    Edge *edge = node->outgoing_edges[i];
+                    if (!edge->to_node) continue;
+                    
+                    float edge_cost = compute_energy_cost_edge_exploration(edge, node);
+                    float exploration_probability = compute_energy_modulated_exploration_probability(
+                        edge_cost, current_energy);
+                    current_energy -= edge_cost * exploration_probability;
+                    
+                    edge_outputs[i] *= exploration_probability;
+                    if (edge_outputs[i] > max_edge_output) {
+                        max_edge_output = edge_outputs[i];
+                    }
+                }
+                *energy_budget = current_energy;
+            }
         } else {
             /* CPU PARALLEL: Check if parallelization is beneficial */
             /* Threshold computed once when thread pool is created */
@@ -4485,7 +6300,23 @@ Node** wave_propagate_from_node_with_energy(Node *node, float *energy_budget) {
     /* IMPLIED: Precompute capacity check threshold (used in loop) */
     bool needs_capacity_check = (activated_count >= activated_capacity);
     
-    for (size_t i = 0; i < node->outgoing_count; i++) {
+    /* SPARSE PROPAGATION: Restrict candidates to the k strongest outputs (hub can't flood front) */
+    size_t *selected = NULL;
+    size_t candidate_count = node->outgoing_count;
+    if (fanout_k > 0 && fanout_k < node->outgoing_count) {
+        selected = (size_t*)malloc(node->outgoing_count * sizeof(size_t));
+        if (selected) {
+            for (size_t i = 0; i < node->outgoing_count; i++) {
+                selected[i] = i;
+            }
+            select_top_k_indices(edge_outputs, selected, node->outgoing_count, fanout_k);
+            candidate_count = fanout_k;
+        }
+    }
+    
+    float *costs = NULL;  /* Cost paid per activated node (only when the caller asks) */
+    for (size_t c = 0; c < candidate_count; c++) {
+        size_t i = selected ? selected[c] : c;
         Edge *edge = node->outgoing_edges[i];
         /* IMPLIED: If edge is in array, it exists. Only check to_node when needed */
         if (!edge->to_node) continue;  /* Only check what matters for intelligence */
@@ -4506,7 +6337,17 @@ Node** wave_propagate_from_node_with_energy(Node *node, float *energy_budget) {
         /* Binary activation still needed for graph structure, but any positive probability activates */
         /* High probability = strong activation, low = weak activation (smooth, not binary) */
         if (activation_probability > 0.0f) {
-            edge->activation = true;
+            float edge_cost = 0.0f;
+            if (allowance) {
+                edge_cost = compute_energy_cost_edge_exploration(edge, node);
+                if (edge_cost > *allowance) {
+                    if (exhausted) *exhausted = true;  /* Can't afford this edge - stop without overdrawing */
+                    break;
+                }
+                *allowance -= edge_cost;
+            }
+            
+            edge_mark_activated(edge);
             /* Use probability to scale weight update (smooth learning) */
             /* Probability already modulates the strength - no hardcoded 0.5f threshold */
             edge_update_weight_local(edge);
@@ -4514,18 +6355,27 @@ Node** wave_propagate_from_node_with_energy(Node *node, float *energy_budget) {
             /* IMPLIED: Check capacity only when needed (not every iteration) */
             if (needs_capacity_check || activated_count >= activated_capacity) {
                 activated_capacity = (activated_capacity == 0) ? 1 : activated_capacity * 2;  /* Minimal context: start at 1 */
-                activated = (Node**)realloc(activated, (activated_capacity + 1) * sizeof(Node*));
-                if (!activated) {
+                Node **new_activated = (Node**)realloc(activated, (activated_capacity + 1) * sizeof(Node*));
+                if (new_activated) activated = new_activated;
+                float *new_costs = (charged && new_activated) ?
+                    (float*)realloc(costs, activated_capacity * sizeof(float)) : NULL;
+                if (new_costs) costs = new_costs;
+                if (!new_activated || (charged && !new_costs)) {
+                    free(activated);
+                    free(costs);
+                    free(selected);
                     free(edge_outputs);
                     node_update_weight_local(node);
                     return NULL;
                 }
                 needs_capacity_check = false;  /* Reset flag after allocation */
             }
+            if (costs) costs[activated_count] = edge_cost;
             activated[activated_count++] = edge->to_node;
         }
     }
     
+    free(selected);
     free(edge_outputs);
     
     if (activated_count > 0) {
@@ -4533,24 +6383,15 @@ Node** wave_propagate_from_node_with_energy(Node *node, float *energy_budget) {
         activated[activated_count] = NULL;
         node_update_weight_local(node);
     }
+    if (charged) {
+        *charged = costs;
+    } else {
+        free(costs);
+    }
     
     return activated;
 }
 
-/* MULTI-THREADING: Worker function for parallel wave front processing */
-static void process_wave_node_parallel(void *item, size_t index, void *context) {
-    (void)index; /* Unused */
-    (void)context; /* Unused */
-    Node *current_node = (Node*)item;
-    if (!current_node) return;
-    
-    /* UNIFIED: Compute activation (updates bias self-regulating) */
-    current_node->activation_strength = node_compute_activation_strength(current_node);
-    
-    /* UNIFIED: Update node weight immediately (continuous self-regulation) */
-    node_update_weight_local(current_node);
-}
-
 /* PARALLEL: Worker function for transforming edges independently */
 /* Each edge transformation is independent - perfect for parallelization */
 /* Follows README: Independent node calculations, parallel-ready */
@@ -4730,7 +6571,7 @@ void process_chunk_batch(MelvinGraph *g, const uint8_t *chunk_data, size_t chunk
     if (chunk_match && chunk_match->payload_size >= chunk_size) {
         /* Found hierarchy node matching chunk - use it (compounds: 1-check matching) */
         /* Skip byte-by-byte processing */
-        chunk_match->activation_strength = 1.0f;
+        node_set_activation_strength(chunk_match, 1.0f);
         return;
     }
     
@@ -4827,36 +6668,283 @@ float compute_energy_cost_wave_step(size_t wave_front_size, size_t edges_explore
  * ======================================== */
 
 /* Compare function for sorting edges by efficiency (cost ascending) */
-/* Strong edges (high weight) have lower cost, so they come first */
-/* Note: Using static global for macOS compatibility (qsort_r signature differs) */
-static Node *g_sort_from_node = NULL;
+/* Cost = 1 - w / (w + local_avg) shares local_avg across a node's edges, so cost order is */
+/* exactly weight-descending order - no per-node context (and no global state) needed */
 static int compare_edges_by_efficiency(const void *a, const void *b) {
-    Edge *edge_a = *(Edge**)a;
-    Edge *edge_b = *(Edge**)b;
-    Node *from_node = g_sort_from_node;
+    const Edge *edge_a = *(Edge* const*)a;
+    const Edge *edge_b = *(Edge* const*)b;
     
-    if (!edge_a || !edge_b || !from_node) return 0;
+    if (!edge_a || !edge_b) return (edge_a ? -1 : (edge_b ? 1 : 0));  /* NULLs last */
     
-    /* Compute cost for each edge (strong edges = lower cost) */
-    float cost_a = compute_energy_cost_edge_exploration(edge_a, from_node);
-    float cost_b = compute_energy_cost_edge_exploration(edge_b, from_node);
-    
-    /* Sort by cost (ascending) - lower cost (strong edges) first */
-    if (cost_a < cost_b) return -1;
-    if (cost_a > cost_b) return 1;
+    /* Strong edges (high weight) = lower cost = first */
+    if (edge_a->weight > edge_b->weight) return -1;
+    if (edge_a->weight < edge_b->weight) return 1;
     return 0;
 }
 
-/* RIGID CONSTRAINT: Sort edges by efficiency (strong edges first = lower cost) */
-/* This ensures we process affordable edges first (like biological systems) */
-void sort_edges_by_efficiency(Edge **edges, size_t count, Node *from_node) {
-    if (!edges || count == 0 || !from_node) return;
+/* RIGID CONSTRAINT: Keep outgoing edges in efficiency order (strong edges first = lower cost) */
+/* LAZY: Order is maintained per node with a dirty flag set when outgoing weights change; */
+/* re-sorting happens only on the next energy-constrained propagation that needs it */
+void node_ensure_efficiency_order(Node *node) {
+    if (!node || !node->outgoing_order_dirty) return;
+    
+    if (node->outgoing_count > 1) {
+        qsort(node->outgoing_edges, node->outgoing_count, sizeof(Edge*), compare_edges_by_efficiency);
+    }
+    node->outgoing_order_dirty = false;
+}
+
+/* SPARSE PROPAGATION: Keep the cap highest-scoring front entries (scores[i] scores front[i]) */
+static size_t wave_front_keep_top_scores(Node **front, const float *scores, size_t size, size_t cap) {
+    if (!front || !scores || cap == 0 || size <= cap) return size;
+    
+    size_t *indices = (size_t*)malloc(size * sizeof(size_t));
+    bool *keep = (bool*)calloc(size, sizeof(bool));
+    if (!indices || !keep) {
+        free(indices);
+        free(keep);
+        return size;  /* No memory for selection - leave front unbounded */
+    }
+    
+    for (size_t i = 0; i < size; i++) {
+        indices[i] = i;
+    }
+    select_top_k_indices(scores, indices, size, cap);
+    for (size_t i = 0; i < cap; i++) {
+        keep[indices[i]] = true;
+    }
+    
+    size_t kept = 0;
+    for (size_t i = 0; i < size; i++) {
+        if (keep[i]) front[kept++] = front[i];
+    }
+    
+    free(indices);
+    free(keep);
+    return kept;
+}
+
+/* SPARSE PROPAGATION: Keep the cap strongest nodes (by activation) of a wave front, in place */
+/* Uses the same partial selection as per-node fan-out; preserves relative order of survivors */
+static size_t wave_front_select_strongest(Node **front, size_t size, size_t cap) {
+    if (!front || cap == 0 || size <= cap) return size;
+    
+    float *scores = (float*)malloc(size * sizeof(float));
+    if (!scores) return size;  /* No memory for selection - leave front unbounded */
+    for (size_t i = 0; i < size; i++) {
+        scores[i] = front[i] ? front[i]->activation_strength : -FLT_MAX;
+    }
+    size_t kept = wave_front_keep_top_scores(front, scores, size, cap);
+    free(scores);
+    return kept;
+}
+
+/* DEADLINE: Monotonic wall clock in microseconds (unaffected by system time changes) */
+static uint64_t graph_monotonic_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+/* DEADLINE: Arm a wall-clock budget for the next processing call (0 = no deadline) */
+void graph_set_deadline(MelvinGraph *g, uint64_t budget_us) {
+    if (!g) return;
+    g->deadline_us = (budget_us > 0) ? graph_monotonic_us() + budget_us : 0;
+    g->deadline_truncated = false;
+}
+
+/* DEADLINE: Check the budget; once expired, stays expired and marks the call truncated */
+bool graph_deadline_expired(MelvinGraph *g) {
+    if (!g || g->deadline_us == 0) return false;
+    if (g->deadline_truncated) return true;
+    if (graph_monotonic_us() >= g->deadline_us) {
+        g->deadline_truncated = true;
+        return true;
+    }
+    return false;
+}
+
+/* Configure sparse (top-k) propagation: fanout_k edges per node, frontier_cap nodes per step */
+/* 0 disables the corresponding bound (default: unbounded, original behavior) */
+void graph_set_sparse_propagation(MelvinGraph *g, size_t fanout_k, size_t frontier_cap) {
+    if (!g) return;
+    g->propagation_fanout_k = fanout_k;
+    g->propagation_frontier_cap = frontier_cap;
+}
+
+/* Configure best-first propagation: energy_budget per call (0 = derived from input size) */
+void graph_set_best_first_propagation(MelvinGraph *g, bool enabled, float energy_budget) {
+    if (!g) return;
+    g->propagation_best_first = enabled;
+    g->propagation_energy_budget = (energy_budget > 0.0f) ? energy_budget : 0.0f;
+}
+
+/* ========================================
+ * BEST-FIRST PROPAGATION (max-heap by activation/cost)
+ * ======================================== */
+
+/* Binary max-heap of nodes keyed by priority (lazy: a node may be queued more than once) */
+typedef struct {
+    Node **nodes;
+    float *keys;
+    size_t size;
+    size_t capacity;
+} PropagationHeap;
+
+static bool propagation_heap_push(PropagationHeap *heap, Node *node, float key) {
+    if (heap->size >= heap->capacity) {
+        size_t new_capacity = (heap->capacity == 0) ? 1 : heap->capacity * 2;  /* Minimal context: start at 1 */
+        Node **new_nodes = (Node**)realloc(heap->nodes, new_capacity * sizeof(Node*));
+        if (!new_nodes) return false;
+        heap->nodes = new_nodes;
+        float *new_keys = (float*)realloc(heap->keys, new_capacity * sizeof(float));
+        if (!new_keys) return false;
+        heap->keys = new_keys;
+        heap->capacity = new_capacity;
+    }
+    
+    /* Sift up */
+    size_t i = heap->size++;
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (heap->keys[parent] >= key) break;
+        heap->nodes[i] = heap->nodes[parent];
+        heap->keys[i] = heap->keys[parent];
+        i = parent;
+    }
+    heap->nodes[i] = node;
+    heap->keys[i] = key;
+    return true;
+}
+
+static Node* propagation_heap_pop(PropagationHeap *heap) {
+    if (heap->size == 0) return NULL;
+    
+    Node *top = heap->nodes[0];
+    Node *last = heap->nodes[--heap->size];
+    float last_key = heap->keys[heap->size];
+    
+    /* Sift down */
+    size_t i = 0;
+    while (true) {
+        size_t child = 2 * i + 1;
+        if (child >= heap->size) break;
+        if (child + 1 < heap->size && heap->keys[child + 1] > heap->keys[child]) child++;
+        if (heap->keys[child] <= last_key) break;
+        heap->nodes[i] = heap->nodes[child];
+        heap->keys[i] = heap->keys[child];
+        i = child;
+    }
+    if (heap->size > 0) {
+        heap->nodes[i] = last;
+        heap->keys[i] = last_key;
+    }
+    return top;
+}
+
+/* Best-first propagation: always expand the most useful reached node next */
+/* Priority = activation / cost of the edge that reached it (seeds: activation) */
+/* Stops cleanly when the energy allowance is spent: no partial expansion is charged past zero */
+/* Structural learning (edges, combinations) runs once over everything reached */
+void wave_propagate_best_first(MelvinGraph *g, Node **initial_nodes, size_t initial_count, float energy_budget) {
+    if (!g || !initial_nodes || initial_count == 0) return;
+    
+    /* DATA-DRIVEN: No configured allowance - input provides energy (size x graph complexity) */
+    if (energy_budget <= 0.0f) {
+        energy_budget = compute_energy_budget_from_input(initial_count, g->node_count);
+    }
+    float energy = energy_budget;
+    
+    size_t hash_size = calculate_optimal_hash_size(g->node_count);
+    VisitedSet *expanded = visited_set_create(hash_size);
+    VisitedSet *queued = visited_set_create(hash_size);  /* Ever pushed (dedups the reached list) */
+    if (!expanded || !queued) {
+        if (expanded) visited_set_free(expanded);
+        if (queued) visited_set_free(queued);
+        return;
+    }
+    
+    PropagationHeap heap = {0};
+    Node **reached = NULL;  /* Non-seed nodes reached, in expansion order (co-activation set) */
+    size_t reached_count = 0;
+    size_t reached_capacity = 0;
+    
+    /* DEFERRED: Expansion reads the weights as they were when the call started */
+    graph_begin_weight_updates(g);
+    
+    for (size_t i = 0; i < initial_count; i++) {
+        Node *seed = initial_nodes[i];
+        if (!seed) continue;
+        node_update_weight_local(seed);
+        visited_set_add(queued, seed);  /* Keyed by input-driven activation (match strength) */
+        if (!propagation_heap_push(&heap, seed, seed->activation_strength)) goto cleanup;
+    }
+    
+    bool exhausted = false;
+    while (heap.size > 0 && energy > 0.0f && !exhausted) {
+        /* DEADLINE: Best-first means whatever was expanded so far is the most useful part */
+        if (graph_deadline_expired(g)) break;
+        
+        Node *node = propagation_heap_pop(&heap);
+        if (!node || visited_set_contains(expanded, node)) continue;  /* Stale duplicate entry */
+        visited_set_add(expanded, node);
+        
+        /* ENERGY CONSERVATION: Each traversed edge is paid from the allowance before it activates */
+        /* its target (energy drives ordering here, not per-edge modulation) */
+        float *charged = NULL;
+        Node **newly_activated = wave_propagate_from_node_bounded(node, NULL, g->propagation_fanout_k,
+                                                                  &energy, &exhausted, &charged);
+        if (!newly_activated) {
+            free(charged);
+            continue;
+        }
+        
+        for (size_t j = 0; newly_activated[j]; j++) {
+            Node *activated_node = newly_activated[j];
+            float edge_cost = charged ? charged[j] : 0.0f;  /* What the allowance actually paid */
+            
+            node_set_activation_strength(activated_node, node_compute_activation_strength(activated_node));
+            node_update_weight_local(activated_node);
+            
+            if (visited_set_contains(expanded, activated_node)) continue;
+            
+            /* RELATIVE: Cheap, strongly activated nodes first (cost in (0, 1], floor avoids divide by 0) */
+            /* Re-reached nodes are pushed again with the new priority (stale entries skipped on pop) */
+            float priority = activated_node->activation_strength / fmaxf(edge_cost, FLT_EPSILON);
+            if (!propagation_heap_push(&heap, activated_node, priority)) break;
+            
+            if (visited_set_contains(queued, activated_node)) continue;  /* Already in reached list */
+            visited_set_add(queued, activated_node);
+            if (reached_count >= reached_capacity) {
+                size_t new_capacity = (reached_capacity == 0) ? 1 : reached_capacity * 2;  /* Minimal context: start at 1 */
+                Node **new_reached = (Node**)realloc(reached, new_capacity * sizeof(Node*));
+                if (!new_reached) break;
+                reached = new_reached;
+                reached_capacity = new_capacity;
+            }
+            reached[reached_count++] = activated_node;
+        }
+        free(charged);
+        free(newly_activated);
+    }
     
-    /* Use qsort with static global for macOS compatibility */
-    /* Strong edges (high weight) = efficient = lower cost = process first */
-    g_sort_from_node = from_node;
-    qsort(edges, count, sizeof(Edge*), compare_edges_by_efficiency);
-    g_sort_from_node = NULL;
+    graph_commit_weight_updates(g);
+    
+    /* UNIFIED: Structural learning over the co-activated set (skipped when out of time) */
+    if (reached_count > 1 && !g->deadline_truncated) {
+        WaveStatistics stats;  /* Empty struct for backward compatibility */
+        wave_form_intelligent_edges(g, reached, reached_count, expanded, &stats);
+        wave_form_universal_combinations(g, reached, reached_count);
+    }
+    
+cleanup:
+    graph_commit_weight_updates(g);  /* No-op unless the seed loop bailed out while recording */
+    g->last_energy_spent = energy_budget - energy;
+    free(reached);
+    free(heap.nodes);
+    free(heap.keys);
+    visited_set_free(queued);
+    visited_set_free(expanded);
 }
 
 /* Unified multi-step wave propagation - all mechanisms work together seamlessly */
@@ -4866,6 +6954,12 @@ void sort_edges_by_efficiency(Edge **edges, size_t count, Node *from_node) {
 /* MULTI-THREADING: Parallelizes activation/weight updates for large wave fronts */
 /* ENERGY CONSERVATION: Additional layer - operations cost energy, system naturally conserves */
 void wave_propagate_multi_step(MelvinGraph *g, Node **initial_nodes, size_t initial_count) {
+    /* BEST-FIRST: Strongest work first within a fixed energy allowance (opt-in) */
+    if (g && g->propagation_best_first) {
+        wave_propagate_best_first(g, initial_nodes, initial_count, g->propagation_energy_budget);
+        return;
+    }
+    
     /* Compute energy budget from graph state (if available) */
     /* For now, use unlimited energy (backward compatible) */
     float energy_budget = FLT_MAX;
@@ -4932,6 +7026,9 @@ void wave_propagate_multi_step_with_energy(MelvinGraph *g, Node **initial_nodes,
     /* The visited set tracks all nodes explored by wave propagation - this IS the context */
     
     while (wave_front_size > 0) {
+        /* DEADLINE: Out of wall-clock time - stop propagating (anytime result) */
+        if (graph_deadline_expired(g)) break;
+        
         step++;
         Node **next_wave_front = NULL;
         size_t next_size = 0;
@@ -4946,6 +7043,9 @@ void wave_propagate_multi_step_with_energy(MelvinGraph *g, Node **initial_nodes,
         /* UNIVERSAL: Track co-activated nodes for combination (hierarchy emerges naturally) */
         /* All nodes can combine when they co-activate strongly - universal law */
         
+        /* DEFERRED: Weights stay fixed for the whole step (updates commit after propagation) */
+        graph_begin_weight_updates(g);
+        
         /* GPU-ACCELERATED: Batch compute activations for wave front (if GPU available) */
         /* Note: Currently uses CPU fallback - GPU acceleration framework is in place */
         /* Future work: Optimize specific hot spots when pointer-based graph is flattened */
@@ -4969,11 +7069,32 @@ void wave_propagate_multi_step_with_energy(MelvinGraph *g, Node **initial_nodes,
             if (pool) {
                 /* Parallelize when wave front size >= thread count (at least 1 node per thread) */
                 /* Threshold computed from available CPU cores (data-driven), not hardcoded */
-                size_t parallelization_threshold = pool->thread_count;
+                /* DEFERRED: Take over exactly the fronts the per-node loop below skips (> 16), so */
+                /* which nodes get updated never depends on the thread count */
+                size_t parallelization_threshold = tls_weight_updates ? 17 : pool->thread_count;
                 if (wave_front_size >= parallelization_threshold) {
-                    /* Parallel process: compute activation and update weights */
-                    thread_pool_process_array(pool, (void**)wave_front, wave_front_size, 
-                                              process_wave_node_parallel, NULL);
+                    /* DELTA-DRIVEN: Activation is O(1) now - publish sequentially (pushes touch shared targets) */
+                    if (melvin_gpu_has_batch_backend(gpu_ctx)) {
+                        /* Vectorized CPU backend: gather front state, SIMD compute, scatter */
+                        melvin_gpu_batch_compute_activations(gpu_ctx, wave_front, wave_front_size);
+                    } else {
+                        for (size_t i = 0; i < wave_front_size; i++) {
+                            if (!wave_front[i]) continue;
+                            node_set_activation_strength(wave_front[i], node_compute_activation_strength(wave_front[i]));
+                        }
+                    }
+                    
+                    /* Update weights in front order: an in-place update writes neighbour state */
+                    /* (cached sums, stale-input lists), so it stays on this thread */
+                    /* DEFERRED: Recording is O(1) per node - the parallel work happens in the commit phase */
+                    if (melvin_gpu_has_batch_backend(gpu_ctx)) {
+                        /* Vectorized CPU backend: gather rates, SIMD blend, scatter in front order */
+                        melvin_gpu_batch_update_weights(gpu_ctx, wave_front, wave_front_size);
+                    } else {
+                        for (size_t i = 0; i < wave_front_size; i++) {
+                            node_update_weight_local(wave_front[i]);
+                        }
+                    }
                 }
             }
         }
@@ -4984,11 +7105,14 @@ void wave_propagate_multi_step_with_energy(MelvinGraph *g, Node **initial_nodes,
             Node *current_node = wave_front[i];
             if (!current_node) continue;
             
+            /* DEADLINE: Stop mid-front when time runs out (nodes already reached stay activated) */
+            if (graph_deadline_expired(g)) break;
+            
             /* UNIFIED: Compute activation (updates bias self-regulating) */
             /* Skip if already computed by GPU batch operation or parallel processing */
             if ((!gpu_ctx || !melvin_gpu_is_available(gpu_ctx) || wave_front_size <= 8) && 
                 wave_front_size <= 16) {
-                current_node->activation_strength = node_compute_activation_strength(current_node);
+                node_set_activation_strength(current_node, node_compute_activation_strength(current_node));
             }
             
             /* UNIFIED: Update node weight immediately (continuous self-regulation) */
@@ -5001,7 +7125,8 @@ void wave_propagate_multi_step_with_energy(MelvinGraph *g, Node **initial_nodes,
             /* Propagate through edges */
             /* RIGID CONSTRAINT: Pass energy budget to edge propagation */
             /* Energy is consumed atomically per edge (before processing) */
-            Node **newly_activated = wave_propagate_from_node_with_energy(current_node, energy_budget);
+            Node **newly_activated = wave_propagate_from_node_bounded(current_node, energy_budget,
+                                                                      g->propagation_fanout_k, NULL, NULL, NULL);
             if (newly_activated) {
                 for (size_t j = 0; newly_activated[j]; j++) {
                     Node *activated_node = newly_activated[j];
@@ -5027,7 +7152,7 @@ void wave_propagate_multi_step_with_energy(MelvinGraph *g, Node **initial_nodes,
                         /* ENERGY CONSERVATION: Stop exploring if energy exhausted (natural limit) */
                         if (*energy_budget <= 0.0f) {
                             /* Energy exhausted - stop exploring this node's edges */
-                            free(newly_activated);
+                            /* (newly_activated is freed once, after this loop) */
                             break;
                         }
                     }
@@ -5036,7 +7161,7 @@ void wave_propagate_multi_step_with_energy(MelvinGraph *g, Node **initial_nodes,
                     
                     /* UNIFIED: Update activated node weight immediately */
                     /* Note: Batch operations handled at wave front level for efficiency */
-                    activated_node->activation_strength = node_compute_activation_strength(activated_node);
+                    node_set_activation_strength(activated_node, node_compute_activation_strength(activated_node));
                     node_update_weight_local(activated_node);
                     
                     /* Add to next wave front if not visited */
@@ -5048,6 +7173,7 @@ void wave_propagate_multi_step_with_energy(MelvinGraph *g, Node **initial_nodes,
                             next_capacity = (next_capacity == 0) ? 1 : next_capacity * 2;  /* Minimal context: start at 1 */
                             next_wave_front = (Node**)realloc(next_wave_front, next_capacity * sizeof(Node*));
                             if (!next_wave_front) {
+                                graph_commit_weight_updates(g);
                                 free(newly_activated);
                                 free(wave_front);
                                 if (co_activated) free(co_activated);
@@ -5063,6 +7189,7 @@ void wave_propagate_multi_step_with_energy(MelvinGraph *g, Node **initial_nodes,
                             co_activated_capacity = (co_activated_capacity == 0) ? 1 : co_activated_capacity * 2;  /* Minimal context: start at 1 */
                             co_activated = (Node**)realloc(co_activated, co_activated_capacity * sizeof(Node*));
                             if (!co_activated) {
+                                graph_commit_weight_updates(g);
                                 free(newly_activated);
                                 free(wave_front);
                                 free(next_wave_front);
@@ -5077,6 +7204,16 @@ void wave_propagate_multi_step_with_energy(MelvinGraph *g, Node **initial_nodes,
             }
         }
         
+        /* DEFERRED: Commit this step's weight updates before structure is learned from them */
+        graph_commit_weight_updates(g);
+        
+        /* DEADLINE: Truncated step - skip structural learning and stop (output uses what was reached) */
+        if (g->deadline_truncated) {
+            if (co_activated) free(co_activated);
+            free(next_wave_front);
+            break;
+        }
+        
         /* UNIFIED: Form intelligent edges from co-activated nodes (all mechanisms) */
         /* This includes: co-activation, similarity, context, hierarchy, homeostatic, and blank nodes */
         /* CONTEXT: Pass visited set as context (paths recently traveled) */
@@ -5098,6 +7235,12 @@ void wave_propagate_multi_step_with_energy(MelvinGraph *g, Node **initial_nodes,
         /* Cleanup */
         if (co_activated) free(co_activated);
         
+        /* SPARSE PROPAGATION: Cap next wave front to the strongest activations (bounded work per step) */
+        /* Dropped nodes stay visited - they activated this step, they just don't propagate further */
+        if (g->propagation_frontier_cap > 0 && next_size > g->propagation_frontier_cap) {
+            next_size = wave_front_select_strongest(next_wave_front, next_size, g->propagation_frontier_cap);
+        }
+        
         /* RIGID CONSTRAINT: Energy already consumed atomically per edge */
         /* No need to charge again - energy was consumed BEFORE processing each edge */
         /* This matches biological systems: energy is a physical constraint, not a soft check */
@@ -5141,35 +7284,20 @@ void wave_propagate_multi_step_with_energy(MelvinGraph *g, Node **initial_nodes,
 Node* node_combine_payloads(Node *node1, Node *node2) {
     if (!node1 || !node2) return NULL;
     
-    /* Combined size relative to both nodes */
-    size_t combined_size = node1->payload_size + node2->payload_size;
-    
-    /* Allocate combined payload */
-    uint8_t *combined = (uint8_t*)malloc(combined_size);
-    if (!combined) return NULL;
-    
-    /* Combine payloads (relative combination) */
-    memcpy(combined, node1->payload, node1->payload_size);
-    memcpy(combined + node1->payload_size, node2->payload, node2->payload_size);
-    
     /* Create new node with combined payload (hierarchy) */
-    Node *combined_node = node_create(combined, combined_size);
-    free(combined);
+    /* ROPE: The combined node references both parts - their bytes are not copied */
+    /* (abstraction level: max of components + 1, set by node_create_rope) */
+    Node *combined_node = node_create_rope(node1, node2);
     
-    /* Set abstraction level and weight relative to both nodes */
+    /* Set weight relative to both nodes */
     if (combined_node) {
-        /* Set abstraction level: max of components + 1 */
-        uint32_t max_level = (node1->abstraction_level > node2->abstraction_level) ?
-            node1->abstraction_level : node2->abstraction_level;
-        combined_node->abstraction_level = max_level + 1;
-        
         /* Weight relative to both nodes */
         combined_node->weight = (node1->weight + node2->weight) / 2.0f;
         
         /* UNIVERSAL: All nodes compute activation the same way (mini neural net) */
         /* Combined node will compute activation from its edges to child nodes */
         /* No special abstraction computation - just universal activation */
-        combined_node->activation_strength = node_compute_activation_strength(combined_node);
+        node_set_activation_strength(combined_node, node_compute_activation_strength(combined_node));
     }
     
     return combined_node;
@@ -5183,74 +7311,76 @@ Node* node_combine_payloads(Node *node1, Node *node2) {
 static void node_create_hierarchy_connections(MelvinGraph *g, Node *new_hierarchy, 
                                               Node *component1, Node *component2);
 
+/* Inherit one part edge: strengthen the hierarchy node's copy if it has one, else create it */
+/* (outgoing = the part edge leaves node2, so the copy leaves combined) */
+static void node_inherit_part_edge(MelvinGraph *g, Edge *old_edge, Node *combined, bool outgoing) {
+    Node *from = outgoing ? combined : old_edge->from_node;
+    Node *to = outgoing ? old_edge->to_node : combined;
+    if (!from || !to) return;
+    
+    /* LEARN FROM EXISTING: Check if edges already exist before creating */
+    Edge *existing = node_find_edge_to(from, to);
+    if (existing) {
+        /* Edge already exists - strengthen it (learning through repetition) */
+        edge_mark_activated(existing);
+        edge_update_weight_local(existing);
+    } else if (growth_admit_edge(g)) {
+        /* Create new edge */
+        Edge *new_edge = edge_create(from, to, true);
+        if (new_edge) {
+            new_edge->weight = compute_relative_initial_edge_weight(from, old_edge->weight);
+            edge_mark_activated(new_edge);
+            graph_add_edge(g, new_edge, from, to);
+        }
+    }
+}
+
 /* Transfer edges to hierarchy node (simple rule: preserve connectivity) */
 /* Complexity emerges: hierarchy nodes naturally participate in graph structure */
 void node_transfer_incoming_to_hierarchy(MelvinGraph *g, Node *node1, Node *node2, Node *combined) {
     if (!g || !node1 || !node2 || !combined) return;
     
-    /* Simple rule: Transfer incoming edges (preserve connectivity to combined node) */
-    /* LEARN FROM EXISTING: Check if edges already exist before creating */
-    for (size_t i = 0; i < node1->incoming_count; i++) {
-        Edge *old_edge = node1->incoming_edges[i];
-        if (!old_edge || !old_edge->from_node) continue;
-        
-        Edge *existing = node_find_edge_to(old_edge->from_node, combined);
-        if (existing) {
-            /* Edge already exists - strengthen it (learning through repetition) */
-            existing->activation = true;
-            edge_update_weight_local(existing);
-        } else {
-            /* Create new edge */
-            Edge *new_edge = edge_create(old_edge->from_node, combined, true);
-            if (new_edge) {
-                new_edge->weight = compute_relative_initial_edge_weight(old_edge->from_node, old_edge->weight);
-                new_edge->activation = true;
-                graph_add_edge(g, new_edge, old_edge->from_node, combined);
+    /* Simple rule: Transfer incoming edges of both parts and outgoing edges of node2 */
+    /* (outgoing transfer enables hierarchy nodes to participate in wave propagation and form deeper hierarchy) */
+    /* GROWTH BUDGET: While growth is capped, the strongest part edges are inherited first - */
+    /* copying every part edge is what makes each new hierarchy node as dense as its parts */
+    size_t incoming_total = node1->incoming_count + node2->incoming_count;
+    size_t total = incoming_total + node2->outgoing_count;
+    Edge **inherited = NULL;
+    size_t *order = NULL;
+    if (g->growth_budget_armed && total > 1) {
+        inherited = (Edge**)malloc(total * sizeof(Edge*));
+        float *strength = (float*)malloc(total * sizeof(float));
+        if (inherited && strength) {
+            memcpy(inherited, node1->incoming_edges, node1->incoming_count * sizeof(Edge*));
+            memcpy(inherited + node1->incoming_count, node2->incoming_edges, node2->incoming_count * sizeof(Edge*));
+            memcpy(inherited + incoming_total, node2->outgoing_edges, node2->outgoing_count * sizeof(Edge*));
+            for (size_t i = 0; i < total; i++) {
+                strength[i] = inherited[i] ? edge_get_decayed_weight(inherited[i]) : -FLT_MAX;
             }
+            order = growth_rank_order(g, strength, total);
         }
+        free(strength);
     }
     
-    for (size_t i = 0; i < node2->incoming_count; i++) {
-        Edge *old_edge = node2->incoming_edges[i];
-        if (!old_edge || !old_edge->from_node) continue;
-        
-        Edge *existing = node_find_edge_to(old_edge->from_node, combined);
-        if (existing) {
-            /* Edge already exists - strengthen it (learning through repetition) */
-            existing->activation = true;
-            edge_update_weight_local(existing);
-        } else {
-            /* Create new edge */
-            Edge *new_edge = edge_create(old_edge->from_node, combined, true);
-            if (new_edge) {
-                new_edge->weight = compute_relative_initial_edge_weight(old_edge->from_node, old_edge->weight);
-                new_edge->activation = true;
-                graph_add_edge(g, new_edge, old_edge->from_node, combined);
-            }
+    if (order) {
+        for (size_t k = 0; k < total; k++) {
+            size_t i = order[k];
+            if (inherited[i]) node_inherit_part_edge(g, inherited[i], combined, i >= incoming_total);
         }
-    }
-    
-    /* Simple rule: Transfer outgoing edges (preserve connectivity from combined node) */
-    /* This enables hierarchy nodes to participate in wave propagation and form deeper hierarchy */
-    for (size_t i = 0; i < node2->outgoing_count; i++) {
-        Edge *old_edge = node2->outgoing_edges[i];
-        if (!old_edge || !old_edge->to_node) continue;
-        
-        Edge *existing = node_find_edge_to(combined, old_edge->to_node);
-        if (existing) {
-            /* Edge already exists - strengthen it (learning through repetition) */
-            existing->activation = true;
-            edge_update_weight_local(existing);
-        } else {
-            /* Create new edge */
-            Edge *new_edge = edge_create(combined, old_edge->to_node, true);
-            if (new_edge) {
-                new_edge->weight = compute_relative_initial_edge_weight(combined, old_edge->weight);
-                new_edge->activation = true;
-                graph_add_edge(g, new_edge, combined, old_edge->to_node);
-            }
+    } else {
+        for (size_t i = 0; i < node1->incoming_count; i++) {
+            if (node1->incoming_edges[i]) node_inherit_part_edge(g, node1->incoming_edges[i], combined, false);
+        }
+        for (size_t i = 0; i < node2->incoming_count; i++) {
+            if (node2->incoming_edges[i]) node_inherit_part_edge(g, node2->incoming_edges[i], combined, false);
+        }
+        for (size_t i = 0; i < node2->outgoing_count; i++) {
+            if (node2->outgoing_edges[i]) node_inherit_part_edge(g, node2->outgoing_edges[i], combined, true);
         }
     }
+    free(order);
+    free(inherited);
     
     /* UNIVERSAL: Create edges to compatible hierarchy nodes (enables deeper hierarchy) */
     /* Hierarchy nodes can connect to other hierarchy nodes if they're compatible */
@@ -5287,14 +7417,14 @@ static void node_create_hierarchy_connections(MelvinGraph *g, Node *new_hierarch
         /* Check compatibility: new_hierarchy ends with what candidate starts with */
         /* Example: "he" (new) ends with "e", "el" (candidate) starts with "e" */
         if (new_hierarchy->payload_size > 0 && candidate->payload_size > 0) {
-            uint8_t new_last = new_hierarchy->payload[new_hierarchy->payload_size - 1];
-            uint8_t candidate_first = candidate->payload[0];
+            uint8_t new_last = node_payload_at(new_hierarchy, new_hierarchy->payload_size - 1);
+            uint8_t candidate_first = node_payload_at(candidate, 0);
             
             if (new_last == candidate_first) {
                 /* Compatible - create edge if doesn't exist */
                 Edge *existing = node_find_edge_to(new_hierarchy, candidate);
                 if (!existing) {
-                    Edge *hierarchy_edge = edge_create(new_hierarchy, candidate, true);
+                    Edge *hierarchy_edge = growth_admit_edge(g) ? edge_create(new_hierarchy, candidate, true) : NULL;
                     if (hierarchy_edge) {
                         /* RELATIVE: Initial weight based on component edge weight and local context */
                         /* No hardcoded threshold - uses local average or component edge weight */
@@ -5304,16 +7434,17 @@ static void node_create_hierarchy_connections(MelvinGraph *g, Node *new_hierarch
                             hierarchy_edge->weight = local_avg / (local_avg + 1.0f);
                         } else {
                             /* No local context: use component edge weight as baseline */
-                            float component_weight = (edge->weight > 0.0f) ? 
-                                edge->weight / (edge->weight + 1.0f) : 0.0f;
+                            float edge_weight = edge_get_decayed_weight(edge);
+                            float component_weight = (edge_weight > 0.0f) ? 
+                                edge_weight / (edge_weight + 1.0f) : 0.0f;
                             hierarchy_edge->weight = component_weight;
                         }
-                        hierarchy_edge->activation = true;
+                        edge_mark_activated(hierarchy_edge);
                         graph_add_edge(g, hierarchy_edge, new_hierarchy, candidate);
                     }
                 } else {
                     /* Edge exists - strengthen it (learning through repetition) */
-                    existing->activation = true;
+                    edge_mark_activated(existing);
                     edge_update_weight_local(existing);
                 }
             }
@@ -5333,14 +7464,14 @@ static void node_create_hierarchy_connections(MelvinGraph *g, Node *new_hierarch
         /* Check compatibility: candidate ends with what new_hierarchy starts with */
         /* Example: "he" (candidate) ends with "e", "el" (new) starts with "e" */
         if (candidate->payload_size > 0 && new_hierarchy->payload_size > 0) {
-            uint8_t candidate_last = candidate->payload[candidate->payload_size - 1];
-            uint8_t new_first = new_hierarchy->payload[0];
+            uint8_t candidate_last = node_payload_at(candidate, candidate->payload_size - 1);
+            uint8_t new_first = node_payload_at(new_hierarchy, 0);
             
             if (candidate_last == new_first) {
                 /* Compatible - create edge if doesn't exist */
                 Edge *existing = node_find_edge_to(candidate, new_hierarchy);
                 if (!existing) {
-                    Edge *hierarchy_edge = edge_create(candidate, new_hierarchy, true);
+                    Edge *hierarchy_edge = growth_admit_edge(g) ? edge_create(candidate, new_hierarchy, true) : NULL;
                     if (hierarchy_edge) {
                         /* RELATIVE: Initial weight based on component edge weight and local context */
                         /* No hardcoded threshold - uses local average or component edge weight */
@@ -5350,16 +7481,17 @@ static void node_create_hierarchy_connections(MelvinGraph *g, Node *new_hierarch
                             hierarchy_edge->weight = local_avg / (local_avg + 1.0f);
                         } else {
                             /* No local context: use component edge weight as baseline */
-                            float component_weight = (edge->weight > 0.0f) ? 
-                                edge->weight / (edge->weight + 1.0f) : 0.0f;
+                            float edge_weight = edge_get_decayed_weight(edge);
+                            float component_weight = (edge_weight > 0.0f) ? 
+                                edge_weight / (edge_weight + 1.0f) : 0.0f;
                             hierarchy_edge->weight = component_weight;
                         }
-                        hierarchy_edge->activation = true;
+                        edge_mark_activated(hierarchy_edge);
                         graph_add_edge(g, hierarchy_edge, candidate, new_hierarchy);
                     }
                 } else {
                     /* Edge exists - strengthen it (learning through repetition) */
-                    existing->activation = true;
+                    edge_mark_activated(existing);
                     edge_update_weight_local(existing);
                 }
             }
@@ -5367,150 +7499,1195 @@ static void node_create_hierarchy_connections(MelvinGraph *g, Node *new_hierarch
     }
 }
 
-/* Create blank/template node (for pattern matching and generalization) */
-/* Blank nodes have empty payload - can be filled when patterns match */
-Node* node_create_blank(void) {
-    return node_create(NULL, 0);
+/* Create blank/template node (for pattern matching and generalization) */
+/* Blank nodes have empty payload - can be filled when patterns match */
+Node* node_create_blank(void) {
+    return node_create(NULL, 0);
+}
+
+/* Fill blank node with payload when pattern matches (relative to match strength) */
+/* Returns new node with filled payload, original blank_node unchanged */
+Node* node_fill_blank(Node *blank_node, const uint8_t *pattern, size_t pattern_size, float match_strength) {
+    if (!blank_node || !pattern || pattern_size == 0 || match_strength <= 0.0f) return NULL;
+    
+    /* Fill size relative to match strength */
+    size_t fill_size = (size_t)(pattern_size * match_strength);
+    if (fill_size == 0) fill_size = 1;
+    
+    /* Create new node with filled payload (relative to match strength) */
+    Node *filled_node = node_create(pattern, fill_size);
+    if (!filled_node) return NULL;
+    
+    /* Weight relative to match strength and original blank weight */
+    filled_node->weight = (blank_node->weight + match_strength) / 2.0f;
+    
+    return filled_node;
+}
+
+/* Compute output readiness based on pattern maturity (relative to local context) */
+/* DATA-DRIVEN: Uses edge existence and strength to measure learned patterns */
+/* Returns relative readiness score (0.0-1.0) where higher = more mature patterns */
+/* Following README principle: all thresholds relative to local context, no hardcoded values */
+float compute_output_readiness(MelvinGraph *g, Node **input_nodes, size_t input_count) {
+    if (!g || !input_nodes || input_count == 0) return 0.0f;
+    
+    /* Measure sequential edge strength from input nodes */
+    float total_edge_weight = 0.0f;
+    size_t total_edge_count = 0;
+    float max_edge_weight = 0.0f;
+    float min_edge_weight = FLT_MAX;
+    
+    /* Also collect local context from nodes (for relative comparison) */
+    float total_local_avg = 0.0f;
+    size_t nodes_with_context = 0;
+    
+    /* For each input node, measure strength of outgoing edges */
+    /* Outgoing edges represent learned sequential patterns (what comes next) */
+    for (size_t i = 0; i < input_count; i++) {
+        Node *node = input_nodes[i];
+        if (!node) continue;
+        
+        /* Get local context for this node (data-driven threshold basis) */
+        float local_avg = node_get_local_outgoing_weight_avg(node);
+        if (local_avg > 0.0f) {
+            total_local_avg += local_avg;
+            nodes_with_context++;
+        }
+        
+        /* Examine ALL outgoing edges - any edge represents learning */
+        for (size_t j = 0; j < node->outgoing_count; j++) {
+            Edge *edge = node->outgoing_edges[j];
+            if (!edge) continue;
+            
+            total_edge_weight += edge->weight;
+            total_edge_count++;
+            
+            /* Track maximum and minimum edge weight (for relative comparison) */
+            if (edge->weight > max_edge_weight) {
+                max_edge_weight = edge->weight;
+            }
+            if (edge->weight < min_edge_weight) {
+                min_edge_weight = edge->weight;
+            }
+        }
+    }
+    
+    /* If no edges exist, pattern is completely novel - no output readiness */
+    if (total_edge_count == 0) return 0.0f;
+    
+    /* Average edge weight represents pattern maturity */
+    float avg_edge_weight = total_edge_weight / (float)total_edge_count;
+    
+    /* RELATIVE: Compute threshold context from actual data, not hardcoded values */
+    /* Use local averages as context - this is what nodes "know" about their neighborhood */
+    float local_context = 0.0f;
+    if (nodes_with_context > 0) {
+        local_context = total_local_avg / (float)nodes_with_context;
+    }
+    
+    /* If no local context available, use edge weight range as context */
+    if (local_context <= 0.0f && max_edge_weight > min_edge_weight) {
+        local_context = (max_edge_weight + min_edge_weight) / 2.0f;  /* Midpoint of range */
+    }
+    
+    /* If still no context, use max_edge_weight as minimal context */
+    if (local_context <= 0.0f && max_edge_weight > 0.0f) {
+        local_context = max_edge_weight;
+    }
+    
+    /* RELATIVE: Normalize average weight relative to local context */
+    /* Pattern: x / (x + context) where context comes from data */
+    /* This measures how mature patterns are compared to what exists locally */
+    float relative_readiness = 0.0f;
+    if (local_context > 0.0f) {
+        /* Compare average to local context - stronger relative to context = more ready */
+        relative_readiness = avg_edge_weight / (avg_edge_weight + local_context);
+    } else {
+        /* No context available: use self-normalization pattern */
+        /* When no local context exists, compare to max (strongest pattern) */
+        if (max_edge_weight > 0.0f) {
+            relative_readiness = avg_edge_weight / (avg_edge_weight + max_edge_weight);
+        } else {
+            /* Absolute minimum: no data available */
+            return 0.0f;
+        }
+    }
+    
+    /* RELATIVE: Also consider edge count relative to node count (more edges = more learning) */
+    /* More edges per node suggests more mature patterns */
+    float edge_density_factor = 0.0f;
+    if (input_count > 0) {
+        float edges_per_node = (float)total_edge_count / (float)input_count;
+        /* Normalize: more edges = higher factor, but relative to what's typical */
+        /* Use input_count as context (more nodes = more opportunities for edges) */
+        float density_context = (float)input_count;  /* Context from data */
+        edge_density_factor = edges_per_node / (edges_per_node + density_context);
+    }
+    
+    /* RELATIVE: Combine weight maturity with edge density (both from data) */
+    /* Weight factor represents strength, density factor represents pattern richness */
+    /* Combine using relative weighting based on available data */
+    float combined_readiness = 0.0f;
+    if (edge_density_factor > 0.0f && relative_readiness > 0.0f) {
+        /* Both factors available: combine relative to their magnitudes */
+        float weight_factor_ratio = relative_readiness / (relative_readiness + edge_density_factor);
+        float density_factor_ratio = edge_density_factor / (relative_readiness + edge_density_factor);
+        combined_readiness = (relative_readiness * weight_factor_ratio) + 
+                           (edge_density_factor * density_factor_ratio);
+    } else if (relative_readiness > 0.0f) {
+        /* Only weight factor available */
+        combined_readiness = relative_readiness;
+    } else if (edge_density_factor > 0.0f) {
+        /* Only density factor available */
+        combined_readiness = edge_density_factor;
+    }
+    
+    return combined_readiness;  /* 0.0-1.0 range, fully data-driven */
+}
+
+/* ========================================
+ * READ-ONLY QUERY
+ * ======================================== */
+
+/* READ-ONLY: Query-local activation state for one node */
+/* Mirrors the node fields a learning call would write (activation_strength, incoming_activation_sum) */
+typedef struct QueryActivation {
+    Node *node;
+    float activation;   /* Query-local activation_strength */
+    float input_sum;    /* Query-local weighted input (incoming_activation_sum) */
+    bool seeded;        /* Matched the input directly - activation comes from the match */
+} QueryActivation;
+
+/* READ-ONLY: Everything a query produces lives here, never in the graph */
+typedef struct QueryState {
+    QueryActivation *entries;  /* Open addressing keyed by node pointer (power-of-2 capacity) */
+    size_t capacity;
+    size_t count;
+    uint64_t deadline_us;      /* Absolute monotonic deadline (0 = none) */
+    bool truncated;            /* Deadline hit - output is best-so-far */
+    MelvinRng rng;             /* SAMPLING: Private stream (the brain's stream is never advanced) */
+} QueryState;
+
+static size_t query_slot(const QueryState *q, Node *node) {
+    uintptr_t ptr = (uintptr_t)node;
+    return (size_t)(ptr ^ (ptr >> 16)) & (q->capacity - 1);
+}
+
+static QueryActivation* query_state_lookup(const QueryState *q, Node *node) {
+    if (!q || !node || q->capacity == 0) return NULL;
+    for (size_t slot = query_slot(q, node); q->entries[slot].node; slot = (slot + 1) & (q->capacity - 1)) {
+        if (q->entries[slot].node == node) return &q->entries[slot];
+    }
+    return NULL;
+}
+
+/* Find or insert a node's entry (pointer is valid until the next insert) */
+static QueryActivation* query_state_get_or_add(QueryState *q, Node *node) {
+    if (!q || !node) return NULL;
+    
+    QueryActivation *entry = query_state_lookup(q, node);
+    if (entry) return entry;
+    
+    /* Keep load at or below 50% (Minimal context: start at 1, grows with the query) */
+    if ((q->count + 1) * 2 > q->capacity) {
+        size_t new_capacity = (q->capacity == 0) ? 1 : q->capacity;
+        while ((q->count + 1) * 2 > new_capacity) new_capacity *= 2;
+        
+        QueryActivation *new_entries = (QueryActivation*)calloc(new_capacity, sizeof(QueryActivation));
+        if (!new_entries) return NULL;
+        QueryActivation *old_entries = q->entries;
+        size_t old_capacity = q->capacity;
+        q->entries = new_entries;
+        q->capacity = new_capacity;
+        for (size_t i = 0; i < old_capacity; i++) {
+            if (!old_entries[i].node) continue;
+            size_t slot = query_slot(q, old_entries[i].node);
+            while (q->entries[slot].node) slot = (slot + 1) & (q->capacity - 1);
+            q->entries[slot] = old_entries[i];
+        }
+        free(old_entries);
+    }
+    
+    size_t slot = query_slot(q, node);
+    while (q->entries[slot].node) slot = (slot + 1) & (q->capacity - 1);
+    q->entries[slot].node = node;
+    q->count++;
+    return &q->entries[slot];
+}
+
+/* Activation as seen by this query: query-local if reached, the node's stored value otherwise */
+static float query_node_activation(const QueryState *q, Node *node) {
+    QueryActivation *entry = query_state_lookup(q, node);
+    return entry ? entry->activation : node->activation_strength;
+}
+
+/* DEADLINE: Query-local check (the graph's deadline flags belong to learning calls) */
+static bool query_deadline_expired(QueryState *q) {
+    if (!q || q->deadline_us == 0) return false;
+    if (!q->truncated && graph_monotonic_us() >= q->deadline_us) q->truncated = true;
+    return q->truncated;
+}
+
+/* READ-ONLY: Find an existing node for a pattern (same lookup order as the learning path) */
+/* Creates nothing - when no prev_node, also looks around the previous input's context */
+static Node* query_find_pattern(MelvinGraph *g, Node *prev_node, Node **sequence, size_t sequence_count,
+                                const uint8_t *pattern, size_t pattern_size) {
+    /* 1. Previous node's local neighbors */
+    if (prev_node) {
+        Node *found = node_find_via_local_neighbors(prev_node, pattern, pattern_size);
+        if (found) return found;
+    }
+    
+    /* 2. Nodes already matched in this input */
+    for (size_t k = 0; k < sequence_count; k++) {
+        if (node_payload_exact_match(sequence[k], pattern, pattern_size)) return sequence[k];
+    }
+    
+    /* 3. Last activated nodes from the previous input (activation context) */
+    for (size_t k = 0; k < g->last_activated_count; k++) {
+        Node *ctx_node = g->last_activated[k];
+        if (ctx_node && node_payload_exact_match(ctx_node, pattern, pattern_size)) return ctx_node;
+    }
+    
+    /* 4. LOCAL-ONLY: Neighbors of that context - a query can't create a starting node, */
+    /* so it looks one step further before giving up on this byte */
+    if (!prev_node) {
+        for (size_t k = 0; k < g->last_activated_count; k++) {
+            Node *found = node_find_via_local_neighbors(g->last_activated[k], pattern, pattern_size);
+            if (found) return found;
+        }
+    }
+    
+    return NULL;
+}
+
+/* READ-ONLY: Segment input into existing nodes (unmatched bytes are skipped, nothing is created) */
+/* Matched nodes are seeded with their match strength; last_activated is read, never written */
+static Node** query_segment_input(MelvinGraph *g, QueryState *q, const uint8_t *data, size_t data_size,
+                                  size_t *out_count) {
+    *out_count = 0;
+    
+    Node **sequence = NULL;
+    size_t sequence_count = 0;
+    size_t sequence_capacity = 0;
+    Node *prev_node = NULL;
+    
+    for (size_t i = 0; i < data_size; i++) {
+        /* HIERARCHY-FIRST: Same pattern sizes as wave_process_sequential_patterns */
+        size_t max_pattern_size = data_size - i;
+        if (prev_node && prev_node->payload_size > 1 && prev_node->payload_size < max_pattern_size) {
+            max_pattern_size = prev_node->payload_size;
+        }
+        
+        Node *matched = NULL;
+        size_t matched_size = 0;
+        for (size_t try_size = max_pattern_size; try_size >= 1 && !matched; try_size--) {
+            matched = query_find_pattern(g, prev_node, sequence, sequence_count, data + i, try_size);
+            matched_size = try_size;
+        }
+        if (!matched) continue;  /* Unknown to the graph - learning would create it, a query can't */
+        
+        QueryActivation *entry = query_state_get_or_add(q, matched);
+        if (!entry) break;
+        if (!entry->seeded) {
+            entry->seeded = true;
+            entry->activation = node_calculate_match_strength(matched, data + i, matched_size);
+        }
+        
+        if (sequence_count >= sequence_capacity) {
+            sequence_capacity = (sequence_capacity == 0) ? 1 : sequence_capacity * 2;  /* Minimal context: start at 1 */
+            Node **new_sequence = (Node**)realloc(sequence, sequence_capacity * sizeof(Node*));
+            if (!new_sequence) break;
+            sequence = new_sequence;
+        }
+        sequence[sequence_count++] = matched;
+        prev_node = matched;
+    }
+    
+    *out_count = sequence_count;
+    return sequence;
+}
+
+/* READ-ONLY: Wave propagation into query-local state (no weight updates, no edge/hierarchy formation) */
+/* Same gating as wave_propagate_from_node_bounded; honours fanout_k, frontier_cap and the deadline */
+static void query_propagate(MelvinGraph *g, QueryState *q, Node **seeds, size_t seed_count) {
+    VisitedSet *visited = visited_set_create(calculate_optimal_hash_size(g->node_count));
+    Node **wave_front = (Node**)malloc(seed_count * sizeof(Node*));
+    if (!visited || !wave_front) {
+        if (visited) visited_set_free(visited);
+        free(wave_front);
+        return;
+    }
+    
+    size_t wave_front_size = 0;
+    float initial_energy = 0.0f;
+    for (size_t i = 0; i < seed_count; i++) {
+        if (visited_set_contains(visited, seeds[i])) continue;  /* Repeated in input */
+        visited_set_add(visited, seeds[i]);
+        wave_front[wave_front_size++] = seeds[i];
+        initial_energy += seeds[i]->weight;
+    }
+    float previous_energy = initial_energy;
+    
+    /* Scratch reused across nodes (grows to the largest out-degree seen) */
+    float *edge_outputs = NULL;
+    size_t *selected = NULL;
+    size_t scratch_capacity = 0;
+    
+    while (wave_front_size > 0 && !query_deadline_expired(q)) {
+        Node **next_wave_front = NULL;
+        size_t next_size = 0;
+        size_t next_capacity = 0;
+        float current_energy = 0.0f;
+        bool out_of_memory = false;
+        
+        for (size_t i = 0; i < wave_front_size && !out_of_memory; i++) {
+            if (query_deadline_expired(q)) break;
+            
+            Node *node = wave_front[i];
+            QueryActivation *entry = query_state_get_or_add(q, node);
+            if (!entry) break;
+            
+            /* Seeds keep their match strength; reached nodes compute from query-local input */
+            float activation = entry->seeded ? entry->activation :
+                               node_activation_from_input(node, fmaxf(entry->input_sum, 0.0f), NULL);
+            
+            /* SMOOTH: Same propagation probability as the learning path */
+            float local_avg = node_get_local_outgoing_weight_avg(node);
+            float propagation_threshold = (local_avg > 0.0f) ? 
+                                         local_avg / (local_avg + 1.0f) : 
+                                         (node->weight > 0.0f ? node->weight / (node->weight + 1.0f) : 0.0f);
+            float propagation_probability = activation / (activation + propagation_threshold + 1.0f);
+            if (propagation_probability < 0.1f) {
+                entry->activation = activation;
+                continue;  /* Too weak to propagate */
+            }
+            activation *= propagation_probability;
+            entry->activation = activation;  /* entry is not used past this point (inserts may move it) */
+            
+            size_t degree = node->outgoing_count;
+            if (degree == 0) continue;
+            if (degree > scratch_capacity) {
+                float *new_outputs = (float*)realloc(edge_outputs, degree * sizeof(float));
+                if (new_outputs) edge_outputs = new_outputs;
+                size_t *new_selected = (size_t*)realloc(selected, degree * sizeof(size_t));
+                if (new_selected) selected = new_selected;
+                if (!new_outputs || !new_selected) break;
+                scratch_capacity = degree;
+            }
+            
+            for (size_t j = 0; j < degree; j++) {
+                Edge *edge = node->outgoing_edges[j];
+                edge_outputs[j] = (edge && edge->to_node) ? edge_transform_activation(edge, activation) : 0.0f;
+                selected[j] = j;
+            }
+            
+            /* SPARSE PROPAGATION: Only the fanout_k strongest outputs propagate */
+            size_t candidate_count = degree;
+            if (g->propagation_fanout_k > 0 && g->propagation_fanout_k < degree) {
+                select_top_k_indices(edge_outputs, selected, degree, g->propagation_fanout_k);
+                candidate_count = g->propagation_fanout_k;
+            }
+            
+            for (size_t c = 0; c < candidate_count; c++) {
+                size_t j = selected[c];
+                if (edge_outputs[j] <= 0.0f) continue;  /* Any positive output activates */
+                Node *target = node->outgoing_edges[j]->to_node;
+                
+                QueryActivation *target_entry = query_state_get_or_add(q, target);
+                if (!target_entry) {
+                    out_of_memory = true;
+                    break;
+                }
+                target_entry->input_sum += edge_outputs[j];
+                if (!target_entry->seeded) {
+                    target_entry->activation = node_activation_from_input(target, target_entry->input_sum, NULL);
+                }
+                current_energy += target->weight;
+                
+                if (visited_set_contains(visited, target)) continue;
+                visited_set_add(visited, target);
+                if (next_size >= next_capacity) {
+                    next_capacity = (next_capacity == 0) ? 1 : next_capacity * 2;  /* Minimal context: start at 1 */
+                    Node **new_front = (Node**)realloc(next_wave_front, next_capacity * sizeof(Node*));
+                    if (!new_front) {
+                        out_of_memory = true;
+                        break;
+                    }
+                    next_wave_front = new_front;
+                }
+                next_wave_front[next_size++] = target;
+            }
+        }
+        
+        free(wave_front);
+        wave_front = next_wave_front;
+        wave_front_size = out_of_memory ? 0 : next_size;
+        
+        /* SPARSE PROPAGATION: Cap next wave front to the strongest query-local activations */
+        if (g->propagation_frontier_cap > 0 && wave_front_size > g->propagation_frontier_cap) {
+            float *scores = (float*)malloc(wave_front_size * sizeof(float));
+            if (scores) {
+                for (size_t i = 0; i < wave_front_size; i++) {
+                    scores[i] = query_node_activation(q, wave_front[i]);
+                }
+                wave_front_size = wave_front_keep_top_scores(wave_front, scores, wave_front_size,
+                                                             g->propagation_frontier_cap);
+                free(scores);
+            }
+        }
+        
+        /* RELATIVE: Same energy convergence rule as the learning path */
+        float energy_change = (previous_energy > 0.0f) ? 
+                             (current_energy - previous_energy) / previous_energy : 0.0f;
+        float energy_ratio = (initial_energy > 0.0f) ? current_energy / initial_energy : 1.0f;
+        if (energy_change < 0.0f && energy_ratio < (1.0f - energy_change)) break;
+        previous_energy = current_energy;
+        initial_energy = current_energy;
+    }
+    
+    free(wave_front);
+    free(edge_outputs);
+    free(selected);
+    visited_set_free(visited);
+}
+
+/* ========================================
+ * OUTPUT SAMPLING (scratch arena, alias tables)
+ * ======================================== */
+
+/* SAMPLING: Candidate arrays for one output generation, reused by every step (grows, never shrinks) */
+/* DECODING: Candidate rank for nucleus truncation */
+typedef struct OutputRank {
+    float prob;
+    uint32_t index;
+} OutputRank;
+
+typedef struct OutputScratch {
+    Node **nodes;
+    float *probs;
+    uint32_t *work;   /* Alias construction worklist */
+    OutputRank *ranks;
+    size_t capacity;
+} OutputScratch;
+
+static bool output_scratch_reserve(OutputScratch *scratch, size_t count) {
+    if (count <= scratch->capacity) return true;
+    size_t capacity = (scratch->capacity == 0) ? 1 : scratch->capacity;  /* Minimal context: start at 1 */
+    while (capacity < count) capacity *= 2;
+    
+    Node **nodes = (Node**)realloc(scratch->nodes, capacity * sizeof(Node*));
+    if (nodes) scratch->nodes = nodes;
+    float *probs = (float*)realloc(scratch->probs, capacity * sizeof(float));
+    if (probs) scratch->probs = probs;
+    uint32_t *work = (uint32_t*)realloc(scratch->work, capacity * sizeof(uint32_t));
+    if (work) scratch->work = work;
+    OutputRank *ranks = (OutputRank*)realloc(scratch->ranks, capacity * sizeof(OutputRank));
+    if (ranks) scratch->ranks = ranks;
+    if (!nodes || !probs || !work || !ranks) return false;
+    
+    scratch->capacity = capacity;
+    return true;
+}
+
+static void output_scratch_free(OutputScratch *scratch) {
+    free(scratch->nodes);
+    free(scratch->probs);
+    free(scratch->work);
+    free(scratch->ranks);
+}
+
+/* SAMPLING: log2 for positive normal floats (exponent bits + quartic on the mantissa, |error| < 2.1e-4) */
+static inline float output_fast_log2(float x) {
+    union { float f; uint32_t u; } v = { x };
+    float exponent = (float)((int32_t)(v.u >> 23) - 127);
+    v.u = (v.u & 0x007FFFFFu) | 0x3F800000u;  /* Mantissa in [1, 2) */
+    float m = v.f;
+    return exponent + (-2.4967737f + m * (4.0283726f + m * (-2.0810600f + m * (0.62881564f - 0.07915035f * m))));
+}
+
+/* SAMPLING: 2^x (integer part into the exponent bits, quartic on the fraction, rel. error < 5.3e-6) */
+static inline float output_fast_exp2(float x) {
+    if (x < -126.0f) return 0.0f;
+    if (x > 127.0f) x = 127.0f;
+    float whole = floorf(x);
+    float f = x - whole;
+    union { float f; uint32_t u; } v;
+    v.f = 1.0000053f + f * (0.69297428f + f * (0.24150880f + f * (0.051989599f + f * 0.013511545f)));
+    v.u += (uint32_t)(int32_t)whole << 23;  /* Scale by 2^whole (wraps for negative whole) */
+    return v.f;
+}
+
+/* SAMPLING: Temperature scaling x^(1/T) without powf (values below FLT_MIN round to 0) */
+static inline float output_fast_temper(float x, float exponent) {
+    if (x < FLT_MIN) return 0.0f;
+    return output_fast_exp2(exponent * output_fast_log2(x));
+}
+
+/* SAMPLING: 1/temperature on a 1/32 grid, so slowly drifting temperatures share a tempered table */
+static inline float output_quantize_exponent(float temperature) {
+    return roundf(32.0f / temperature) / 32.0f;
+}
+
+/* Temperature-free candidate scores of a node's outgoing edges (all targets, visited or not) */
+/* edge_transform_activation is linear in its input, so the source activation is a common factor */
+/* of every candidate and cancels when the distribution is normalized - scores use activation 1 */
+static size_t output_score_candidates(Node *current, Node **targets, float *base) {
+    float local_outgoing_avg = node_get_local_outgoing_weight_avg(current);
+    size_t count = 0;
+    for (size_t i = 0; i < current->outgoing_count; i++) {
+        Edge *edge = current->outgoing_edges[i];
+        if (!edge || !edge->to_node) continue;
+        
+        /* SMOOTH: Same co-activation share and weak-edge cutoff as exact sampling */
+        float weight = edge_get_decayed_weight(edge);
+        float weight_relative = (local_outgoing_avg > 0.0f) ?
+            weight / (weight + local_outgoing_avg) :
+            ((weight > 0.0f) ? weight / (weight + 1.0f) : 0.0f);
+        if (weight_relative < 0.01f) continue;
+        
+        float score = edge_transform_activation(edge, 1.0f) * weight_relative;
+        if (score <= 0.0f) continue;
+        targets[count] = edge->to_node;
+        base[count] = score;
+        count++;
+    }
+    return count;
+}
+
+/* Vose's alias construction over weights[0..count) summing to total (work: count slots) */
+static void output_alias_build(const float *weights, size_t count, float total,
+                               float *prob, uint32_t *alias, uint32_t *work) {
+    /* Small slots fill work from the front, large slots from the back */
+    size_t small = 0, large = count;
+    float scale = (float)count / total;
+    for (size_t i = 0; i < count; i++) {
+        prob[i] = weights[i] * scale;
+        alias[i] = (uint32_t)i;
+        if (prob[i] < 1.0f) work[small++] = (uint32_t)i;
+        else work[--large] = (uint32_t)i;
+    }
+    size_t small_top = small;
+    size_t large_top = large;
+    while (small_top > 0 && large_top < count) {
+        uint32_t s = work[--small_top];
+        uint32_t l = work[large_top];
+        alias[s] = l;
+        prob[l] -= 1.0f - prob[s];
+        if (prob[l] < 1.0f) {
+            large_top++;
+            work[small_top++] = l;  /* l is now small (slot s was just freed) */
+        }
+    }
+    /* Leftovers are full slots up to rounding */
+    while (large_top < count) prob[work[large_top++]] = 1.0f;
+    while (small_top > 0) prob[work[--small_top]] = 1.0f;
+}
+
+/* Temper the table's scores for exponent and rebuild its alias slots */
+static bool output_alias_temper(OutputAliasTable *table, float exponent, uint32_t *work) {
+    table->total = 0.0f;
+    for (size_t i = 0; i < table->count; i++) {
+        table->tempered[i] = output_fast_temper(table->base[i], exponent);
+        table->total += table->tempered[i];
+    }
+    table->exponent = exponent;
+    if (table->total <= 0.0f) return false;
+    output_alias_build(table->tempered, table->count, table->total, table->prob, table->alias, work);
+    return true;
+}
+
+/* Cached, tempered alias table for a node (rebuilt when stale) - NULL when it has no candidates */
+/* READ-ONLY: Queries only use a table that is already current; they never build or re-temper */
+static OutputAliasTable* output_alias_get(Node *current, float exponent, OutputScratch *scratch) {
+    OutputAliasTable *table = current->output_alias;
+    if (table && table->valid && table->exponent == exponent) {
+        return (table->count > 0 && table->total > 0.0f) ? table : NULL;
+    }
+    if (tls_read_only_query) return NULL;
+    
+    if (!table) {
+        table = (OutputAliasTable*)calloc(1, sizeof(OutputAliasTable));
+        if (!table) return NULL;
+        current->output_alias = table;
+    }
+    if (!table->valid) {
+        size_t degree = current->outgoing_count;
+        if (degree > table->capacity) {
+            Node **targets = (Node**)realloc(table->targets, degree * sizeof(Node*));
+            if (targets) table->targets = targets;
+            float *base = (float*)realloc(table->base, degree * sizeof(float));
+            if (base) table->base = base;
+            float *tempered = (float*)realloc(table->tempered, degree * sizeof(float));
+            if (tempered) table->tempered = tempered;
+            float *prob = (float*)realloc(table->prob, degree * sizeof(float));
+            if (prob) table->prob = prob;
+            uint32_t *alias = (uint32_t*)realloc(table->alias, degree * sizeof(uint32_t));
+            if (alias) table->alias = alias;
+            if (!targets || !base || !tempered || !prob || !alias) return NULL;
+            table->capacity = degree;
+        }
+        table->count = output_score_candidates(current, table->targets, table->base);
+        table->exponent = 0.0f;
+        table->valid = true;
+    }
+    if (table->count == 0) return NULL;
+    if (!output_scratch_reserve(scratch, table->count)) return NULL;
+    return output_alias_temper(table, exponent, scratch->work) ? table : NULL;
+}
+
+/* Cumulative draw over tempered weights, skipping visited targets (self-loops allowed) */
+static Node* output_sample_linear(Node *current, Node **targets, const float *tempered, size_t count,
+                                  VisitedSet *visited, MelvinRng *rng) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < count; i++) {
+        if (targets[i] != current && visited_set_contains(visited, targets[i])) continue;
+        sum += tempered[i];
+    }
+    if (sum <= 0.0f) return NULL;
+    
+    float r = melvin_rng_float(rng) * sum;
+    float cumsum = 0.0f;
+    Node *last = NULL;
+    for (size_t i = 0; i < count; i++) {
+        if (targets[i] != current && visited_set_contains(visited, targets[i])) continue;
+        if (tempered[i] <= 0.0f) continue;
+        cumsum += tempered[i];
+        last = targets[i];
+        if (r < cumsum) return last;
+    }
+    return last;  /* Rounding left r at the very top */
+}
+
+/* SAMPLING: One fast generation step from current (NULL = no unvisited candidate) */
+/* Hot nodes draw in O(1) from their alias table; a visited draw is rejected and redrawn, which */
+/* samples the unvisited candidates in proportion, and after a few rejections the step falls back */
+/* to one linear draw over the table. Other nodes are scored into the scratch arena. */
+static Node* output_sample_fast(MelvinGraph *g, Node *current, float activation, float exponent,
+                                VisitedSet *visited, OutputScratch *scratch, MelvinRng *rng) {
+    /* Transform is linear in activation: no positive activation = no positive candidate */
+    if (!(activation > 0.0f) || current->outgoing_count == 0) return NULL;
+    
+    if (current->outgoing_count >= g->output_alias_min_degree) {
+        OutputAliasTable *table = output_alias_get(current, exponent, scratch);
+        if (table) {
+            for (int attempt = 0; attempt < 4; attempt++) {
+                uint64_t bits = melvin_rng_next(rng);
+                size_t slot = (size_t)(((bits >> 32) * (uint64_t)table->count) >> 32);
+                float coin = (float)(bits & 0xFFFFFFu) * (1.0f / 16777216.0f);
+                Node *next = table->targets[(coin < table->prob[slot]) ? slot : table->alias[slot]];
+                if (next == current || !visited_set_contains(visited, next)) return next;
+            }
+            return output_sample_linear(current, table->targets, table->tempered, table->count, visited, rng);
+        }
+        if (!tls_read_only_query) return NULL;  /* Table is current and empty (or out of memory) */
+    }
+    
+    if (!output_scratch_reserve(scratch, current->outgoing_count)) return NULL;
+    size_t count = output_score_candidates(current, scratch->nodes, scratch->probs);
+    for (size_t i = 0; i < count; i++) {
+        scratch->probs[i] = output_fast_temper(scratch->probs[i], exponent);
+    }
+    return output_sample_linear(current, scratch->nodes, scratch->probs, count, visited, rng);
+}
+
+/* ========================================
+ * DECODING MODES (nucleus, beam, hard caps)
+ * ======================================== */
+
+/* Descending probability, then original position (deterministic under ties) */
+static int output_rank_compare(const void *a, const void *b) {
+    const OutputRank *ra = (const OutputRank*)a;
+    const OutputRank *rb = (const OutputRank*)b;
+    if (ra->prob != rb->prob) return (ra->prob > rb->prob) ? -1 : 1;
+    return (ra->index > rb->index) - (ra->index < rb->index);
+}
+
+static int output_rank_compare_index(const void *a, const void *b) {
+    const OutputRank *ra = (const OutputRank*)a;
+    const OutputRank *rb = (const OutputRank*)b;
+    return (ra->index > rb->index) - (ra->index < rb->index);
+}
+
+/* DECODING: Keep the top_k most likely candidates that first reach top_p of the mass */
+/* Survivors stay in their original order (compacted in place); returns how many remain */
+static size_t output_nucleus(Node **nodes, float *probs, size_t count, size_t top_k, float top_p,
+                             OutputRank *ranks) {
+    float total = 0.0f;
+    for (size_t i = 0; i < count; i++) {
+        ranks[i].prob = probs[i];
+        ranks[i].index = (uint32_t)i;
+        total += probs[i];
+    }
+    qsort(ranks, count, sizeof(OutputRank), output_rank_compare);
+    
+    size_t keep = count;
+    if (top_k > 0 && top_k < keep) keep = top_k;
+    if (top_p > 0.0f && top_p < 1.0f) {
+        float mass = 0.0f;
+        for (size_t i = 0; i < keep; i++) {
+            mass += ranks[i].prob;
+            if (mass >= top_p * total) {
+                keep = i + 1;
+                break;
+            }
+        }
+    }
+    if (keep == count) return count;
+    
+    /* Ascending indices: each survivor moves to a slot at or before its own */
+    qsort(ranks, keep, sizeof(OutputRank), output_rank_compare_index);
+    for (size_t j = 0; j < keep; j++) {
+        nodes[j] = nodes[ranks[j].index];
+        probs[j] = probs[ranks[j].index];
+    }
+    return keep;
+}
+
+/* DECODING: One step of a beam path - paths share prefixes through parent links */
+typedef struct OutputBeamStep {
+    Node *node;
+    size_t parent;    /* History index of the previous step (SIZE_MAX = start node) */
+    size_t depth;     /* Steps taken after the start node */
+    size_t bytes;     /* Output bytes along the path, start payload included */
+    float log_prob;   /* Sum of per-step log-probabilities */
+} OutputBeamStep;
+
+/* Length-normalized path score (mean step log-probability; the bare start scores 0) */
+static inline float output_beam_score(const OutputBeamStep *step) {
+    return (step->depth > 0) ? step->log_prob / (float)step->depth : 0.0f;
 }
 
-/* Fill blank node with payload when pattern matches (relative to match strength) */
-/* Returns new node with filled payload, original blank_node unchanged */
-Node* node_fill_blank(Node *blank_node, const uint8_t *pattern, size_t pattern_size, float match_strength) {
-    if (!blank_node || !pattern || pattern_size == 0 || match_strength <= 0.0f) return NULL;
-    
-    /* Fill size relative to match strength */
-    size_t fill_size = (size_t)(pattern_size * match_strength);
-    if (fill_size == 0) fill_size = 1;
-    
-    /* Create new node with filled payload (relative to match strength) */
-    Node *filled_node = node_create(pattern, fill_size);
-    if (!filled_node) return NULL;
-    
-    /* Weight relative to match strength and original blank weight */
-    filled_node->weight = (blank_node->weight + match_strength) / 2.0f;
-    
-    return filled_node;
+/* Highest log-probability first; ties by parent, then target id (deterministic) */
+static int output_beam_compare(const void *a, const void *b) {
+    const OutputBeamStep *sa = (const OutputBeamStep*)a;
+    const OutputBeamStep *sb = (const OutputBeamStep*)b;
+    if (sa->log_prob != sb->log_prob) return (sa->log_prob > sb->log_prob) ? -1 : 1;
+    if (sa->parent != sb->parent) return (sa->parent < sb->parent) ? -1 : 1;
+    return memcmp(sa->node->id, sb->node->id, sizeof(sa->node->id));
 }
 
-/* Compute output readiness based on pattern maturity (relative to local context) */
-/* DATA-DRIVEN: Uses edge existence and strength to measure learned patterns */
-/* Returns relative readiness score (0.0-1.0) where higher = more mature patterns */
-/* Following README principle: all thresholds relative to local context, no hardcoded values */
-float compute_output_readiness(MelvinGraph *g, Node **input_nodes, size_t input_count) {
-    if (!g || !input_nodes || input_count == 0) return 0.0f;
-    
-    /* Measure sequential edge strength from input nodes */
-    float total_edge_weight = 0.0f;
-    size_t total_edge_count = 0;
-    float max_edge_weight = 0.0f;
-    float min_edge_weight = FLT_MAX;
-    
-    /* Also collect local context from nodes (for relative comparison) */
-    float total_local_avg = 0.0f;
-    size_t nodes_with_context = 0;
-    
-    /* For each input node, measure strength of outgoing edges */
-    /* Outgoing edges represent learned sequential patterns (what comes next) */
-    for (size_t i = 0; i < input_count; i++) {
-        Node *node = input_nodes[i];
-        if (!node) continue;
-        
-        /* Get local context for this node (data-driven threshold basis) */
-        float local_avg = node_get_local_outgoing_weight_avg(node);
-        if (local_avg > 0.0f) {
-            total_local_avg += local_avg;
-            nodes_with_context++;
-        }
-        
-        /* Examine ALL outgoing edges - any edge represents learning */
-        for (size_t j = 0; j < node->outgoing_count; j++) {
-            Edge *edge = node->outgoing_edges[j];
-            if (!edge) continue;
+/* Was node already emitted on the path ending at history[index]? (paths are step-capped, so short) */
+/* The start node is not pre-marked, same as the sampling walk's visited set */
+static bool output_beam_path_contains(const OutputBeamStep *history, size_t index, const Node *node) {
+    for (; history[index].parent != SIZE_MAX; index = history[index].parent) {
+        if (history[index].node == node) return true;
+    }
+    return false;
+}
+
+/* Does history[candidate] beat history[best]? (best = SIZE_MAX: no path yet) */
+static inline bool output_beam_better(const OutputBeamStep *history, size_t candidate, size_t best) {
+    if (history[candidate].depth == 0) return false;
+    return best == SIZE_MAX || output_beam_score(&history[candidate]) > output_beam_score(&history[best]);
+}
+
+static bool output_beam_push(OutputBeamStep **items, size_t *count, size_t *capacity, OutputBeamStep step) {
+    if (*count >= *capacity) {
+        size_t new_capacity = (*capacity == 0) ? 1 : *capacity * 2;  /* Minimal context: start at 1 */
+        OutputBeamStep *grown = (OutputBeamStep*)realloc(*items, new_capacity * sizeof(OutputBeamStep));
+        if (!grown) return false;
+        *items = grown;
+        *capacity = new_capacity;
+    }
+    (*items)[(*count)++] = step;
+    return true;
+}
+
+/* DECODING: Deterministic beam search from start - returns the best path's nodes after start */
+/* (malloc'd, caller frees; NULL with *path_length 0 when nothing follows start) */
+/* Every beam extends by each unvisited candidate (self-loops allowed, as in sampling), scored with */
+/* the same tempered distribution; the beam_width most likely extensions survive each step. Paths */
+/* that run out of candidates or bytes are final; the best mean log-probability path wins. */
+static Node** output_beam_search(MelvinGraph *g, QueryState *q, Node *start, size_t start_bytes,
+                                 float temperature, const MelvinDecodeConfig *decode,
+                                 OutputScratch *scratch, size_t *path_length) {
+    *path_length = 0;
+    size_t width = (decode->beam_width > 0) ? decode->beam_width : 1;
+    size_t max_steps = (decode->max_steps > 0) ? decode->max_steps : MELVIN_DECODE_BEAM_DEFAULT_STEPS;
+    
+    OutputBeamStep *history = NULL;
+    size_t history_count = 0, history_capacity = 0;
+    OutputBeamStep *expansions = NULL;
+    size_t expansion_count = 0, expansion_capacity = 0;
+    size_t *beams = (size_t*)malloc(width * sizeof(size_t));
+    if (!beams) return NULL;
+    
+    OutputBeamStep root = { start, SIZE_MAX, 0, start_bytes, 0.0f };
+    size_t best = SIZE_MAX;
+    size_t beam_count = 0;
+    if (output_beam_push(&history, &history_count, &history_capacity, root)) {
+        beams[beam_count++] = 0;
+    }
+    
+    for (size_t step = 1; step <= max_steps && beam_count > 0; step++) {
+        if (q ? query_deadline_expired(q) : graph_deadline_expired(g)) break;
+        
+        expansion_count = 0;
+        float exponent = 1.0f / temperature;
+        for (size_t b = 0; b < beam_count; b++) {
+            size_t index = beams[b];
+            OutputBeamStep from = history[index];
+            Node *node = from.node;
+            float activation = q ? query_node_activation(q, node) : node->activation_strength;
             
-            total_edge_weight += edge->weight;
-            total_edge_count++;
+            size_t count = 0;
+            bool room = (decode->max_bytes == 0 || from.bytes < decode->max_bytes);
+            if (room && activation > 0.0f && output_scratch_reserve(scratch, node->outgoing_count)) {
+                count = output_score_candidates(node, scratch->nodes, scratch->probs);
+            }
             
-            /* Track maximum and minimum edge weight (for relative comparison) */
-            if (edge->weight > max_edge_weight) {
-                max_edge_weight = edge->weight;
+            /* Same tempered distribution as sampling, over this path's unvisited candidates */
+            float sum = 0.0f;
+            for (size_t i = 0; i < count; i++) {
+                Node *target = scratch->nodes[i];
+                bool open = (target == node) || !output_beam_path_contains(history, index, target);
+                scratch->probs[i] = open ? powf(scratch->probs[i], exponent) : 0.0f;
+                sum += scratch->probs[i];
             }
-            if (edge->weight < min_edge_weight) {
-                min_edge_weight = edge->weight;
+            
+            if (sum <= 0.0f) {
+                /* Path is complete - keep it if it beats the best complete path so far */
+                if (output_beam_better(history, index, best)) best = index;
+                continue;
             }
+            for (size_t i = 0; i < count; i++) {
+                if (scratch->probs[i] <= 0.0f) continue;
+                Node *target = scratch->nodes[i];
+                OutputBeamStep next = { target, index, from.depth + 1, from.bytes + target->payload_size,
+                                        from.log_prob + logf(scratch->probs[i] / sum) };
+                if (!output_beam_push(&expansions, &expansion_count, &expansion_capacity, next)) break;
+            }
+        }
+        
+        /* Keep the width most likely extensions as the next beams */
+        size_t keep = (expansion_count < width) ? expansion_count : width;
+        if (keep < expansion_count) {
+            qsort(expansions, expansion_count, sizeof(OutputBeamStep), output_beam_compare);
+        }
+        beam_count = 0;
+        for (size_t i = 0; i < keep; i++) {
+            if (!output_beam_push(&history, &history_count, &history_capacity, expansions[i])) break;
+            beams[beam_count++] = history_count - 1;
         }
+        
+        /* Same gradual temperature rise as the sampling walk */
+        float temp_increase = 1.0f / ((float)step + 1.0f);
+        temperature *= (1.0f + temp_increase * 0.01f);
+        if (temperature > 1.5f) temperature = 1.5f;
     }
     
-    /* If no edges exist, pattern is completely novel - no output readiness */
-    if (total_edge_count == 0) return 0.0f;
-    
-    /* Average edge weight represents pattern maturity */
-    float avg_edge_weight = total_edge_weight / (float)total_edge_count;
-    
-    /* RELATIVE: Compute threshold context from actual data, not hardcoded values */
-    /* Use local averages as context - this is what nodes "know" about their neighborhood */
-    float local_context = 0.0f;
-    if (nodes_with_context > 0) {
-        local_context = total_local_avg / (float)nodes_with_context;
+    /* Beams still open at the cap compete with the complete paths */
+    for (size_t b = 0; b < beam_count; b++) {
+        if (output_beam_better(history, beams[b], best)) best = beams[b];
     }
     
-    /* If no local context available, use edge weight range as context */
-    if (local_context <= 0.0f && max_edge_weight > min_edge_weight) {
-        local_context = (max_edge_weight + min_edge_weight) / 2.0f;  /* Midpoint of range */
+    Node **path = NULL;
+    size_t length = (best != SIZE_MAX) ? history[best].depth : 0;
+    if (length > 0) path = (Node**)malloc(length * sizeof(Node*));
+    if (path) {
+        size_t index = best;
+        for (size_t i = length; i > 0; i--) {
+            path[i - 1] = history[index].node;
+            index = history[index].parent;
+        }
+        *path_length = length;
     }
     
-    /* If still no context, use max_edge_weight as minimal context */
-    if (local_context <= 0.0f && max_edge_weight > 0.0f) {
-        local_context = max_edge_weight;
+    free(history);
+    free(expansions);
+    free(beams);
+    return path;
+}
+
+/* Append a node's payload to the output, clipped at max_bytes (0 = uncapped) */
+/* *more turns false once the cap is reached or the stream consumer stops */
+/* Returns false when out of memory (the output is then freed and emptied) */
+static bool output_append_payload(Node *node, uint8_t **output, size_t *output_size, size_t *output_capacity,
+                                  size_t max_bytes, OutputStreamFunc emit, void *emit_ctx, bool *more) {
+    size_t take = node->payload_size;
+    if (max_bytes > 0 && *output_size + take >= max_bytes) {
+        take = max_bytes - *output_size;
+        *more = false;
+    }
+    if (take == 0) return true;
+    
+    size_t new_size = *output_size + take;
+    if (new_size > *output_capacity) {
+        *output_capacity = (*output_capacity == 0) ? take * 2 : *output_capacity * 2;
+        if (*output_capacity < new_size) *output_capacity = new_size * 2;  /* Large node */
+        uint8_t *grown = (uint8_t*)realloc(*output, *output_capacity);
+        if (!grown) {
+            free(*output);
+            *output = NULL;
+            *output_size = 0;
+            return false;
+        }
+        *output = grown;
+    }
+    node_payload_read(node, 0, *output + *output_size, take);
+    if (emit && !emit(*output + *output_size, take, emit_ctx)) *more = false;
+    *output_size = new_size;
+    return true;
+}
+
+static void wave_collect_output_core(MelvinGraph *g, QueryState *q, MelvinRng *rng, Node **direct_input_nodes,
+                                     size_t direct_input_count, const MelvinDecodeConfig *decode,
+                                     OutputStreamFunc emit, void *emit_ctx, uint8_t **output, size_t *output_size);
+
+/* ========================================
+ * OUTPUT MEMOIZATION (LRU keyed by start node, context, structure)
+ * ======================================== */
+
+/* MEMOIZATION: Bound the cache to capacity outputs (0 = off). Existing entries are dropped, */
+/* counters are kept. Learning calls only - read-only queries never consult or fill it */
+bool graph_set_output_cache(MelvinGraph *g, size_t capacity) {
+    if (!g) return false;
+    
+    output_cache_free(g->output_cache);
+    g->output_cache = NULL;
+    if (capacity == 0) return true;
+    
+    OutputCache *cache = (OutputCache*)calloc(1, sizeof(OutputCache));
+    if (!cache) return false;
+    cache->capacity = capacity;
+    cache->newest = SIZE_MAX;
+    cache->oldest = SIZE_MAX;
+    g->output_cache = cache;
+    return true;
+}
+
+/* Field by field (padding inside a caller's config is not compared) */
+static bool output_decode_equal(const MelvinDecodeConfig *a, const MelvinDecodeConfig *b) {
+    return a->mode == b->mode && a->top_k == b->top_k && a->top_p == b->top_p &&
+           a->beam_width == b->beam_width && a->max_bytes == b->max_bytes && a->max_steps == b->max_steps;
+}
+
+static size_t output_cache_bucket(const OutputCache *cache, Node *start, uint64_t context_hash,
+                                  const MelvinDecodeConfig *decode) {
+    uint64_t x = (uint64_t)(uintptr_t)start * 0x9E3779B97F4A7C15ULL ^ context_hash;
+    x ^= (uint64_t)decode->mode * 0xD6E8FEB86659FD93ULL;
+    x ^= (uint64_t)decode->max_bytes * 0xA0761D6478BD642FULL ^ (uint64_t)decode->max_steps;
+    return (size_t)splitmix64_next(&x) & (cache->bucket_count - 1);
+}
+
+/* Entry for (start, context, decode) whatever its structure version, or SIZE_MAX */
+static size_t output_cache_find(const OutputCache *cache, Node *start, uint64_t context_hash,
+                                const MelvinDecodeConfig *decode) {
+    if (cache->count == 0) return SIZE_MAX;
+    size_t i = cache->buckets[output_cache_bucket(cache, start, context_hash, decode)];
+    while (i != SIZE_MAX) {
+        const OutputCacheEntry *e = &cache->entries[i];
+        if (e->start == start && e->context_hash == context_hash && output_decode_equal(&e->decode, decode)) {
+            return i;
+        }
+        i = e->chain;
+    }
+    return SIZE_MAX;
+}
+
+static void output_cache_lru_unlink(OutputCache *cache, size_t i) {
+    OutputCacheEntry *e = &cache->entries[i];
+    if (e->newer != SIZE_MAX) cache->entries[e->newer].older = e->older; else cache->newest = e->older;
+    if (e->older != SIZE_MAX) cache->entries[e->older].newer = e->newer; else cache->oldest = e->newer;
+}
+
+static void output_cache_lru_push(OutputCache *cache, size_t i) {
+    OutputCacheEntry *e = &cache->entries[i];
+    e->newer = SIZE_MAX;
+    e->older = cache->newest;
+    if (cache->newest != SIZE_MAX) cache->entries[cache->newest].newer = i; else cache->oldest = i;
+    cache->newest = i;
+}
+
+static void output_cache_chain_push(OutputCache *cache, size_t i) {
+    OutputCacheEntry *e = &cache->entries[i];
+    size_t bucket = output_cache_bucket(cache, e->start, e->context_hash, &e->decode);
+    e->chain = cache->buckets[bucket];
+    cache->buckets[bucket] = i;
+}
+
+static void output_cache_chain_unlink(OutputCache *cache, size_t i) {
+    OutputCacheEntry *e = &cache->entries[i];
+    size_t *link = &cache->buckets[output_cache_bucket(cache, e->start, e->context_hash, &e->decode)];
+    while (*link != i) link = &cache->entries[*link].chain;
+    *link = e->chain;
+}
+
+/* Slot for a new entry: a fresh one while under capacity (doubling storage on demand), */
+/* otherwise the least recently used entry, unlinked and emptied */
+static size_t output_cache_claim(MelvinGraph *g, OutputCache *cache) {
+    if (cache->count < cache->capacity) {
+        if (cache->count >= cache->entries_capacity) {
+            /* Minimal context: start at 1, double on demand (never past the caller's bound) */
+            size_t new_capacity = (cache->entries_capacity == 0) ? 1 : cache->entries_capacity * 2;
+            if (new_capacity > cache->capacity) new_capacity = cache->capacity;
+            OutputCacheEntry *grown = (OutputCacheEntry*)realloc(cache->entries,
+                                                                 new_capacity * sizeof(OutputCacheEntry));
+            if (!grown) return SIZE_MAX;
+            cache->entries = grown;
+            cache->entries_capacity = new_capacity;
+        }
+        
+        /* Keep chains short: at least as many buckets as entries */
+        if (cache->count + 1 > cache->bucket_count) {
+            size_t new_bucket_count = (cache->bucket_count == 0) ? 1 : cache->bucket_count * 2;
+            size_t *buckets = (size_t*)malloc(new_bucket_count * sizeof(size_t));
+            if (!buckets) return SIZE_MAX;
+            for (size_t b = 0; b < new_bucket_count; b++) buckets[b] = SIZE_MAX;
+            free(cache->buckets);
+            cache->buckets = buckets;
+            cache->bucket_count = new_bucket_count;
+            for (size_t i = 0; i < cache->count; i++) output_cache_chain_push(cache, i);
+        }
+        
+        size_t slot = cache->count++;
+        memset(&cache->entries[slot], 0, sizeof(OutputCacheEntry));
+        return slot;
     }
     
-    /* RELATIVE: Normalize average weight relative to local context */
-    /* Pattern: x / (x + context) where context comes from data */
-    /* This measures how mature patterns are compared to what exists locally */
-    float relative_readiness = 0.0f;
-    if (local_context > 0.0f) {
-        /* Compare average to local context - stronger relative to context = more ready */
-        relative_readiness = avg_edge_weight / (avg_edge_weight + local_context);
+    size_t slot = cache->oldest;
+    output_cache_lru_unlink(cache, slot);
+    output_cache_chain_unlink(cache, slot);
+    free(cache->entries[slot].output);
+    cache->entries[slot].output = NULL;
+    g->output_cache_stats.evictions++;
+    return slot;
+}
+
+/* Remember a finished output (a stale entry for the same key is overwritten in place) */
+/* Allocation failure just leaves the output uncached */
+static void output_cache_store(MelvinGraph *g, Node *start, uint64_t context_hash, const MelvinDecodeConfig *decode,
+                               const uint8_t *output, size_t output_size) {
+    OutputCache *cache = g->output_cache;
+    uint8_t *copy = (uint8_t*)malloc(output_size);
+    if (!copy) return;
+    memcpy(copy, output, output_size);
+    
+    size_t slot = output_cache_find(cache, start, context_hash, decode);
+    if (slot != SIZE_MAX) {
+        output_cache_lru_unlink(cache, slot);
+        free(cache->entries[slot].output);
     } else {
-        /* No context available: use self-normalization pattern */
-        /* When no local context exists, compare to max (strongest pattern) */
-        if (max_edge_weight > 0.0f) {
-            relative_readiness = avg_edge_weight / (avg_edge_weight + max_edge_weight);
-        } else {
-            /* Absolute minimum: no data available */
-            return 0.0f;
+        slot = output_cache_claim(g, cache);
+        if (slot == SIZE_MAX) {
+            free(copy);
+            return;
         }
+        OutputCacheEntry *e = &cache->entries[slot];
+        e->start = start;
+        e->context_hash = context_hash;
+        e->decode = *decode;
+        output_cache_chain_push(cache, slot);
+    }
+    
+    OutputCacheEntry *e = &cache->entries[slot];
+    e->structure_version = g->structure_version;
+    e->output = copy;
+    e->output_size = output_size;
+    output_cache_lru_push(cache, slot);
+}
+
+/* STREAMING: Passes payloads through and remembers whether the consumer cut generation short */
+typedef struct OutputStreamTap {
+    OutputStreamFunc emit;
+    void *ctx;
+    bool stopped;
+} OutputStreamTap;
+
+static bool output_stream_tap(const uint8_t *bytes, size_t size, void *ctx) {
+    OutputStreamTap *tap = (OutputStreamTap*)ctx;
+    if (!tap->emit(bytes, size, tap->ctx)) tap->stopped = true;
+    return !tap->stopped;
+}
+
+/* Learning-path generation through the cache: a hit replays the stored output (one emit call), */
+/* a miss walks and stores the result unless a deadline or the consumer cut it short */
+static void output_collect_memoized(MelvinGraph *g, Node **direct_input_nodes, size_t direct_input_count,
+                                    const MelvinDecodeConfig *decode, OutputStreamFunc emit, void *emit_ctx,
+                                    uint8_t **output, size_t *output_size) {
+    if (!g->output_cache || !direct_input_nodes || direct_input_count == 0 || !direct_input_nodes[0] ||
+        !output || !output_size) {
+        wave_collect_output_core(g, NULL, &g->output_rng, direct_input_nodes, direct_input_count, decode,
+                                 emit, emit_ctx, output, output_size);
+        return;
     }
     
-    /* RELATIVE: Also consider edge count relative to node count (more edges = more learning) */
-    /* More edges per node suggests more mature patterns */
-    float edge_density_factor = 0.0f;
-    if (input_count > 0) {
-        float edges_per_node = (float)total_edge_count / (float)input_count;
-        /* Normalize: more edges = higher factor, but relative to what's typical */
-        /* Use input_count as context (more nodes = more opportunities for edges) */
-        float density_context = (float)input_count;  /* Context from data */
-        edge_density_factor = edges_per_node / (edges_per_node + density_context);
+    if (!decode) decode = &g->decode;
+    Node *start = direct_input_nodes[0];
+    uint64_t context_hash = graph_context_hash(g);
+    
+    size_t slot = output_cache_find(g->output_cache, start, context_hash, decode);
+    if (slot != SIZE_MAX && g->output_cache->entries[slot].structure_version == g->structure_version) {
+        OutputCacheEntry *e = &g->output_cache->entries[slot];
+        uint8_t *copy = (uint8_t*)malloc(e->output_size);
+        if (copy) {
+            memcpy(copy, e->output, e->output_size);
+            output_cache_lru_unlink(g->output_cache, slot);
+            output_cache_lru_push(g->output_cache, slot);
+            g->output_cache_stats.hits++;
+            *output = copy;
+            *output_size = e->output_size;
+            if (emit) emit(copy, e->output_size, emit_ctx);
+            return;
+        }
     }
     
-    /* RELATIVE: Combine weight maturity with edge density (both from data) */
-    /* Weight factor represents strength, density factor represents pattern richness */
-    /* Combine using relative weighting based on available data */
-    float combined_readiness = 0.0f;
-    if (edge_density_factor > 0.0f && relative_readiness > 0.0f) {
-        /* Both factors available: combine relative to their magnitudes */
-        float weight_factor_ratio = relative_readiness / (relative_readiness + edge_density_factor);
-        float density_factor_ratio = edge_density_factor / (relative_readiness + edge_density_factor);
-        combined_readiness = (relative_readiness * weight_factor_ratio) + 
-                           (edge_density_factor * density_factor_ratio);
-    } else if (relative_readiness > 0.0f) {
-        /* Only weight factor available */
-        combined_readiness = relative_readiness;
-    } else if (edge_density_factor > 0.0f) {
-        /* Only density factor available */
-        combined_readiness = edge_density_factor;
+    g->output_cache_stats.misses++;
+    OutputStreamTap tap = {emit, emit_ctx, false};
+    wave_collect_output_core(g, NULL, &g->output_rng, direct_input_nodes, direct_input_count, decode,
+                             emit ? output_stream_tap : NULL, &tap, output, output_size);
+    if (*output && *output_size > 0 && !tap.stopped && !g->deadline_truncated) {
+        output_cache_store(g, start, context_hash, decode, *output, *output_size);
     }
+}
+
+/* READ-ONLY: Answer an input without learning from it */
+/* No nodes or edges are created, no weights/activations/caches are written and last_activated is */
+/* left alone, so any number of threads may query one graph concurrently (not concurrently with */
+/* learning calls on that graph). Output is malloc'd (caller frees); budget_us = 0 means no deadline. */
+/* Lazily owed edge decay is applied on read (edge_get_decayed_weight) but never stored. */
+bool graph_query(MelvinGraph *g, const uint8_t *input, size_t input_size, uint64_t budget_us,
+                 uint8_t **output, size_t *output_size, bool *truncated) {
+    if (!g || !output || !output_size) return false;
     
-    return combined_readiness;  /* 0.0-1.0 range, fully data-driven */
+    *output = NULL;
+    *output_size = 0;
+    if (truncated) *truncated = false;
+    if (!input || input_size == 0) return true;
+    
+    QueryState q;
+    memset(&q, 0, sizeof(q));
+    q.deadline_us = (budget_us > 0) ? graph_monotonic_us() + budget_us : 0;
+    
+    /* SAMPLING: Stream derived from the brain's seed and the input (FNV-1a) - the same query */
+    /* against the same brain and seed samples the same output, whichever thread runs it */
+    uint64_t input_hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < input_size; i++) {
+        input_hash = (input_hash ^ input[i]) * 0x100000001B3ULL;
+    }
+    melvin_rng_seed(&q.rng, g->output_seed ^ input_hash);
+    
+    bool previous_read_only = tls_read_only_query;
+    tls_read_only_query = true;
+    
+    size_t seed_count = 0;
+    Node **seeds = query_segment_input(g, &q, input, input_size, &seed_count);
+    if (seeds && seed_count > 0) {
+        size_t seeded = q.count;  /* Every entry so far is a distinct seed */
+        query_propagate(g, &q, seeds, seed_count);
+        __atomic_add_fetch(&g->query_stats.queries, 1, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&g->query_stats.seeds, seeded, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&g->query_stats.reached, q.count - seeded, __ATOMIC_RELAXED);
+        wave_collect_output_core(g, &q, &q.rng, seeds, seed_count, NULL, NULL, NULL, output, output_size);
+    }
+    
+    tls_read_only_query = previous_read_only;
+    
+    if (truncated) *truncated = q.truncated;
+    free(seeds);
+    free(q.entries);
+    return true;
 }
 
 /* LLM-like output collection: Probabilistic generation using mini neural nets and transformers */
@@ -5518,8 +8695,37 @@ float compute_output_readiness(MelvinGraph *g, Node **input_nodes, size_t input_
 /* Uses existing edge_transform_activation() (mini transformer outputs) to shape probabilities */
 /* LLM-like behavior: Can echo input, uses all edge types, probabilistic sampling */
 /* Philosophy: Output is generated from node predictions collected during wave propagation */
+/* MEMOIZATION: With an output cache set, a repeat of an unchanged walk replays its stored output */
 void wave_collect_output(MelvinGraph *g, Node **direct_input_nodes, size_t direct_input_count, 
                          uint8_t **output, size_t *output_size) {
+    if (!g) return;
+    output_collect_memoized(g, direct_input_nodes, direct_input_count, NULL, NULL, NULL, output, output_size);
+}
+
+/* STREAMING: Same generation, but emit receives each payload as soon as it is appended */
+/* (the first input node's payload first). Bytes also accumulate in *output; emit returning */
+/* false stops generation there. emit runs on the calling thread and must not call back into g. */
+void wave_collect_output_stream(MelvinGraph *g, Node **direct_input_nodes, size_t direct_input_count,
+                                OutputStreamFunc emit, void *emit_ctx, uint8_t **output, size_t *output_size) {
+    if (!g) return;
+    output_collect_memoized(g, direct_input_nodes, direct_input_count, NULL, emit, emit_ctx, output, output_size);
+}
+
+/* DECODING: Generation with an explicit mode and caps for this call (NULL = the graph's default) */
+void wave_collect_output_decode(MelvinGraph *g, Node **direct_input_nodes, size_t direct_input_count,
+                                const MelvinDecodeConfig *decode, OutputStreamFunc emit, void *emit_ctx,
+                                uint8_t **output, size_t *output_size) {
+    if (!g) return;
+    output_collect_memoized(g, direct_input_nodes, direct_input_count, decode, emit, emit_ctx, output, output_size);
+}
+
+/* Output collection over either the graph's own activations (q == NULL) or a query's (read-only) */
+/* SAMPLING: Draws come from rng (the brain's stream, or a query's private one) */
+/* STREAMING: emit (optional) sees each appended payload; returning false ends generation */
+/* DECODING: decode picks the mode and caps (NULL = the graph's default) */
+static void wave_collect_output_core(MelvinGraph *g, QueryState *q, MelvinRng *rng, Node **direct_input_nodes,
+                                     size_t direct_input_count, const MelvinDecodeConfig *decode,
+                                     OutputStreamFunc emit, void *emit_ctx, uint8_t **output, size_t *output_size) {
     if (!g || !output || !output_size) return;
     
     *output = NULL;
@@ -5538,6 +8744,10 @@ void wave_collect_output(MelvinGraph *g, Node **direct_input_nodes, size_t direc
     
     size_t output_capacity = 0;
     
+    /* DECODING: Mode and hard caps (all zero = unbounded sampling walk) */
+    if (!decode) decode = &g->decode;
+    size_t max_bytes = decode->max_bytes;
+    
     /* LLM-like output: Can include input if activation is high (probabilistic, not restricted) */
     /* Input nodes can be in output if they have high activation_strength (from mini neural nets) */
     /* Don't pre-mark as visited - let probability distribution decide */
@@ -5552,13 +8762,19 @@ void wave_collect_output(MelvinGraph *g, Node **direct_input_nodes, size_t direc
                 output_capacity = current->payload_size * 2;
                 *output = (uint8_t*)malloc(output_capacity);
                 if (*output) {
-                    memcpy(*output, current->payload, current->payload_size);
-                    *output_size = current->payload_size;
+                    size_t echo_size = current->payload_size;
+                    if (max_bytes > 0 && echo_size > max_bytes) echo_size = max_bytes;  /* DECODING: Clip */
+                    node_payload_read(current, 0, *output, echo_size);
+                    *output_size = echo_size;
                 } else {
                     output_capacity = 0;
                 }
             }
             
+            /* STREAMING: The echoed input payload is the first thing a consumer can act on */
+            bool generating = (max_bytes == 0 || *output_size < max_bytes);
+            if (emit && *output_size > 0 && !emit(*output, *output_size, emit_ctx)) generating = false;
+            
             /* LLM-like probabilistic generation using mini neural nets and transformers */
             /* Uses existing activation_strength (mini neural net predictions) */
             /* Uses existing edge_transform_activation() (mini transformer outputs) */
@@ -5574,108 +8790,132 @@ void wave_collect_output(MelvinGraph *g, Node **direct_input_nodes, size_t direc
             
             size_t extension_step = 0;
             
+            /* SAMPLING: One scratch arena for every step (no per-step candidate allocations) */
+            OutputScratch scratch = {0};
+            bool fast_sampling = (g->output_alias_min_degree > 0 && decode->mode == MELVIN_DECODE_SAMPLE);
+            
+            /* DECODING: Beam mode searches first, then emits the winning path in one go */
+            if (generating && decode->mode == MELVIN_DECODE_BEAM) {
+                size_t path_length = 0;
+                Node **path = output_beam_search(g, q, current, *output_size, adaptive_temperature, decode,
+                                                 &scratch, &path_length);
+                for (size_t i = 0; i < path_length && generating; i++) {
+                    if (!output_append_payload(path[i], output, output_size, &output_capacity, max_bytes,
+                                               emit, emit_ctx, &generating)) break;
+                }
+                free(path);
+                generating = false;
+            }
+            
             /* Autoregressive generation (like LLM) */
             /* README: Follows co-activation edges (learned patterns) only */
             /* Uses probabilistic sampling (LLM-like) instead of deterministic selection */
-            while (true) {  /* No hardcoded limit - stops when no valid edges */
-                extension_step++;
+            while (generating) {  /* No hardcoded limit - stops when no valid edges (or a cap / the consumer) */
+                /* DEADLINE: Out of time - keep the output generated so far (anytime result) */
+                if (q ? query_deadline_expired(q) : graph_deadline_expired(g)) break;
                 
-                /* Build probability distribution from co-activation edges only */
-                /* Uses existing edge_transform_activation() (mini transformer) */
-                float *edge_probs = NULL;
-                Node **candidate_nodes = NULL;
-                size_t candidate_count = 0;
-                size_t candidate_capacity = 0;
-                float prob_sum = 0.0f;
+                /* DECODING: Step cap */
+                if (decode->max_steps > 0 && extension_step >= decode->max_steps) break;
                 
-                /* Collect all valid candidate nodes and their probabilities */
-                /* README: Follows co-activation edges (learned patterns) only */
-                /* SMOOTH: Use weight relative to local average as probability (no binary threshold) */
-                /* Strong co-activation edges = high probability, weak = low probability */
-                local_outgoing_avg = node_get_local_outgoing_weight_avg(current);
+                extension_step++;
                 
-                for (size_t i = 0; i < current->outgoing_count; i++) {
-                    Edge *edge = current->outgoing_edges[i];
-                    if (!edge || !edge->to_node) continue;
+                Node *next = NULL;
+                if (fast_sampling) {
+                    /* SAMPLING: Same distribution from cached scores, fast temperature, O(1) draws */
+                    float activation = q ? query_node_activation(q, current) : current->activation_strength;
+                    next = output_sample_fast(g, current, activation, output_quantize_exponent(adaptive_temperature),
+                                              visited, &scratch, rng);
+                    if (!next) break;
+                } else {
+                    /* Build probability distribution from co-activation edges only */
+                    /* Uses existing edge_transform_activation() (mini transformer) */
+                    if (!output_scratch_reserve(&scratch, current->outgoing_count)) break;
+                    float *edge_probs = scratch.probs;
+                    Node **candidate_nodes = scratch.nodes;
+                    size_t candidate_count = 0;
+                    float prob_sum = 0.0f;
                     
-                    /* SMOOTH: Compute co-activation probability (continuous, not binary) */
-                    /* Weight relative to local average determines probability */
-                    float weight_relative = 0.0f;
-                    if (local_outgoing_avg > 0.0f) {
-                        weight_relative = edge->weight / (edge->weight + local_outgoing_avg);  /* Smooth: 0 to 1 */
-                    } else {
-                        weight_relative = (edge->weight > 0.0f) ? 
-                            edge->weight / (edge->weight + 1.0f) : 0.0f;
-                    }
+                    /* Collect all valid candidate nodes and their probabilities */
+                    /* README: Follows co-activation edges (learned patterns) only */
+                    /* SMOOTH: Use weight relative to local average as probability (no binary threshold) */
+                    /* Strong co-activation edges = high probability, weak = low probability */
+                    local_outgoing_avg = node_get_local_outgoing_weight_avg(current);
                     
-                    /* Use minimal probability threshold for efficiency (very weak edges excluded) */
-                    /* But smooth transition, not binary cutoff */
-                    if (weight_relative < 0.01f) continue;  /* Very weak co-activation, skip */
+                    for (size_t i = 0; i < current->outgoing_count; i++) {
+                        Edge *edge = current->outgoing_edges[i];
+                        if (!edge || !edge->to_node) continue;
                     
-                    /* ALLOW self-loops: repeated chars must be emitted */
-                    bool is_self_loop = (edge->from_node == edge->to_node);
-                    if (!is_self_loop && visited_set_contains(visited, edge->to_node)) {
-                        continue;  /* Avoid cycles, but allow self-loops */
-                    }
+                        /* SMOOTH: Compute co-activation probability (continuous, not binary) */
+                        /* Weight relative to local average determines probability */
+                        float weight_relative = 0.0f;
+                        float weight = edge_get_decayed_weight(edge);  /* LAZY DECAY: Settled weight */
+                        if (local_outgoing_avg > 0.0f) {
+                            weight_relative = weight / (weight + local_outgoing_avg);  /* Smooth: 0 to 1 */
+                        } else {
+                            weight_relative = (weight > 0.0f) ? 
+                                weight / (weight + 1.0f) : 0.0f;
+                        }
+                    
+                        /* Use minimal probability threshold for efficiency (very weak edges excluded) */
+                        /* But smooth transition, not binary cutoff */
+                        if (weight_relative < 0.01f) continue;  /* Very weak co-activation, skip */
                     
-                    /* USE EXISTING: edge_transform_activation() (mini transformer output) */
-                    /* This already uses activation_strength and applies transformer logic */
-                    float transformed = edge_transform_activation(edge, current->activation_strength);
+                        /* ALLOW self-loops: repeated chars must be emitted */
+                        bool is_self_loop = (edge->from_node == edge->to_node);
+                        if (!is_self_loop && visited_set_contains(visited, edge->to_node)) {
+                            continue;  /* Avoid cycles, but allow self-loops */
+                        }
+                    
+                        /* USE EXISTING: edge_transform_activation() (mini transformer output) */
+                        /* This already uses activation_strength and applies transformer logic */
+                        float transformed = edge_transform_activation(edge, q ? query_node_activation(q, current) : current->activation_strength);
                     
-                    if (transformed > 0.0f) {
-                        /* SMOOTH: Combine transformed activation with co-activation probability */
-                        /* Strong co-activation edges get higher probability in output generation */
-                        float combined_prob = transformed * weight_relative;  /* Modulate by co-activation strength */
+                        if (transformed > 0.0f) {
+                            /* SMOOTH: Combine transformed activation with co-activation probability */
+                            /* Strong co-activation edges get higher probability in output generation */
+                            float combined_prob = transformed * weight_relative;  /* Modulate by co-activation strength */
                         
-                        /* Apply temperature scaling (LLM-like) */
-                        float prob = powf(combined_prob, 1.0f / adaptive_temperature);
+                            /* Apply temperature scaling (LLM-like) */
+                            float prob = powf(combined_prob, 1.0f / adaptive_temperature);
                         
-                        /* Allocate arrays if needed */
-                        if (candidate_count == 0) {
-                            candidate_capacity = current->outgoing_count;
-                            candidate_nodes = (Node**)malloc(candidate_capacity * sizeof(Node*));
-                            edge_probs = (float*)malloc(candidate_capacity * sizeof(float));
-                            if (!candidate_nodes || !edge_probs) break;
+                            candidate_nodes[candidate_count] = edge->to_node;
+                            edge_probs[candidate_count] = prob;
+                            prob_sum += prob;
+                            candidate_count++;
                         }
-                        
-                        candidate_nodes[candidate_count] = edge->to_node;
-                        edge_probs[candidate_count] = prob;
-                        prob_sum += prob;
-                        candidate_count++;
                     }
-                }
-                
-                /* Stop if no valid candidates */
-                if (candidate_count == 0 || prob_sum <= 0.0f) {
-                    if (edge_probs) free(edge_probs);
-                    if (candidate_nodes) free(candidate_nodes);
-                    break;
-                }
-                
-                /* Normalize to probability distribution (softmax-like) */
-                for (size_t i = 0; i < candidate_count; i++) {
-                    edge_probs[i] /= prob_sum;
-                }
-                
-                /* Probabilistic sampling (LLM-like, not deterministic) */
-                float r = (float)rand() / (float)RAND_MAX;
-                float cumsum = 0.0f;
-                Node *next = NULL;
-                
-                for (size_t i = 0; i < candidate_count; i++) {
-                    cumsum += edge_probs[i];
-                    if (r <= cumsum) {
-                        next = candidate_nodes[i];
-                        break;
+                    
+                    /* Stop if no valid candidates */
+                    if (candidate_count == 0 || prob_sum <= 0.0f) break;
+                    
+                    /* DECODING: Nucleus mode samples only among the most likely candidates */
+                    if (decode->mode == MELVIN_DECODE_NUCLEUS) {
+                        candidate_count = output_nucleus(candidate_nodes, edge_probs, candidate_count,
+                                                         decode->top_k, decode->top_p, scratch.ranks);
+                        prob_sum = 0.0f;
+                        for (size_t i = 0; i < candidate_count; i++) prob_sum += edge_probs[i];
+                    }
+                    
+                    /* Normalize to probability distribution (softmax-like) */
+                    for (size_t i = 0; i < candidate_count; i++) {
+                        edge_probs[i] /= prob_sum;
+                    }
+                    
+                    /* Probabilistic sampling (LLM-like, not deterministic) */
+                    float r = melvin_rng_float(rng);
+                    float cumsum = 0.0f;
+                    
+                    for (size_t i = 0; i < candidate_count; i++) {
+                        cumsum += edge_probs[i];
+                        if (r <= cumsum) {
+                            next = candidate_nodes[i];
+                            break;
+                        }
                     }
+                    
+                    if (!next) break;
                 }
                 
-                /* Cleanup probability arrays */
-                if (edge_probs) free(edge_probs);
-                if (candidate_nodes) free(candidate_nodes);
-                
-                if (!next) break;
-                
                 /* Check for cycle (allow self-loops) */
                 bool is_self_loop = (current == next);
                 if (!is_self_loop && visited_set_contains(visited, next)) {
@@ -5688,19 +8928,11 @@ void wave_collect_output(MelvinGraph *g, Node **direct_input_nodes, size_t direc
                 }
                 
                 /* Add to output (can include input if sampled) */
-                if (next->payload_size > 0) {
-                    size_t new_size = *output_size + next->payload_size;
-                    if (new_size > output_capacity) {
-                        output_capacity = (output_capacity == 0) ? next->payload_size * 2 : output_capacity * 2;
-                        *output = (uint8_t*)realloc(*output, output_capacity);
-                        if (!*output) {
-                            *output_size = 0;
-                            visited_set_free(visited);
-                            return;
-                        }
-                    }
-                    memcpy(*output + *output_size, next->payload, next->payload_size);
-                    *output_size = new_size;
+                if (!output_append_payload(next, output, output_size, &output_capacity, max_bytes,
+                                           emit, emit_ctx, &generating)) {
+                    output_scratch_free(&scratch);
+                    visited_set_free(visited);
+                    return;
                 }
                 
                 current = next;
@@ -5711,6 +8943,8 @@ void wave_collect_output(MelvinGraph *g, Node **direct_input_nodes, size_t direc
                 adaptive_temperature *= (1.0f + temp_increase * 0.01f);  /* Small gradual increase */
                 if (adaptive_temperature > 1.5f) adaptive_temperature = 1.5f;  /* Cap at 1.5 */
             }
+            
+            output_scratch_free(&scratch);
         }
     }
     
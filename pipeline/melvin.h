@@ -26,15 +26,38 @@
 typedef struct Node Node;
 typedef struct VisitedSet VisitedSet;
 typedef struct WaveStatistics WaveStatistics;
+typedef struct WeightUpdateBuffer WeightUpdateBuffer;
+typedef struct NodePairMap NodePairMap;
+typedef struct OutputAliasTable OutputAliasTable;
+typedef struct OutputCache OutputCache;
+typedef struct SegmentCache SegmentCache;
+typedef struct GrowthCandidate GrowthCandidate;
+
+/* COMPACT WEIGHTS: Build with -DMELVIN_COMPACT_WEIGHTS (make compact) to store edge weights */
+/* as IEEE half. Reads widen to float, so all weight math still runs in float precision. */
+#if defined(MELVIN_COMPACT_WEIGHTS) && defined(__FLT16_MAX__)
+typedef _Float16 EdgeWeight;
+#else
+#if defined(MELVIN_COMPACT_WEIGHTS)
+#warning "MELVIN_COMPACT_WEIGHTS: compiler has no _Float16 - edge weights stay float"
+#endif
+typedef float EdgeWeight;
+#endif
 
 /* Edge: Simple connection between two nodes */
+/* Field order keeps the record packed: 40 bytes with float weights, 32 with compact weights */
 typedef struct Edge {
     /* Node pointers for direct access (no searching) - variables with multiple jobs */
     Node *from_node;      /* Source node (also stores from_id via node->id) */
     Node *to_node;        /* Target node (also stores to_id via node->id) */
-    bool direction;       /* true = from->to, false = to->from */
-    bool activation;      /* Binary: 1 or 0 */
-    float weight;         /* Activation history (local measurement) - also serves as decision basis */
+    float input_contribution;  /* Transformed activation last pushed into to_node (delta-driven) */
+    uint32_t decay_tick;  /* from_node decay tick when decay was last applied (lazy decay) */
+    uint32_t deferred_slot;  /* 1 + index of this edge's pending update (0 = none, deferred updates) */
+    EdgeWeight weight;    /* Activation history (local measurement) - also serves as decision basis */
+    bool direction : 1;   /* true = from->to, false = to->from */
+    bool activation : 1;  /* Binary: 1 or 0 */
+    bool connected : 1;   /* Attached to node adjacency (graph_add_edge) - only then tracked in cached sums */
+    bool contribution_stale : 1;  /* Listed in to_node's stale inputs (input_contribution needs a re-transform) */
 } Edge;
 
 /* Node: Core unit of the system */
@@ -59,28 +82,113 @@ typedef struct Node {
     /* Cached local state (O(1) access - maintained incrementally) */
     float outgoing_weight_sum;  /* Sum of all outgoing edge weights (maintained incrementally) */
     float incoming_weight_sum;  /* Sum of all incoming edge weights (maintained incrementally) */
+    float incoming_activation_sum;  /* Sum of incoming edge contributions (delta-driven, O(1) activation) */
     
     /* OPTIMIZATION: Cached local averages (invalidated when edges change) */
     float cached_local_outgoing_avg;  /* Cached average, invalidated when edges change */
     float cached_local_incoming_avg;
     bool avg_cache_valid;  /* Cache validity flag */
+    Edge **stale_inputs;        /* DELTA-DRIVEN: Incoming edges whose contribution may be stale */
+    size_t stale_input_count;
+    size_t stale_input_capacity;
+    size_t stale_output_count;  /* Outgoing edges currently listed at their targets */
+    bool inputs_all_stale;      /* Own averages/weight moved - every incoming contribution is stale */
+    bool outgoing_order_dirty;  /* Outgoing weights changed since last efficiency sort (lazy re-sort) */
+    
+    /* LAZY DECAY: Outgoing edge decay is applied in closed form when edges are next touched */
+    uint32_t decay_tick;             /* Decay steps requested (one per weight update) */
+    uint32_t decay_reconciled_tick;  /* Tick of the last full pass over outgoing edges */
+    uint32_t deferred_slot;          /* 1 + index of this node's pending update (0 = none) */
+    Edge **activated_edges;          /* Outgoing edges activated since the last update (settled in O(activated)) */
+    size_t activated_count;
+    size_t activated_capacity;
+    bool activated_overflow;         /* List couldn't grow - next update scans all outgoing edges */
     
     /* OPTIMIZATION: Edge lookup cache (local-only, no global state) */
     Node *last_edge_lookup_target;  /* Last node looked up */
     Edge *last_edge_lookup_result;   /* Cached result */
     size_t edge_lookup_cache_hits;   /* Track cache effectiveness */
     
-    /* Adaptive learning rate tracking (rolling window) */
-    float *recent_weight_changes;  /* Dynamic rolling window - adapts to change rate */
-    size_t weight_change_capacity;  /* Current window size (adaptive) */
-    size_t weight_change_count;     /* How many values stored */
-    int weight_change_index;  /* Circular buffer index */
-    float change_rate_avg;  /* Average change rate for adapting window size */
+    /* Adaptive learning rate tracking (streaming, inline - O(1) per update, no heap) */
+    size_t weight_change_count;     /* Changes folded into change_rate_avg (history the learning rate trusts) */
+    float change_rate_avg;  /* Adaptive-horizon EWMA of |relative weight change| */
+    
+    /* ROPE: Combined nodes reference their two parts instead of copying the bytes beneath them */
+    /* Read payload bytes through node_payload_read/node_payload_at/node_payload_data, not payload[] */
+    Node *payload_left;      /* Parts this node was combined from (NULL = not a combination) */
+    Node *payload_right;
+    uint8_t *payload_flat;   /* Flattening cache for hot rope nodes (NULL = not materialized) */
+    uint32_t payload_reads;  /* Streamed reads while unflattened (a hot node flattens) */
+    bool payload_inline;     /* Bytes live in payload[] (false = read through the two parts) */
+    
+    /* SAMPLING: Cached alias table over this node's output candidates (fast sampling only) */
+    OutputAliasTable *output_alias;  /* NULL = none built; marked stale when edge weights change */
     
     /* Payload: actual data storage (flexible array member - data stored inline) */
-    uint8_t payload[];     /* Flexible array - data is stored directly in the node */
+    uint8_t payload[];     /* Flexible array - inline bytes (empty for rope nodes) */
 } Node;
 
+/* Output sampling PRNG state (xoshiro256**) - one per brain, no shared libc rand() lock */
+typedef struct MelvinRng {
+    uint64_t s[4];
+} MelvinRng;
+
+#define MELVIN_DEFAULT_SEED 1ULL  /* Seed a new brain starts with (reseed via melvin_m_set_seed) */
+
+/* STREAMING: Receives each output payload as generation appends it (return false to stop generating) */
+typedef bool (*OutputStreamFunc)(const uint8_t *bytes, size_t size, void *ctx);
+
+/* DECODING: How output generation picks each next node */
+typedef enum {
+    MELVIN_DECODE_SAMPLE = 0,  /* Sample the full distribution (default, original behavior) */
+    MELVIN_DECODE_NUCLEUS,     /* Sample among the top_k candidates within top_p of the probability mass */
+    MELVIN_DECODE_BEAM         /* Deterministic beam search, beam_width paths wide */
+} MelvinDecodeMode;
+
+#define MELVIN_DECODE_BEAM_DEFAULT_STEPS 64  /* Beam step cap when max_steps is 0 (beams never stop on their own) */
+
+/* DECODING: Mode plus hard caps (all zero = original unbounded sampling walk) */
+typedef struct MelvinDecodeConfig {
+    MelvinDecodeMode mode;
+    size_t top_k;        /* Nucleus: keep at most this many candidates (0 = all) */
+    float top_p;         /* Nucleus: smallest set reaching this share of the mass (0 or >= 1 = all) */
+    size_t beam_width;   /* Beam: paths kept per step (0 = 1, greedy) */
+    size_t max_bytes;    /* Output clipped to this many bytes, any mode (0 = uncapped) */
+    size_t max_steps;    /* Generation steps after the echoed input payload, any mode (0 = uncapped) */
+} MelvinDecodeConfig;
+
+/* MEMOIZATION: Output cache lookups (cumulative) */
+typedef struct OutputCacheStats {
+    uint64_t hits;       /* Outputs replayed without a walk */
+    uint64_t misses;     /* Walks run (and stored, unless cut short) */
+    uint64_t evictions;  /* Least recently used entries dropped for new ones */
+} OutputCacheStats;
+
+/* MEMOIZATION: Segmentation cache lookups (cumulative) */
+typedef struct SegmentCacheStats {
+    uint64_t hits;      /* Inputs whose node sequence was replayed without neighbor searches */
+    uint64_t misses;    /* Inputs segmented in full */
+    uint64_t uncached;  /* Misses not stored because segmenting them added nodes or edges */
+} SegmentCacheStats;
+
+/* READ-ONLY: Reach of read-only queries (cumulative, updated atomically by concurrent queries) */
+typedef struct QueryStats {
+    uint64_t queries;   /* Queries that matched at least one seed */
+    uint64_t seeds;     /* Distinct nodes the inputs segmented into */
+    uint64_t reached;   /* Nodes propagation activated beyond those seeds */
+} QueryStats;
+
+/* GROWTH BUDGET: Optional structure accepted vs suppressed by the growth governor (cumulative) */
+/* Input segmentation and co-activation edges are never capped and are not counted here */
+typedef struct GrowthStats {
+    uint64_t nodes_accepted;          /* Combined (hierarchy) nodes */
+    uint64_t nodes_suppressed;
+    uint64_t blank_nodes_accepted;    /* Generalization (blank) nodes */
+    uint64_t blank_nodes_suppressed;
+    uint64_t edges_accepted;          /* Inherited, hierarchy, context, similarity, homeostatic edges */
+    uint64_t edges_suppressed;
+} GrowthStats;
+
 /* Graph: Container for nodes and edges (no global state in operations) */
 typedef struct MelvinGraph {
     Node **nodes;
@@ -96,6 +204,67 @@ typedef struct MelvinGraph {
     Node **last_activated;
     size_t last_activated_count;
     size_t last_activated_capacity;
+    
+    /* DATA-DRIVEN: Ingestion mode (fast pattern matching until patterns mature) */
+    bool ingestion_mode;
+    float pattern_maturity_avg;  /* Running average of pattern maturity (adaptive) */
+    
+    /* SPARSE PROPAGATION: Bounded fan-out for latency-sensitive routes (0 = unbounded) */
+    size_t propagation_fanout_k;      /* Max edges each node propagates through per step */
+    size_t propagation_frontier_cap;  /* Max nodes carried into the next wave front */
+    
+    /* DEADLINE: Wall-clock budget for anytime processing (0 = no deadline) */
+    uint64_t deadline_us;       /* Absolute monotonic deadline in microseconds */
+    bool deadline_truncated;    /* Set when propagation/generation stopped at the deadline */
+    
+    /* BEST-FIRST: Max-heap propagation within a fixed energy allowance (false = breadth-first) */
+    bool propagation_best_first;
+    float propagation_energy_budget;  /* Energy per propagation call (0 = derived from input) */
+    float last_energy_spent;          /* Energy consumed by the most recent best-first call */
+    
+    /* DEFERRED: Weight updates recorded during a wave step, committed after it (false = in place) */
+    bool deferred_weight_updates;
+    WeightUpdateBuffer *weight_updates;  /* Pending edge/node updates (merged per edge/node) */
+    
+    /* SAMPLING: Per-brain output PRNG (reproducible per seed, lock-free across brains) */
+    uint64_t output_seed;   /* Last seed set (read-only queries derive private streams from it) */
+    MelvinRng output_rng;   /* Stream advanced by learning calls' output generation */
+    size_t output_alias_min_degree;  /* Fast sampling for nodes with this many edges (0 = exact sampling) */
+    MelvinDecodeConfig decode;       /* DECODING: Default for calls that don't pass their own */
+    
+    /* CANONICAL: Generalization node per unordered member pair (O(1) existence check) */
+    /* Not persisted - rebuilt from the edges of a loaded .m (graph_register_generalizations) */
+    NodePairMap *generalizations;
+    
+    /* CANONICAL: Combined (hierarchy) node per ordered (left, right) part pair */
+    /* Filled as combined nodes are added to the graph, so loading a .m file rebuilds it */
+    NodePairMap *combinations;
+    bool combinations_unrecorded;  /* Loaded from a .m without part references - misses check locally */
+    
+    /* MEMOIZATION: Bumped whenever a node or a new edge is added (weight changes don't count) */
+    uint64_t structure_version;
+    
+    /* MEMOIZATION: LRU of finished outputs keyed by (start node, context, structure_version) */
+    /* Not persisted - a reopened file starts without a cache */
+    OutputCache *output_cache;  /* NULL = off (default, original behavior) */
+    OutputCacheStats output_cache_stats;
+    
+    /* MEMOIZATION: Node sequences of recent inputs keyed by (bytes, context, structure_version) */
+    /* Not persisted - a reopened file starts without a cache */
+    SegmentCache *segment_cache;  /* NULL = off (default, original behavior) */
+    SegmentCacheStats segment_cache_stats;
+    
+    QueryStats query_stats;  /* READ-ONLY: Not persisted */
+    
+    /* GROWTH BUDGET: Cap on optional structure added per processed input (0 = uncapped) */
+    float growth_per_byte;      /* Optional nodes allowed per input byte */
+    bool growth_budget_armed;   /* Caps apply (between graph_begin/end_growth_budget) */
+    size_t growth_nodes_left;   /* Remaining for the current input */
+    size_t growth_edges_left;
+    GrowthStats growth_stats;
+    GrowthCandidate *growth_pending;  /* Every law's proposals this input, admitted together at settle */
+    size_t growth_pending_count;
+    size_t growth_pending_capacity;
 } MelvinGraph;
 
 /* ========================================
@@ -106,6 +275,10 @@ typedef struct MelvinGraph {
 #define MELVIN_M_MAGIC 0x4D454C56494E0000ULL  /* "MELVIN\0\0" in ASCII */
 #define MELVIN_M_VERSION 1
 
+/* Header flags */
+#define MELVIN_M_FLAG_HALF_WEIGHTS 0x1u  /* Edge section stores weights as IEEE half (2 bytes) */
+#define MELVIN_M_FLAG_ROPE_PAYLOADS 0x2u /* Node records store combined nodes as part indices */
+
 /* .m File Header - persistent state of the live program */
 typedef struct MelvinMHeader {
     uint64_t magic;         /* Magic number: MELVIN_M_MAGIC */
@@ -133,6 +306,12 @@ typedef struct MelvinMHeader {
     uint64_t adaptation_count; /* Number of adaptations */
 } MelvinMHeader;
 
+/* FRAMING: Side-channel for payload-only input (port frame header fields, never segmented) */
+typedef struct MelvinInputMeta {
+    uint8_t port_id;     /* Input port (routes the output) */
+    uint64_t timestamp;  /* Frame timestamp in microseconds */
+} MelvinInputMeta;
+
 /* .m File - The live, executable program driven by data */
 typedef struct MelvinMFile {
     FILE *file;
@@ -144,6 +323,10 @@ typedef struct MelvinMFile {
     uint8_t *universal_output; /* I/O port: output buffer (wave propagation results) */
     size_t universal_output_capacity;
     uint8_t last_input_port_id; /* Last input port ID extracted from input (ephemeral, for routing) */
+    uint64_t last_input_timestamp; /* FRAMING: Timestamp of the last payload-only input (0 = none) */
+    MelvinInputMeta input_meta; /* FRAMING: Metadata for the payload in universal input (ephemeral) */
+    bool has_input_meta;     /* Universal input is payload only (false = port byte first, CAN-style) */
+    bool last_process_truncated; /* Last process_input call hit its deadline (output is best-so-far) */
     bool is_dirty;           /* True if file needs auto-save (self-regulating) */
 } MelvinMFile;
 
@@ -154,14 +337,25 @@ typedef struct MelvinMFile {
 /* Node Operations */
 Node* node_create(const uint8_t *payload_data, size_t payload_size);
 void node_update_weight_local(Node *node);
+void node_apply_weight_update(Node *node, float rate, float new_weight);  /* Apply a batch-computed update + bookkeeping */
+float node_get_adaptive_learning_rate(Node *node);  /* Node learning rate (streaming change estimate + local context) */
 float node_compute_activation_strength(Node *node);  /* Compute activation from weighted inputs (mini neural net) */
+float node_get_input_sum(Node *node);  /* Reconciled weighted input sum (what activation is computed from) */
+void node_set_activation_strength(Node *node, float activation);  /* Set activation, push deltas to targets */
 float node_calculate_match_strength(Node *node, const uint8_t *pattern, size_t pattern_size);
 float node_get_local_outgoing_weight_avg(Node *node);
 float node_get_local_incoming_weight_avg(Node *node);
 void node_free(Node *node);
 
+/* Payload Access (ROPE: combined nodes stream bytes from their parts) */
+size_t node_payload_read(Node *node, size_t offset, uint8_t *dst, size_t len);  /* Copy bytes out, returns count */
+uint8_t node_payload_at(Node *node, size_t index);  /* One byte (index < payload_size) */
+const uint8_t* node_payload_data(Node *node);  /* Contiguous bytes (flattens rope nodes; NULL if empty) */
+void graph_release_payload_caches(MelvinGraph *g);  /* Drop flattening caches (no concurrent readers) */
+
 /* Payload Expansion & Hierarchy (nodes combine into larger payloads when patterns repeat) */
 Node* node_combine_payloads(Node *node1, Node *node2);  /* Combine nodes - hierarchy formation */
+Node* node_create_rope(Node *left, Node *right);  /* Node whose payload is left's bytes then right's */
 void node_transfer_incoming_to_hierarchy(MelvinGraph *g, Node *node1, Node *node2, Node *combined);  /* Transfer edges to hierarchy */
 /* Hierarchy formation now emerges naturally from edge weight growth - see wave_create_edges_from_coactivation() */
 Node* node_create_blank(void);  /* Create blank/template node for pattern matching */
@@ -171,8 +365,11 @@ Node* node_fill_blank(Node *blank_node, const uint8_t *pattern, size_t pattern_s
 
 /* Edge Operations */
 Edge* edge_create(Node *from, Node *to, bool direction);
+uint16_t melvin_weight_to_half(float weight);  /* IEEE half bits (round to nearest even) */
+float melvin_half_to_weight(uint16_t bits);
 void edge_update_weight_local(Edge *edge);
 float edge_transform_activation(Edge *edge, float input_activation);  /* Transform activation as it flows through edge */
+float edge_compute_pattern_similarity(Node *node1, Node *node2);  /* Payload similarity (gathered by batch backends) */
 void edge_free(Edge *edge);
 
 /* ========================================
@@ -190,6 +387,7 @@ bool melvin_m_save(MelvinMFile *mfile);
 
 /* Close .m file (auto-saves if dirty) */
 void melvin_m_close(MelvinMFile *mfile);
+void melvin_m_set_half_weights(MelvinMFile *mfile, bool enabled);  /* Half-precision edge section */
 
 /* ========================================
  * I/O PORT OPERATIONS (Data-Driven Execution)
@@ -197,6 +395,8 @@ void melvin_m_close(MelvinMFile *mfile);
 
 /* Write data to I/O port (triggers execution) */
 bool melvin_m_universal_input_write(MelvinMFile *mfile, const uint8_t *data, size_t size);
+bool melvin_m_universal_input_write_payload(MelvinMFile *mfile, const MelvinInputMeta *meta,
+                                           const uint8_t *data, size_t size);  /* Payload only, metadata aside */
 
 /* Read data from I/O port */
 size_t melvin_m_universal_input_read(MelvinMFile *mfile, uint8_t *buffer, size_t buffer_size);
@@ -211,6 +411,33 @@ void melvin_m_universal_output_clear(MelvinMFile *mfile);
 /* Process input through graph (data-driven execution - auto-saves after adaptation) */
 bool melvin_m_process_input(MelvinMFile *mfile);
 
+/* Process input with a wall-clock budget (microseconds, 0 = none) - returns best output so far */
+bool melvin_m_process_input_deadline(MelvinMFile *mfile, uint64_t budget_us);
+bool melvin_m_last_process_truncated(MelvinMFile *mfile);  /* True if last call stopped at its deadline */
+
+/* Process input, handing each output payload to emit as it is generated (output is also buffered) */
+bool melvin_m_process_input_stream(MelvinMFile *mfile, OutputStreamFunc emit, void *ctx);
+
+/* Seed this brain's output sampling (per file, not process-wide like srand) */
+void melvin_m_set_seed(MelvinMFile *mfile, uint64_t seed);
+
+/* Alias-table output sampling for nodes with at least alias_min_degree edges (0 = exact sampling) */
+void melvin_m_set_fast_sampling(MelvinMFile *mfile, size_t alias_min_degree);
+
+/* Default decoding mode and caps for this brain (NULL = unbounded sampling); per call via _decode */
+void melvin_m_set_decoding(MelvinMFile *mfile, const MelvinDecodeConfig *config);
+bool melvin_m_process_input_decode(MelvinMFile *mfile, const MelvinDecodeConfig *decode,
+                                   OutputStreamFunc emit, void *ctx);
+
+/* Cap optional structure per input (nodes per input byte, 0 = uncapped) and read the counters */
+void melvin_m_set_growth_budget(MelvinMFile *mfile, float nodes_per_byte);
+GrowthStats melvin_m_get_growth_stats(MelvinMFile *mfile);
+
+/* Read-only query (no learning, no mutation - concurrent queries OK); output malloc'd, caller frees */
+bool melvin_m_query(MelvinMFile *mfile, const uint8_t *input, size_t input_size, uint8_t **output, size_t *output_size);
+bool melvin_m_query_deadline(MelvinMFile *mfile, const uint8_t *input, size_t input_size, uint64_t budget_us,
+                             uint8_t **output, size_t *output_size, bool *truncated);
+
 /* Graph access from .m file */
 MelvinGraph* melvin_m_get_graph(MelvinMFile *mfile);
 
@@ -229,10 +456,33 @@ MelvinGraph* graph_create(void);
 bool graph_add_node(MelvinGraph *g, Node *node);  /* Creation law */
 bool graph_add_edge(MelvinGraph *g, Edge *edge, Node *from, Node *to);  /* Creation law */
 void graph_free(MelvinGraph *g);
+void graph_set_sparse_propagation(MelvinGraph *g, size_t fanout_k, size_t frontier_cap);  /* Top-k fan-out + frontier cap (0 = unbounded) */
+void graph_set_deadline(MelvinGraph *g, uint64_t budget_us);  /* Deadline = now + budget (0 = clear) */
+bool graph_deadline_expired(MelvinGraph *g);  /* True (and marks truncated) once the deadline has passed */
+void graph_reconcile_edge_decay(MelvinGraph *g);  /* Apply all pending lazy edge decay (e.g. before save) */
+void graph_register_generalizations(MelvinGraph *g);  /* Rebuild the generalization registry (after .m load) */
+void graph_set_best_first_propagation(MelvinGraph *g, bool enabled, float energy_budget);  /* Best-first + energy allowance (0 = from input) */
+void graph_set_deferred_weight_updates(MelvinGraph *g, bool enabled);  /* Record weight updates per step, commit after it */
+void graph_begin_weight_updates(MelvinGraph *g);   /* Start recording on this thread (no-op unless deferred) */
+void graph_commit_weight_updates(MelvinGraph *g);  /* Apply recorded updates (parallel, deterministic) */
+void graph_set_seed(MelvinGraph *g, uint64_t seed);  /* Reseed output sampling (same seed + inputs = same outputs) */
+void graph_set_fast_sampling(MelvinGraph *g, size_t alias_min_degree);  /* Alias-table output sampling (0 = exact) */
+void graph_set_decoding(MelvinGraph *g, const MelvinDecodeConfig *config);  /* Default decoding (NULL = unbounded sampling) */
+void graph_set_growth_budget(MelvinGraph *g, float nodes_per_byte);  /* Growth governor scale (0 = uncapped) */
+bool graph_set_output_cache(MelvinGraph *g, size_t capacity);  /* Output memoization LRU entries (0 = off) */
+bool graph_set_segment_cache(MelvinGraph *g, size_t slots);  /* Segmentation result cache slots (0 = off) */
+void graph_begin_growth_budget(MelvinGraph *g, size_t input_size);   /* Arm caps for one input (no-op if uncapped) */
+void graph_settle_growth(MelvinGraph *g);                            /* Rank all laws' proposals, admit strongest */
+void graph_end_growth_budget(MelvinGraph *g);                        /* Settle, then disarm caps (counters are kept) */
+bool graph_query(MelvinGraph *g, const uint8_t *input, size_t input_size, uint64_t budget_us,
+                 uint8_t **output, size_t *output_size, bool *truncated);  /* Read-only: answer input without learning */
 
 /* Wave Propagation */
 Node** wave_propagate_from_node(Node *node);
+Node** wave_propagate_from_node_with_energy(Node *node, float *energy_budget);  /* Energy-constrained propagation */
 void wave_propagate_multi_step(MelvinGraph *g, Node **initial_nodes, size_t initial_count);
+void wave_propagate_multi_step_with_energy(MelvinGraph *g, Node **initial_nodes, size_t initial_count, float *energy_budget);
+void wave_propagate_best_first(MelvinGraph *g, Node **initial_nodes, size_t initial_count, float energy_budget);  /* Max-heap by activation/cost until energy runs out */
 Node** wave_process_sequential_patterns(MelvinGraph *g, const uint8_t *data, size_t data_size, size_t *out_count);  /* Process data to find sequential patterns */
 void wave_create_edges_from_coactivation(MelvinGraph *g, Node **activated_nodes, size_t activated_count);  /* Create edges from co-activation (simple rule) */
 void wave_create_edges_from_similarity(MelvinGraph *g, Node *node, float similarity_threshold);  /* Create edges between similar patterns */
@@ -244,6 +494,11 @@ void wave_create_homeostatic_edges(MelvinGraph *g, Node *isolated_node);  /* Cre
 void wave_form_intelligent_edges(MelvinGraph *g, Node **activated_nodes, size_t activated_count,
                                  VisitedSet *context_visited, WaveStatistics *stats);  /* Form intelligent edges using all creation laws, with wave propagation context */
 void wave_collect_output(MelvinGraph *g, Node **direct_input_nodes, size_t direct_input_count, uint8_t **output, size_t *output_size);  /* LLM-like probabilistic output using mini neural nets and transformers */
+void wave_collect_output_stream(MelvinGraph *g, Node **direct_input_nodes, size_t direct_input_count,
+                                OutputStreamFunc emit, void *emit_ctx, uint8_t **output, size_t *output_size);  /* Same, emitting each payload as it is generated */
+void wave_collect_output_decode(MelvinGraph *g, Node **direct_input_nodes, size_t direct_input_count,
+                                const MelvinDecodeConfig *decode, OutputStreamFunc emit, void *emit_ctx,
+                                uint8_t **output, size_t *output_size);  /* Explicit decoding (NULL = graph default) */
 
 #endif /* MELVIN_H */
 
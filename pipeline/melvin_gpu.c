@@ -9,6 +9,16 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <float.h>
+
+/* CPU OPTIMIZATION: SIMD includes for the vectorized CPU backend */
+#ifdef __SSE2__
+#include <emmintrin.h>  /* SSE2 for x86 */
+#define MELVIN_SIMD_BACKEND 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>   /* NEON for ARM64 (Jetson) - vdivq_f32 needs AArch64 */
+#define MELVIN_SIMD_BACKEND 1
+#endif
 
 /* Static GPU context singleton */
 static MelvinGPUContext *g_gpu_context = NULL;
@@ -21,6 +31,14 @@ static void cpu_batch_compute_statistics(Node **nodes, size_t node_count,
                                          float *local_avgs_out, float *local_stds_out);
 static void cpu_batch_update_weights(Node **nodes, size_t node_count);
 
+/* Vectorized CPU backend (gather -> SIMD kernel -> scatter) */
+static void simd_batch_compute_activations(Node **nodes, size_t node_count);
+static void simd_batch_transform_edges(Node *from_node, Edge **edges, size_t edge_count,
+                                        float *edge_outputs, float *max_output);
+static void simd_batch_compute_statistics(Node **nodes, size_t node_count,
+                                          float *local_avgs_out, float *local_stds_out);
+static void simd_batch_update_weights(Node **nodes, size_t node_count);
+
 /* CUDA initialization function (defined in melvin_gpu_cuda.cu if CUDA available) */
 #ifdef CUDA_AVAILABLE
 extern bool melvin_gpu_cuda_init(MelvinGPUContext *ctx);
@@ -52,8 +70,16 @@ bool melvin_gpu_init(MelvinGPUContext **ctx) {
     cuda_success = melvin_gpu_cuda_init(new_ctx);
 #endif
     
-    if (!cuda_success) {
+    if (cuda_success) {
+        new_ctx->backend = MELVIN_BACKEND_CUDA;
+    } else {
         /* CPU fallback mode - GPU not available */
+        /* Use the vectorized CPU backend when the target has SIMD (always on x86-64 / ARM64) */
+#ifdef MELVIN_SIMD_BACKEND
+        new_ctx->backend = MELVIN_BACKEND_CPU_SIMD;
+#else
+        new_ctx->backend = MELVIN_BACKEND_SCALAR;
+#endif
         new_ctx->cuda_available = false;
         new_ctx->gpu_available = false;
         new_ctx->device_count = 0;
@@ -81,6 +107,11 @@ bool melvin_gpu_is_available(MelvinGPUContext *ctx) {
     return ctx && ctx->gpu_available;
 }
 
+/* Check if batch operations are accelerated (CUDA or vectorized CPU) */
+bool melvin_gpu_has_batch_backend(MelvinGPUContext *ctx) {
+    return ctx && ctx->backend != MELVIN_BACKEND_SCALAR;
+}
+
 /* Get GPU context singleton */
 MelvinGPUContext* melvin_gpu_get_context(void) {
     if (!g_gpu_context) {
@@ -97,7 +128,7 @@ static void cpu_batch_compute_activations(Node **nodes, size_t node_count) {
     /* Process nodes sequentially (CPU fallback) */
     for (size_t i = 0; i < node_count; i++) {
         if (nodes[i]) {
-            nodes[i]->activation_strength = node_compute_activation_strength(nodes[i]);
+            node_set_activation_strength(nodes[i], node_compute_activation_strength(nodes[i]));
         }
     }
 }
@@ -177,13 +208,391 @@ static void cpu_batch_update_weights(Node **nodes, size_t node_count) {
     }
 }
 
+/* ========================================
+ * VECTORIZED CPU BACKEND
+ * Gather pointer-based state into SoA buffers, run 4-wide SIMD kernels, scatter results.
+ * Same math as the scalar paths (node_compute_activation_strength, edge_transform_activation).
+ * ======================================== */
+
+#ifdef MELVIN_SIMD_BACKEND
+
+/* Portable 4-wide float ops (SSE2 on x86, NEON on ARM64) */
+#ifdef __SSE2__
+typedef __m128 simd_f32;
+#define SIMD_SET1(x)        _mm_set1_ps(x)
+#define SIMD_LOAD(p)        _mm_loadu_ps(p)
+#define SIMD_STORE(p, v)    _mm_storeu_ps((p), (v))
+#define SIMD_ADD(a, b)      _mm_add_ps((a), (b))
+#define SIMD_SUB(a, b)      _mm_sub_ps((a), (b))
+#define SIMD_MUL(a, b)      _mm_mul_ps((a), (b))
+#define SIMD_DIV(a, b)      _mm_div_ps((a), (b))
+#define SIMD_MAX(a, b)      _mm_max_ps((a), (b))
+#define SIMD_ABS(a)         _mm_andnot_ps(_mm_set1_ps(-0.0f), (a))
+/* Select a where a > 0, else b */
+#define SIMD_SELECT_POS(a, b) _mm_or_ps(_mm_and_ps(_mm_cmpgt_ps((a), _mm_setzero_ps()), (a)), \
+                                        _mm_andnot_ps(_mm_cmpgt_ps((a), _mm_setzero_ps()), (b)))
+#else
+typedef float32x4_t simd_f32;
+#define SIMD_SET1(x)        vdupq_n_f32(x)
+#define SIMD_LOAD(p)        vld1q_f32(p)
+#define SIMD_STORE(p, v)    vst1q_f32((p), (v))
+#define SIMD_ADD(a, b)      vaddq_f32((a), (b))
+#define SIMD_SUB(a, b)      vsubq_f32((a), (b))
+#define SIMD_MUL(a, b)      vmulq_f32((a), (b))
+#define SIMD_DIV(a, b)      vdivq_f32((a), (b))
+#define SIMD_MAX(a, b)      vmaxq_f32((a), (b))
+#define SIMD_ABS(a)         vabsq_f32(a)
+#define SIMD_SELECT_POS(a, b) vbslq_f32(vcgtq_f32((a), vdupq_n_f32(0.0f)), (a), (b))
+#endif
+
+/* Horizontal max of a 4-lane vector */
+static float simd_hmax(simd_f32 v) {
+    float lanes[4];
+    SIMD_STORE(lanes, v);
+    float m = lanes[0];
+    for (int i = 1; i < 4; i++) {
+        if (lanes[i] > m) m = lanes[i];
+    }
+    return m;
+}
+
+/* Horizontal sum of a 4-lane vector */
+static float simd_hsum(simd_f32 v) {
+    float lanes[4];
+    SIMD_STORE(lanes, v);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+/* Kernel: activation = raw / (1 + raw), raw = normalized input + self-regulating bias */
+/* SoA inputs: input sums, total incoming weights, node weights, local incoming averages */
+static void simd_kernel_activations(const float *input_sum, const float *total_weight,
+                                    const float *weight, const float *local_avg, size_t count,
+                                    float *bias_out, float *activation_out) {
+    const simd_f32 one = SIMD_SET1(1.0f);
+    const simd_f32 zero = SIMD_SET1(0.0f);
+    const simd_f32 tiny = SIMD_SET1(FLT_MIN);
+    size_t i = 0;
+    
+    for (; i + 4 <= count; i += 4) {
+        simd_f32 in = SIMD_MAX(SIMD_LOAD(input_sum + i), zero);
+        simd_f32 denom = SIMD_SELECT_POS(SIMD_LOAD(total_weight + i), one);  /* total > 0 ? total : 1 */
+        simd_f32 w = SIMD_LOAD(weight + i);
+        simd_f32 ctx = SIMD_ADD(w, SIMD_LOAD(local_avg + i));
+        simd_f32 bias = SIMD_DIV(w, SIMD_MAX(ctx, tiny));  /* w + avg == 0 implies w == 0 -> 0 */
+        simd_f32 raw = SIMD_ADD(SIMD_DIV(in, denom), bias);
+        SIMD_STORE(bias_out + i, bias);
+        SIMD_STORE(activation_out + i, SIMD_DIV(raw, SIMD_ADD(one, raw)));
+    }
+    
+    /* Scalar remainder */
+    for (; i < count; i++) {
+        float in = fmaxf(input_sum[i], 0.0f);
+        float denom = (total_weight[i] > 0.0f) ? total_weight[i] : 1.0f;
+        float ctx = weight[i] + local_avg[i];
+        float bias = weight[i] / fmaxf(ctx, FLT_MIN);
+        float raw = in / denom + bias;
+        bias_out[i] = bias;
+        activation_out[i] = raw / (1.0f + raw);
+    }
+}
+
+/* Kernel: weight update new = w * (1 - rate) + activation * rate over SoA columns */
+static void simd_kernel_update_weights(const float *weight, const float *activation,
+                                       const float *rate, size_t count, float *weight_out) {
+    const simd_f32 one = SIMD_SET1(1.0f);
+    size_t i = 0;
+    
+    for (; i + 4 <= count; i += 4) {
+        simd_f32 r = SIMD_LOAD(rate + i);
+        simd_f32 kept = SIMD_MUL(SIMD_LOAD(weight + i), SIMD_SUB(one, r));
+        SIMD_STORE(weight_out + i, SIMD_ADD(kept, SIMD_MUL(SIMD_LOAD(activation + i), r)));
+    }
+    
+    /* Scalar remainder */
+    for (; i < count; i++) {
+        weight_out[i] = weight[i] * (1.0f - rate[i]) + activation[i] * rate[i];
+    }
+}
+
+/* Kernel: edge transform (similarity boost + local inhibition) over SoA weights/similarities */
+/* Per-source context (activation, local averages) is uniform across the batch */
+static float simd_kernel_transform_edges(const float *weight, const float *similarity, size_t count,
+                                         float activation, float from_local_avg, float combined_avg,
+                                         float *out) {
+    bool has_local = (from_local_avg > 0.0f);
+    bool has_combined = (combined_avg > 0.0f);
+    float similarity_threshold = has_combined ? combined_avg : 0.0f;
+    float context_scale = has_combined ? combined_avg / (combined_avg + 1.0f) : 1.0f;
+    float inv_local_avg = has_local ? 1.0f / from_local_avg : 0.0f;
+    
+    const simd_f32 one = SIMD_SET1(1.0f);
+    const simd_f32 half = SIMD_SET1(0.5f);
+    const simd_f32 zero = SIMD_SET1(0.0f);
+    const simd_f32 v_act = SIMD_SET1(activation);
+    const simd_f32 v_thr = SIMD_SET1(similarity_threshold);
+    const simd_f32 v_scale = SIMD_SET1(context_scale);
+    const simd_f32 v_inv_avg = SIMD_SET1(inv_local_avg);
+    simd_f32 v_max = zero;
+    size_t i = 0;
+    
+    for (; i + 4 <= count; i += 4) {
+        simd_f32 w = SIMD_LOAD(weight + i);
+        simd_f32 sim = SIMD_LOAD(similarity + i);
+        simd_f32 t = SIMD_MUL(w, v_act);
+        
+        /* 1. Pattern similarity: smooth boost strength in [0, 1] */
+        simd_f32 excess = SIMD_SUB(sim, v_thr);
+        simd_f32 strength = SIMD_DIV(excess, SIMD_ADD(SIMD_ABS(excess), one));
+        strength = SIMD_MAX(SIMD_MUL(SIMD_ADD(strength, one), half), zero);
+        t = SIMD_MUL(t, SIMD_ADD(one, SIMD_MUL(SIMD_MUL(sim, v_scale), strength)));
+        
+        /* 2. Local inhibition: quadratic boost for edges above local average */
+        if (has_local) {
+            simd_f32 ex = SIMD_SUB(SIMD_MUL(w, v_inv_avg), one);
+            simd_f32 base = SIMD_DIV(SIMD_MAX(ex, zero), SIMD_ADD(SIMD_ABS(ex), one));
+            t = SIMD_MUL(t, SIMD_ADD(one, SIMD_MUL(base, base)));
+        }
+        
+        SIMD_STORE(out + i, t);
+        v_max = SIMD_MAX(v_max, t);
+    }
+    
+    float max = simd_hmax(v_max);
+    
+    /* Scalar remainder */
+    for (; i < count; i++) {
+        float t = weight[i] * activation;
+        float excess = similarity[i] - similarity_threshold;
+        float strength = fmaxf((excess / (fabsf(excess) + 1.0f) + 1.0f) * 0.5f, 0.0f);
+        t *= 1.0f + similarity[i] * context_scale * strength;
+        if (has_local) {
+            float ex = weight[i] * inv_local_avg - 1.0f;
+            float base = fmaxf(ex, 0.0f) / (fabsf(ex) + 1.0f);
+            t *= 1.0f + base * base;
+        }
+        out[i] = t;
+        if (t > max) max = t;
+    }
+    
+    return max;
+}
+
+/* Kernel: sum of squared deviations from mean (variance numerator) */
+static float simd_kernel_sum_sq_diff(const float *values, size_t count, float mean) {
+    const simd_f32 v_mean = SIMD_SET1(mean);
+    simd_f32 acc = SIMD_SET1(0.0f);
+    size_t i = 0;
+    
+    for (; i + 4 <= count; i += 4) {
+        simd_f32 d = SIMD_SUB(SIMD_LOAD(values + i), v_mean);
+        acc = SIMD_ADD(acc, SIMD_MUL(d, d));
+    }
+    
+    float sum = simd_hsum(acc);
+    for (; i < count; i++) {
+        float d = values[i] - mean;
+        sum += d * d;
+    }
+    return sum;
+}
+
+/* SIMD backend: batch activations (gather O(1) node state, vector kernel, scatter via setter) */
+static void simd_batch_compute_activations(Node **nodes, size_t node_count) {
+    /* One allocation for all SoA columns */
+    float *soa = (float*)malloc(6 * node_count * sizeof(float));
+    if (!soa) {
+        cpu_batch_compute_activations(nodes, node_count);
+        return;
+    }
+    float *input_sum = soa;
+    float *total_weight = soa + node_count;
+    float *weight = soa + 2 * node_count;
+    float *local_avg = soa + 3 * node_count;
+    float *bias = soa + 4 * node_count;
+    float *activation = soa + 5 * node_count;
+    
+    /* Gather (input sums with stale contributions reconciled, as the scalar path reads them) */
+    for (size_t i = 0; i < node_count; i++) {
+        Node *node = nodes[i];
+        input_sum[i] = node ? node_get_input_sum(node) : 0.0f;
+        total_weight[i] = node ? node->incoming_weight_sum : 0.0f;
+        weight[i] = node ? node->weight : 0.0f;
+        local_avg[i] = node ? node_get_local_incoming_weight_avg(node) : 0.0f;
+    }
+    
+    simd_kernel_activations(input_sum, total_weight, weight, local_avg, node_count, bias, activation);
+    
+    /* Scatter (setter pushes activation deltas to targets - sequential by design) */
+    /* A node fed by an earlier front node sees that node's new activation, exactly as in */
+    /* the sequential loop: if its input sum moved since the gather, recompute it in place */
+    for (size_t i = 0; i < node_count; i++) {
+        Node *node = nodes[i];
+        if (!node) continue;
+        if (node_get_input_sum(node) != input_sum[i]) {
+            node_set_activation_strength(node, node_compute_activation_strength(node));
+            continue;
+        }
+        node->bias = bias[i];
+        node_set_activation_strength(node, activation[i]);
+    }
+    
+    free(soa);
+}
+
+/* SIMD backend: batch edge transforms (gather weights + payload similarity, vector kernel) */
+static void simd_batch_transform_edges(Node *from_node, Edge **edges, size_t edge_count,
+                                        float *edge_outputs, float *max_output) {
+    float *soa = (float*)malloc(2 * edge_count * sizeof(float));
+    if (!soa) {
+        cpu_batch_transform_edges(from_node, edges, edge_count, edge_outputs, max_output);
+        return;
+    }
+    float *weight = soa;
+    float *similarity = soa + edge_count;
+    
+    /* Gather: weights and endpoint similarity (similarity is the only pointer-chasing part) */
+    for (size_t i = 0; i < edge_count; i++) {
+        Edge *edge = edges[i];
+        bool valid = (edge && edge->to_node);
+        weight[i] = valid ? edge->weight : 0.0f;  /* Zero weight -> zero output */
+        similarity[i] = valid ? edge_compute_pattern_similarity(from_node, edge->to_node) : 0.0f;
+    }
+    
+    float from_local_avg = node_get_local_outgoing_weight_avg(from_node);
+    float combined_avg = (from_local_avg + node_get_local_incoming_weight_avg(from_node)) / 2.0f;
+    
+    /* Kernel writes straight into the caller's output array (scatter is index-aligned) */
+    float max = simd_kernel_transform_edges(weight, similarity, edge_count,
+                                            from_node->activation_strength,
+                                            from_local_avg, combined_avg, edge_outputs);
+    
+    if (max_output) *max_output = max;
+    free(soa);
+}
+
+/* SIMD backend: batch local statistics (gather each node's outgoing weights, vector variance) */
+static void simd_batch_compute_statistics(Node **nodes, size_t node_count,
+                                          float *local_avgs_out, float *local_stds_out) {
+    float *weights = NULL;
+    size_t weights_capacity = 0;
+    
+    for (size_t i = 0; i < node_count; i++) {
+        Node *node = nodes[i];
+        if (!node) {
+            local_avgs_out[i] = 0.0f;
+            if (local_stds_out) local_stds_out[i] = 0.0f;
+            continue;
+        }
+        
+        float outgoing_avg = node_get_local_outgoing_weight_avg(node);
+        float incoming_avg = node_get_local_incoming_weight_avg(node);
+        local_avgs_out[i] = (outgoing_avg + incoming_avg) / 2.0f;
+        if (!local_stds_out) continue;
+        
+        float local_std = 0.0f;
+        if (node->outgoing_count > 1 && outgoing_avg > 0.0f) {
+            /* Gather weights into reusable SoA buffer (grows to largest degree seen) */
+            if (node->outgoing_count > weights_capacity) {
+                float *grown = (float*)realloc(weights, node->outgoing_count * sizeof(float));
+                if (!grown) {
+                    free(weights);
+                    cpu_batch_compute_statistics(nodes + i, node_count - i,
+                                                 local_avgs_out + i, local_stds_out + i);
+                    return;
+                }
+                weights = grown;
+                weights_capacity = node->outgoing_count;
+            }
+            size_t n = 0;
+            for (size_t j = 0; j < node->outgoing_count; j++) {
+                if (node->outgoing_edges[j]) weights[n++] = node->outgoing_edges[j]->weight;
+            }
+            float variance = simd_kernel_sum_sq_diff(weights, n, outgoing_avg);
+            local_std = sqrtf(variance / (float)node->outgoing_count);
+        }
+        local_stds_out[i] = local_std;
+    }
+    
+    free(weights);
+}
+
+/* SIMD backend: batch weight updates (gather weight/activation/rate, vector kernel, scatter */
+/* through node_apply_weight_update so recording, history and edge decay stay scalar) */
+static void simd_batch_update_weights(Node **nodes, size_t node_count) {
+    float *soa = (float*)malloc(6 * node_count * sizeof(float));
+    if (!soa) {
+        cpu_batch_update_weights(nodes, node_count);
+        return;
+    }
+    float *weight = soa;
+    float *activation = soa + node_count;
+    float *rate = soa + 2 * node_count;
+    float *out_avg = soa + 3 * node_count;
+    float *in_avg = soa + 4 * node_count;
+    float *new_weight = soa + 5 * node_count;
+    
+    /* Gather (rate read through the same accessor the scalar path uses, plus the local */
+    /* averages it was computed from) */
+    for (size_t i = 0; i < node_count; i++) {
+        Node *node = nodes[i];
+        weight[i] = node ? node->weight : 0.0f;
+        activation[i] = node ? node->activation_strength : 0.0f;
+        rate[i] = node ? node_get_adaptive_learning_rate(node) : 0.0f;
+        out_avg[i] = node ? node_get_local_outgoing_weight_avg(node) : 0.0f;
+        in_avg[i] = node ? node_get_local_incoming_weight_avg(node) : 0.0f;
+    }
+    
+    simd_kernel_update_weights(weight, activation, rate, node_count, new_weight);
+    
+    /* Scatter in order. An earlier update decays its node's edges, which can move a later */
+    /* neighbour's local averages (and so its rate): if any gathered input moved, update */
+    /* that node in place exactly as the sequential loop would */
+    for (size_t i = 0; i < node_count; i++) {
+        Node *node = nodes[i];
+        if (!node) continue;
+        if (node->weight != weight[i] || node->activation_strength != activation[i] ||
+            node_get_local_outgoing_weight_avg(node) != out_avg[i] ||
+            node_get_local_incoming_weight_avg(node) != in_avg[i]) {
+            node_update_weight_local(node);
+            continue;
+        }
+        node_apply_weight_update(node, rate[i], new_weight[i]);
+    }
+    
+    free(soa);
+}
+
+#else
+
+/* No SIMD on this target - vectorized backend maps to scalar loops (never selected at init) */
+static void simd_batch_compute_activations(Node **nodes, size_t node_count) {
+    cpu_batch_compute_activations(nodes, node_count);
+}
+static void simd_batch_transform_edges(Node *from_node, Edge **edges, size_t edge_count,
+                                        float *edge_outputs, float *max_output) {
+    cpu_batch_transform_edges(from_node, edges, edge_count, edge_outputs, max_output);
+}
+static void simd_batch_compute_statistics(Node **nodes, size_t node_count,
+                                          float *local_avgs_out, float *local_stds_out) {
+    cpu_batch_compute_statistics(nodes, node_count, local_avgs_out, local_stds_out);
+}
+static void simd_batch_update_weights(Node **nodes, size_t node_count) {
+    cpu_batch_update_weights(nodes, node_count);
+}
+
+#endif /* MELVIN_SIMD_BACKEND */
+
 /* GPU-accelerated operations with CPU fallback */
 void melvin_gpu_batch_compute_activations(MelvinGPUContext *ctx, Node **nodes, size_t node_count) {
     if (!ctx || !nodes || node_count == 0) return;
     
-    /* Always use CPU implementation for now */
+    /* Vectorized CPU backend when selected; CUDA path still uses the CPU implementation */
     /* Full GPU implementation would require flattening the pointer-based graph structure */
     /* This is a framework - future work can optimize specific hot spots */
+    if (ctx->backend == MELVIN_BACKEND_CPU_SIMD) {
+        simd_batch_compute_activations(nodes, node_count);
+        return;
+    }
     cpu_batch_compute_activations(nodes, node_count);
 }
 
@@ -195,8 +604,12 @@ void melvin_gpu_batch_transform_edges(MelvinGPUContext *ctx, Node *from_node,
         return;
     }
     
-    /* Always use CPU implementation for now */
+    /* Vectorized CPU backend when selected; CUDA path still uses the CPU implementation */
     /* Full GPU implementation would require flattening the pointer-based graph structure */
+    if (ctx->backend == MELVIN_BACKEND_CPU_SIMD) {
+        simd_batch_transform_edges(from_node, edges, edge_count, edge_outputs, max_output);
+        return;
+    }
     cpu_batch_transform_edges(from_node, edges, edge_count, edge_outputs, max_output);
 }
 
@@ -204,16 +617,24 @@ void melvin_gpu_batch_compute_statistics(MelvinGPUContext *ctx, Node **nodes, si
                                          float *local_avgs_out, float *local_stds_out) {
     if (!ctx || !nodes || !local_avgs_out || node_count == 0) return;
     
-    /* Always use CPU implementation for now */
+    /* Vectorized CPU backend when selected; CUDA path still uses the CPU implementation */
     /* Full GPU implementation would require flattening the pointer-based graph structure */
+    if (ctx->backend == MELVIN_BACKEND_CPU_SIMD) {
+        simd_batch_compute_statistics(nodes, node_count, local_avgs_out, local_stds_out);
+        return;
+    }
     cpu_batch_compute_statistics(nodes, node_count, local_avgs_out, local_stds_out);
 }
 
 void melvin_gpu_batch_update_weights(MelvinGPUContext *ctx, Node **nodes, size_t node_count) {
     if (!ctx || !nodes || node_count == 0) return;
     
-    /* Always use CPU implementation for now */
+    /* Vectorized CPU backend when selected; CUDA path still uses the CPU implementation */
     /* Full GPU implementation would require flattening the pointer-based graph structure */
+    if (ctx->backend == MELVIN_BACKEND_CPU_SIMD) {
+        simd_batch_update_weights(nodes, node_count);
+        return;
+    }
     cpu_batch_update_weights(nodes, node_count);
 }
 
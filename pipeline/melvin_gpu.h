@@ -14,8 +14,16 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+/* Compute backend behind the batch API (selected automatically at init) */
+typedef enum {
+    MELVIN_BACKEND_SCALAR = 0,   /* Plain per-item CPU loops */
+    MELVIN_BACKEND_CPU_SIMD = 1, /* Vectorized CPU kernels (SSE2 / NEON) over SoA buffers */
+    MELVIN_BACKEND_CUDA = 2      /* CUDA device */
+} MelvinComputeBackend;
+
 /* GPU Context - manages GPU state and auto-detection */
 typedef struct MelvinGPUContext {
+    MelvinComputeBackend backend;  /* Backend serving batch operations */
     bool gpu_available;      /* True if GPU was successfully initialized */
     bool cuda_available;     /* True if CUDA is available */
     int device_count;        /* Number of CUDA devices available */
@@ -41,6 +49,10 @@ bool melvin_gpu_is_available(MelvinGPUContext *ctx);
 /* Get GPU context singleton (auto-initializes on first call) */
 MelvinGPUContext* melvin_gpu_get_context(void);
 
+/* Check if batch operations are accelerated (CUDA or vectorized CPU backend) */
+/* Callers use this to decide whether batching beats per-item processing */
+bool melvin_gpu_has_batch_backend(MelvinGPUContext *ctx);
+
 /* ========================================
  * GPU-ACCELERATED OPERATIONS (with CPU fallback)
  * ======================================== */
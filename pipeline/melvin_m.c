@@ -4,12 +4,15 @@
  * Implements binary .m file format using rules from melvin.c
  */
 
+#define _POSIX_C_SOURCE 200809L  /* strdup */
+
 #include "melvin_m.h"
 #include "melvin.h"
 #include <string.h>
 #include <time.h>
 #include <errno.h>
 #include <stdlib.h>
+#include <unistd.h>  /* ftruncate */
 
 /* ========================================
  * INTERNAL HELPER FUNCTIONS
@@ -40,8 +43,42 @@ static bool read_header(FILE *file, MelvinMHeader *header) {
     return true;
 }
 
-/* Write nodes to file */
-static bool write_nodes(FILE *file, MelvinGraph *graph, uint64_t offset) {
+/* ROPE: Node pointer -> file index, for writing combined nodes as references to their parts */
+typedef struct NodeFileIndex {
+    const Node *node;
+    uint64_t index;
+} NodeFileIndex;
+
+static int compare_node_file_index(const void *a, const void *b) {
+    uintptr_t pa = (uintptr_t)((const NodeFileIndex*)a)->node;
+    uintptr_t pb = (uintptr_t)((const NodeFileIndex*)b)->node;
+    return (pa > pb) - (pa < pb);
+}
+
+/* File index of node if it was written before `before` (parts must load before their parent) */
+static bool node_file_index_find(const NodeFileIndex *index, size_t count, const Node *node,
+                                 uint64_t before, uint64_t *out) {
+    if (!index || !node) return false;
+    NodeFileIndex key = { node, 0 };
+    const NodeFileIndex *found = (const NodeFileIndex*)bsearch(&key, index, count, sizeof(NodeFileIndex),
+                                                               compare_node_file_index);
+    if (!found || found->index >= before) return false;
+    *out = found->index;
+    return true;
+}
+
+/* Write payload bytes, streamed from rope nodes in chunks (no flattening) */
+static bool write_payload_bytes(FILE *file, Node *node) {
+    uint8_t chunk[4096];
+    for (size_t offset = 0; offset < node->payload_size; offset += sizeof(chunk)) {
+        size_t n = node_payload_read(node, offset, chunk, sizeof(chunk));
+        if (fwrite(chunk, 1, n, file) != n) return false;
+    }
+    return true;
+}
+
+/* Write nodes to file (rope_payloads: combined nodes written as part indices, not bytes) */
+static bool write_nodes(FILE *file, MelvinGraph *graph, uint64_t offset, bool rope_payloads) {
     if (!file || !graph) return false;
     
     if (fseek(file, (long)offset, SEEK_SET) != 0) return false;
@@ -50,36 +87,59 @@ static bool write_nodes(FILE *file, MelvinGraph *graph, uint64_t offset) {
     uint64_t node_count = graph->node_count;
     if (fwrite(&node_count, sizeof(uint64_t), 1, file) != 1) return false;
     
+    NodeFileIndex *index = NULL;
+    if (rope_payloads && graph->node_count > 0) {
+        index = (NodeFileIndex*)malloc(graph->node_count * sizeof(NodeFileIndex));
+        if (!index) return false;
+        for (size_t i = 0; i < graph->node_count; i++) {
+            index[i].node = graph->nodes[i];
+            index[i].index = i;
+        }
+        qsort(index, graph->node_count, sizeof(NodeFileIndex), compare_node_file_index);
+    }
+    
     /* Write each node */
-    for (size_t i = 0; i < graph->node_count; i++) {
+    bool ok = true;
+    for (size_t i = 0; i < graph->node_count && ok; i++) {
         Node *node = graph->nodes[i];
         if (!node) continue;
         
         /* Write node ID */
-        if (fwrite(node->id, 9, 1, file) != 1) return false;
+        ok = fwrite(node->id, 9, 1, file) == 1;
         
         /* Write activation_strength, weight, and bias (replacing bool activation) */
-        if (fwrite(&node->activation_strength, sizeof(float), 1, file) != 1) return false;
-        if (fwrite(&node->weight, sizeof(float), 1, file) != 1) return false;
-        if (fwrite(&node->bias, sizeof(float), 1, file) != 1) return false;
+        ok = ok && fwrite(&node->activation_strength, sizeof(float), 1, file) == 1;
+        ok = ok && fwrite(&node->weight, sizeof(float), 1, file) == 1;
+        ok = ok && fwrite(&node->bias, sizeof(float), 1, file) == 1;
         
         /* Write payload size */
         uint64_t payload_size = node->payload_size;
-        if (fwrite(&payload_size, sizeof(uint64_t), 1, file) != 1) return false;
+        ok = ok && fwrite(&payload_size, sizeof(uint64_t), 1, file) == 1;
         
-        /* Write payload data if exists */
-        if (payload_size > 0) {
-            if (fwrite(node->payload, 1, payload_size, file) != payload_size) return false;
+        /* ROPE: Combined node whose parts are already written - store the two part indices */
+        if (rope_payloads) {
+            uint64_t parts[2];
+            uint8_t has_parts = node_file_index_find(index, graph->node_count, node->payload_left, i, &parts[0]) &&
+                                node_file_index_find(index, graph->node_count, node->payload_right, i, &parts[1]);
+            ok = ok && fwrite(&has_parts, 1, 1, file) == 1;
+            if (has_parts) {
+                ok = ok && fwrite(parts, sizeof(uint64_t), 2, file) == 2;
+                continue;
+            }
         }
         
+        /* Write payload data if exists */
+        if (ok && payload_size > 0) ok = write_payload_bytes(file, node);
+        
         /* Note: Edge pointers are not stored - they're reconstructed from edges */
     }
     
-    return true;
+    free(index);
+    return ok;
 }
 
-/* Read nodes from file */
-static bool read_nodes(FILE *file, MelvinGraph *graph, uint64_t offset) {
+/* Read nodes from file (rope_payloads: records may reference earlier nodes as their parts) */
+static bool read_nodes(FILE *file, MelvinGraph *graph, uint64_t offset, bool rope_payloads) {
     if (!file || !graph) return false;
     
     if (fseek(file, (long)offset, SEEK_SET) != 0) return false;
@@ -107,9 +167,20 @@ static bool read_nodes(FILE *file, MelvinGraph *graph, uint64_t offset) {
         /* Read payload size */
         if (fread(&payload_size, sizeof(uint64_t), 1, file) != 1) return false;
         
+        /* ROPE: Combined node stored as its two (already loaded) parts */
+        uint8_t has_parts = 0;
+        uint64_t parts[2] = {0, 0};
+        if (rope_payloads) {
+            if (fread(&has_parts, 1, 1, file) != 1) return false;
+            if (has_parts) {
+                if (fread(parts, sizeof(uint64_t), 2, file) != 2) return false;
+                if (parts[0] >= graph->node_count || parts[1] >= graph->node_count) return false;
+            }
+        }
+        
         /* Read payload data */
         uint8_t *payload = NULL;
-        if (payload_size > 0) {
+        if (!has_parts && payload_size > 0) {
             payload = (uint8_t*)malloc(payload_size);
             if (!payload) return false;
             if (fread(payload, 1, payload_size, file) != payload_size) {
@@ -119,14 +190,17 @@ static bool read_nodes(FILE *file, MelvinGraph *graph, uint64_t offset) {
         }
         
         /* Create node using melvin.c rules */
-        Node *node = node_create(payload, payload_size);
-        if (!node) {
+        Node *node = has_parts ? node_create_rope(graph->nodes[parts[0]], graph->nodes[parts[1]])
+                               : node_create(payload, payload_size);
+        if (!node || node->payload_size != payload_size) {
+            node_free(node);
             if (payload) free(payload);
             return false;
         }
         
         /* Override ID (since node_create generates new one) */
-        strncpy(node->id, id, 9);
+        /* IDs are binary (big-endian counter) and usually start with 0 bytes - copy, don't strncpy */
+        memcpy(node->id, id, 8);
         node->id[8] = '\0';
         
         /* Set state */
@@ -147,8 +221,8 @@ static bool read_nodes(FILE *file, MelvinGraph *graph, uint64_t offset) {
     return true;
 }
 
-/* Write edges to file */
-static bool write_edges(FILE *file, MelvinGraph *graph, uint64_t offset) {
+/* Write edges to file (half_weights: 2-byte IEEE half weights instead of 4-byte float) */
+static bool write_edges(FILE *file, MelvinGraph *graph, uint64_t offset, bool half_weights) {
     if (!file || !graph) return false;
     
     if (fseek(file, (long)offset, SEEK_SET) != 0) return false;
@@ -163,18 +237,26 @@ static bool write_edges(FILE *file, MelvinGraph *graph, uint64_t offset) {
         if (!edge) continue;
         
         /* Write edge data (store node IDs from node pointers) */
+        bool direction = edge->direction;
+        bool activation = edge->activation;
         if (fwrite(edge->from_node->id, 9, 1, file) != 1) return false;
         if (fwrite(edge->to_node->id, 9, 1, file) != 1) return false;
-        if (fwrite(&edge->direction, sizeof(bool), 1, file) != 1) return false;
-        if (fwrite(&edge->activation, sizeof(bool), 1, file) != 1) return false;
-        if (fwrite(&edge->weight, sizeof(float), 1, file) != 1) return false;
+        if (fwrite(&direction, sizeof(bool), 1, file) != 1) return false;
+        if (fwrite(&activation, sizeof(bool), 1, file) != 1) return false;
+        if (half_weights) {
+            uint16_t bits = melvin_weight_to_half(edge->weight);
+            if (fwrite(&bits, sizeof(uint16_t), 1, file) != 1) return false;
+        } else {
+            float weight = edge->weight;
+            if (fwrite(&weight, sizeof(float), 1, file) != 1) return false;
+        }
     }
     
     return true;
 }
 
-/* Read edges from file */
-static bool read_edges(FILE *file, MelvinGraph *graph, uint64_t offset) {
+/* Read edges from file (half_weights: section was written with 2-byte IEEE half weights) */
+static bool read_edges(FILE *file, MelvinGraph *graph, uint64_t offset, bool half_weights) {
     if (!file || !graph) return false;
     
     if (fseek(file, (long)offset, SEEK_SET) != 0) return false;
@@ -194,15 +276,21 @@ static bool read_edges(FILE *file, MelvinGraph *graph, uint64_t offset) {
         if (fread(to_id, 9, 1, file) != 1) return false;
         if (fread(&direction, sizeof(bool), 1, file) != 1) return false;
         if (fread(&activation, sizeof(bool), 1, file) != 1) return false;
-        if (fread(&weight, sizeof(float), 1, file) != 1) return false;
+        if (half_weights) {
+            uint16_t bits;
+            if (fread(&bits, sizeof(uint16_t), 1, file) != 1) return false;
+            weight = melvin_half_to_weight(bits);
+        } else {
+            if (fread(&weight, sizeof(float), 1, file) != 1) return false;
+        }
         
         /* Find nodes by ID (temporary helper for file loading only) */
         Node *from = NULL, *to = NULL;
         for (size_t j = 0; j < graph->node_count; j++) {
-            if (graph->nodes[j] && strcmp(graph->nodes[j]->id, from_id) == 0) {
+            if (graph->nodes[j] && memcmp(graph->nodes[j]->id, from_id, 8) == 0) {
                 from = graph->nodes[j];
             }
-            if (graph->nodes[j] && strcmp(graph->nodes[j]->id, to_id) == 0) {
+            if (graph->nodes[j] && memcmp(graph->nodes[j]->id, to_id, 8) == 0) {
                 to = graph->nodes[j];
             }
         }
@@ -318,34 +406,6 @@ static bool read_universal_input(FILE *file, uint8_t **data, size_t *size, uint6
     return true;
 }
 
-/* Calculate file offsets (adaptive layout) */
-static void calculate_offsets(MelvinMHeader *header) {
-    uint64_t offset = sizeof(MelvinMHeader);
-    
-    /* Nodes section */
-    header->nodes_offset = offset;
-    offset += sizeof(uint64_t); /* Node count */
-    /* Actual node data size calculated during write */
-    
-    /* Edges section (after nodes) */
-    header->edges_offset = offset;
-    offset += sizeof(uint64_t); /* Edge count */
-    /* Actual edge data size calculated during write */
-    
-    /* Universal input section */
-    header->universal_input_offset = offset;
-    offset += sizeof(uint64_t); /* Size */
-    offset += header->universal_input_size;
-    
-    /* Universal output section */
-    header->universal_output_offset = offset;
-    offset += sizeof(uint64_t); /* Size */
-    offset += header->universal_output_size;
-    
-    /* Payloads are stored inline with nodes */
-    header->payloads_offset = 0; /* Not used separately */
-}
-
 /* ========================================
  * PUBLIC API IMPLEMENTATION
  * ======================================== */
@@ -373,7 +433,11 @@ MelvinMFile* melvin_m_create(const char *filename) {
     /* Initialize header */
     mfile->header.magic = MELVIN_M_MAGIC;
     mfile->header.version = MELVIN_M_VERSION;
+#if defined(MELVIN_COMPACT_WEIGHTS) && defined(__FLT16_MAX__)
+    mfile->header.flags = MELVIN_M_FLAG_HALF_WEIGHTS;  /* Weights are half in memory - no point widening */
+#else
     mfile->header.flags = 0;
+#endif
     mfile->header.node_count = 0;
     mfile->header.edge_count = 0;
     mfile->header.universal_input_size = 0;
@@ -457,7 +521,8 @@ MelvinMFile* melvin_m_open(const char *filename) {
     }
     
     /* Read nodes */
-    if (!read_nodes(mfile->file, mfile->graph, mfile->header.nodes_offset)) {
+    if (!read_nodes(mfile->file, mfile->graph, mfile->header.nodes_offset,
+                    (mfile->header.flags & MELVIN_M_FLAG_ROPE_PAYLOADS) != 0)) {
         graph_free(mfile->graph);
         fclose(mfile->file);
         free(mfile->filename);
@@ -466,7 +531,8 @@ MelvinMFile* melvin_m_open(const char *filename) {
     }
     
     /* Read edges */
-    if (!read_edges(mfile->file, mfile->graph, mfile->header.edges_offset)) {
+    if (!read_edges(mfile->file, mfile->graph, mfile->header.edges_offset,
+                    (mfile->header.flags & MELVIN_M_FLAG_HALF_WEIGHTS) != 0)) {
         graph_free(mfile->graph);
         fclose(mfile->file);
         free(mfile->filename);
@@ -474,6 +540,12 @@ MelvinMFile* melvin_m_open(const char *filename) {
         return NULL;
     }
     
+    /* CANONICAL: Generalizations are recognized from their edges once, not on every lookup */
+    graph_register_generalizations(mfile->graph);
+    
+    /* CANONICAL: Older files store combined nodes as flat bytes - only they can miss the registry */
+    mfile->graph->combinations_unrecorded = (mfile->header.flags & MELVIN_M_FLAG_ROPE_PAYLOADS) == 0;
+    
     /* Read universal input */
     size_t input_size;
     if (!read_universal_input(mfile->file, &mfile->universal_input, &input_size, 
@@ -525,29 +597,51 @@ bool melvin_m_save(MelvinMFile *mfile) {
     mfile->header.last_modified = (uint64_t)time(NULL);
     mfile->header.adaptation_count++;
     
-    /* Calculate offsets */
-    calculate_offsets(&mfile->header);
+    /* LAZY DECAY: Persist settled edge weights (apply decay still pending on any node) */
+    graph_reconcile_edge_decay(mfile->graph);
     
-    /* Write header */
-    if (!write_header(mfile->file, &mfile->header)) return false;
+    /* Sections are laid out back to back in write order: node and edge section sizes */
+    /* depend on payloads and weight encoding, so each offset is taken where the last ended */
+    FILE *file = mfile->file;
+    mfile->header.payloads_offset = 0;  /* Payloads are stored inline with nodes */
     
     /* Write nodes */
-    if (!write_nodes(mfile->file, mfile->graph, mfile->header.nodes_offset)) return false;
+    mfile->header.nodes_offset = sizeof(MelvinMHeader);
+    mfile->header.flags |= MELVIN_M_FLAG_ROPE_PAYLOADS;  /* Combined nodes saved as part references */
+    if (!write_nodes(file, mfile->graph, mfile->header.nodes_offset, true)) return false;
     
     /* Write edges */
-    if (!write_edges(mfile->file, mfile->graph, mfile->header.edges_offset)) return false;
+    long pos = ftell(file);
+    if (pos < 0) return false;
+    mfile->header.edges_offset = (uint64_t)pos;
+    if (!write_edges(file, mfile->graph, mfile->header.edges_offset,
+                     (mfile->header.flags & MELVIN_M_FLAG_HALF_WEIGHTS) != 0)) return false;
     
     /* Write universal input */
-    if (!write_universal_input(mfile->file, mfile->universal_input, 
+    pos = ftell(file);
+    if (pos < 0) return false;
+    mfile->header.universal_input_offset = (uint64_t)pos;
+    if (!write_universal_input(file, mfile->universal_input, 
                                mfile->header.universal_input_size,
                                mfile->header.universal_input_offset)) return false;
     
     /* Write universal output */
-    if (!write_universal_output(mfile->file, mfile->universal_output,
+    pos = ftell(file);
+    if (pos < 0) return false;
+    mfile->header.universal_output_offset = (uint64_t)pos;
+    if (!write_universal_output(file, mfile->universal_output,
                                 mfile->header.universal_output_size,
                                 mfile->header.universal_output_offset)) return false;
     
-    fflush(mfile->file);
+    /* Drop any tail left by a larger earlier save */
+    pos = ftell(file);
+    fflush(file);
+    if (pos >= 0 && ftruncate(fileno(file), (off_t)pos) != 0) return false;
+    
+    /* Write header last (offsets are final now) */
+    if (!write_header(file, &mfile->header)) return false;
+    
+    fflush(file);
     mfile->is_dirty = false;
     
     return true;
@@ -600,11 +694,24 @@ bool melvin_m_universal_input_write(MelvinMFile *mfile, const uint8_t *data, siz
     /* Write data */
     memcpy(mfile->universal_input, data, size);
     mfile->header.universal_input_size = size;
+    mfile->has_input_meta = false;  /* FRAMING: Raw input carries its port byte first */
     melvin_m_mark_dirty(mfile);
     
     return true;
 }
 
+/* FRAMING: Payload-only input - frame metadata rides beside the bytes instead of in front of */
+/* them, so timestamps and sizes never become nodes. Metadata applies until the next write/clear */
+bool melvin_m_universal_input_write_payload(MelvinMFile *mfile, const MelvinInputMeta *meta,
+                                           const uint8_t *data, size_t size) {
+    if (!mfile || !meta) return false;
+    if (!melvin_m_universal_input_write(mfile, data, size)) return false;
+    
+    mfile->input_meta = *meta;
+    mfile->has_input_meta = true;
+    return true;
+}
+
 size_t melvin_m_universal_input_read(MelvinMFile *mfile, uint8_t *buffer, size_t buffer_size) {
     if (!mfile || !buffer || buffer_size == 0) return 0;
     
@@ -630,6 +737,7 @@ void melvin_m_universal_input_clear(MelvinMFile *mfile) {
         memset(mfile->universal_input, 0, mfile->universal_input_capacity);
     }
     mfile->header.universal_input_size = 0;
+    mfile->has_input_meta = false;
     melvin_m_mark_dirty(mfile);
 }
 
@@ -699,17 +807,37 @@ Edge* melvin_m_add_edge(MelvinMFile *mfile, Node *from, Node *to, bool direction
 }
 
 bool melvin_m_process_input(MelvinMFile *mfile) {
+    return melvin_m_process_input_decode(mfile, NULL, NULL, NULL);
+}
+
+/* STREAMING: Same processing; emit sees each output payload as it is generated */
+bool melvin_m_process_input_stream(MelvinMFile *mfile, OutputStreamFunc emit, void *ctx) {
+    return melvin_m_process_input_decode(mfile, NULL, emit, ctx);
+}
+
+/* DECODING: Same processing with this call's decoding mode and caps (NULL = the brain's default) */
+bool melvin_m_process_input_decode(MelvinMFile *mfile, const MelvinDecodeConfig *decode,
+                                   OutputStreamFunc emit, void *emit_ctx) {
     if (!mfile || !mfile->graph) return false;
     
     /* Clear universal output */
     melvin_m_universal_output_clear(mfile);
     
+    /* GROWTH BUDGET: Optional structure this input may add scales with its size (no-op if uncapped) */
+    graph_begin_growth_budget(mfile->graph, mfile->header.universal_input_size);
+    
     /* Extract input port ID from input buffer (CAN bus format: first byte is port_id) */
     /* This is ephemeral context for routing output to correct port */
     /* Port ID stays in payload for pattern learning (unified graph), but we track it */
     /* separately for I/O routing purposes */
+    /* FRAMING: Payload-only input takes port ID and timestamp from its metadata instead - */
+    /* nothing but the device bytes below gets segmented */
     mfile->last_input_port_id = 0;  /* Default: no port ID */
-    if (mfile->universal_input && mfile->header.universal_input_size > 0) {
+    mfile->last_input_timestamp = 0;
+    if (mfile->has_input_meta) {
+        mfile->last_input_port_id = mfile->input_meta.port_id;
+        mfile->last_input_timestamp = mfile->input_meta.timestamp;
+    } else if (mfile->universal_input && mfile->header.universal_input_size > 0) {
         mfile->last_input_port_id = mfile->universal_input[0];  /* First byte = port_id */
     }
     
@@ -739,7 +867,8 @@ bool melvin_m_process_input(MelvinMFile *mfile) {
     /* STEP 2: Create edges from all mechanisms (intelligent edge formation) */
     /* Co-activation, similarity, context, hierarchy, and homeostatic edges */
     /* Multiple mechanisms create rich graph structure for semantic understanding */
-    if (initial_nodes && initial_count > 0) {
+    /* DEADLINE: Skipped when the budget is already spent (output still generated below) */
+    if (initial_nodes && initial_count > 0 && !graph_deadline_expired(mfile->graph)) {
         wave_form_intelligent_edges(mfile->graph, initial_nodes, initial_count, NULL, NULL);
     }
     
@@ -749,6 +878,9 @@ bool melvin_m_process_input(MelvinMFile *mfile) {
         wave_propagate_multi_step(mfile->graph, initial_nodes, initial_count);
     }
     
+    /* GROWTH BUDGET: Admit what every law proposed for this input, strongest first (no-op if uncapped) */
+    graph_settle_growth(mfile->graph);
+    
     /* STEP 4: Hierarchy formation emerges naturally from edge weight growth during co-activation */
     /* No explicit check needed - hierarchy forms implicitly when patterns repeat and edges strengthen */
     /* See wave_create_edges_from_coactivation() for natural hierarchy emergence */
@@ -759,7 +891,9 @@ bool melvin_m_process_input(MelvinMFile *mfile) {
     /* come from direct input nodes and learned sequential patterns (co-activation edges) */
     uint8_t *output = NULL;
     size_t output_size = 0;
-    wave_collect_output(mfile->graph, initial_nodes, initial_count, &output, &output_size);
+    wave_collect_output_decode(mfile->graph, initial_nodes, initial_count, decode, emit, emit_ctx,
+                               &output, &output_size);
+    graph_end_growth_budget(mfile->graph);
     
     if (output && output_size > 0) {
         if (output_size > mfile->universal_output_capacity) {
@@ -781,9 +915,119 @@ bool melvin_m_process_input(MelvinMFile *mfile) {
     if (seq_nodes) free(seq_nodes);
     melvin_m_mark_dirty(mfile);
     
+    /* DEADLINE: Report whether this call stopped early (best-so-far output) */
+    mfile->last_process_truncated = mfile->graph->deadline_truncated;
+    
     return true;
 }
 
+/* Process input with a wall-clock budget: propagation and generation stop at the deadline */
+/* Output is whatever was produced in time; melvin_m_last_process_truncated() reports it */
+bool melvin_m_process_input_deadline(MelvinMFile *mfile, uint64_t budget_us) {
+    if (!mfile || !mfile->graph) return false;
+    
+    graph_set_deadline(mfile->graph, budget_us);
+    bool result = melvin_m_process_input(mfile);
+    graph_set_deadline(mfile->graph, 0);  /* Deadline applies to this call only */
+    
+    return result;
+}
+
+bool melvin_m_last_process_truncated(MelvinMFile *mfile) {
+    return mfile && mfile->last_process_truncated;
+}
+
+/* Seed this brain's output sampling (not persisted - a reopened file starts at the default seed) */
+void melvin_m_set_seed(MelvinMFile *mfile, uint64_t seed) {
+    if (!mfile || !mfile->graph) return;
+    graph_set_seed(mfile->graph, seed);
+}
+
+/* SAMPLING: Not persisted - a reopened file samples exactly until fast sampling is set again */
+void melvin_m_set_fast_sampling(MelvinMFile *mfile, size_t alias_min_degree) {
+    if (!mfile || !mfile->graph) return;
+    graph_set_fast_sampling(mfile->graph, alias_min_degree);
+}
+
+/* DECODING: Not persisted - a reopened file decodes with unbounded sampling */
+void melvin_m_set_decoding(MelvinMFile *mfile, const MelvinDecodeConfig *config) {
+    if (!mfile || !mfile->graph) return;
+    graph_set_decoding(mfile->graph, config);
+}
+
+/* GROWTH BUDGET: Not persisted - a reopened file starts uncapped; counters are per session */
+void melvin_m_set_growth_budget(MelvinMFile *mfile, float nodes_per_byte) {
+    if (!mfile || !mfile->graph) return;
+    graph_set_growth_budget(mfile->graph, nodes_per_byte);
+}
+
+GrowthStats melvin_m_get_growth_stats(MelvinMFile *mfile) {
+    GrowthStats stats = {0};
+    if (mfile && mfile->graph) stats = mfile->graph->growth_stats;
+    return stats;
+}
+
+/* MEMOIZATION: Not persisted - a reopened file walks every output until a cache is set again */
+bool melvin_m_set_output_cache(MelvinMFile *mfile, size_t capacity) {
+    if (!mfile || !mfile->graph) return false;
+    return graph_set_output_cache(mfile->graph, capacity);
+}
+
+OutputCacheStats melvin_m_get_output_cache_stats(MelvinMFile *mfile) {
+    OutputCacheStats stats = {0};
+    if (mfile && mfile->graph) stats = mfile->graph->output_cache_stats;
+    return stats;
+}
+
+/* MEMOIZATION: Not persisted - a reopened file segments every input until a cache is set again */
+bool melvin_m_set_segment_cache(MelvinMFile *mfile, size_t slots) {
+    if (!mfile || !mfile->graph) return false;
+    return graph_set_segment_cache(mfile->graph, slots);
+}
+
+SegmentCacheStats melvin_m_get_segment_cache_stats(MelvinMFile *mfile) {
+    SegmentCacheStats stats = {0};
+    if (mfile && mfile->graph) stats = mfile->graph->segment_cache_stats;
+    return stats;
+}
+
+/* READ-ONLY: Answer input without learning - no nodes/edges/weights change, file stays clean */
+/* Every input byte is segmented, so frame it the way the brain learned: port byte first */
+/* after universal_input_write, the payload alone after universal_input_write_payload (which */
+/* is how ports feed input). Universal I/O is untouched */
+/* Safe to call from many threads at once on one file, as long as no learning call runs meanwhile */
+bool melvin_m_query(MelvinMFile *mfile, const uint8_t *input, size_t input_size,
+                    uint8_t **output, size_t *output_size) {
+    return melvin_m_query_deadline(mfile, input, input_size, 0, output, output_size, NULL);
+}
+
+/* READ-ONLY query with a wall-clock budget (0 = none); truncated (optional) reports a deadline stop */
+bool melvin_m_query_deadline(MelvinMFile *mfile, const uint8_t *input, size_t input_size, uint64_t budget_us,
+                             uint8_t **output, size_t *output_size, bool *truncated) {
+    if (!mfile || !mfile->graph) return false;
+    return graph_query(mfile->graph, input, input_size, budget_us, output, output_size, truncated);
+}
+
+QueryStats melvin_m_get_query_stats(MelvinMFile *mfile) {
+    QueryStats stats = {0};
+    if (!mfile || !mfile->graph) return stats;
+    stats.queries = __atomic_load_n(&mfile->graph->query_stats.queries, __ATOMIC_RELAXED);
+    stats.seeds = __atomic_load_n(&mfile->graph->query_stats.seeds, __ATOMIC_RELAXED);
+    stats.reached = __atomic_load_n(&mfile->graph->query_stats.reached, __ATOMIC_RELAXED);
+    return stats;
+}
+
+/* Choose the edge weight encoding used by the next save (kept in the header flags) */
+void melvin_m_set_half_weights(MelvinMFile *mfile, bool enabled) {
+    if (!mfile) return;
+    if (enabled) {
+        mfile->header.flags |= MELVIN_M_FLAG_HALF_WEIGHTS;
+    } else {
+        mfile->header.flags &= ~MELVIN_M_FLAG_HALF_WEIGHTS;
+    }
+    mfile->is_dirty = true;
+}
+
 /* Adaptive Operations */
 void melvin_m_mark_dirty(MelvinMFile *mfile) {
     if (mfile) {
@@ -806,10 +1050,16 @@ uint64_t melvin_m_get_adaptation_count(MelvinMFile *mfile) {
  * ======================================== */
 
 /* Get last input port ID from the most recent process_input call (for output routing) */
-/* Port ID is extracted from input buffer (CAN bus format: first byte is port_id) */
+/* Port ID comes from the input's metadata, or the input buffer (CAN bus format: first byte) */
 /* This is ephemeral context - used to route output to correct port based on input port */
 uint8_t melvin_m_get_last_input_port_id(MelvinMFile *mfile) {
     if (!mfile) return 0;
     return mfile->last_input_port_id;
 }
 
+/* FRAMING: Ephemeral like the port ID - set by payload-only input, 0 for raw framing */
+uint64_t melvin_m_get_last_input_timestamp(MelvinMFile *mfile) {
+    if (!mfile) return 0;
+    return mfile->last_input_timestamp;
+}
+
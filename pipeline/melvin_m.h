@@ -44,6 +44,10 @@ bool melvin_m_save(MelvinMFile *mfile);
 /* Close .m file */
 void melvin_m_close(MelvinMFile *mfile);
 
+/* Store edge weights as IEEE half in the edge section (2 bytes instead of 4) */
+/* Default: on in compact builds (MELVIN_COMPACT_WEIGHTS), off otherwise; persists in the file */
+void melvin_m_set_half_weights(MelvinMFile *mfile, bool enabled);
+
 /* ========================================
  * UNIVERSAL INPUT OPERATIONS
  * ======================================== */
@@ -51,6 +55,13 @@ void melvin_m_close(MelvinMFile *mfile);
 /* Write data to universal input buffer */
 bool melvin_m_universal_input_write(MelvinMFile *mfile, const uint8_t *data, size_t size);
 
+/* Write device payload to universal input with its frame metadata carried separately. Only the */
+/* payload bytes are segmented and learned; the port ID routes output and the timestamp is kept */
+/* for melvin_m_get_last_input_timestamp. A plain universal_input_write reverts to CAN-style */
+/* framing (port byte first, learned with the data) */
+bool melvin_m_universal_input_write_payload(MelvinMFile *mfile, const MelvinInputMeta *meta,
+                                           const uint8_t *data, size_t size);
+
 /* Read data from universal input buffer */
 size_t melvin_m_universal_input_read(MelvinMFile *mfile, uint8_t *buffer, size_t buffer_size);
 
@@ -89,6 +100,86 @@ Edge* melvin_m_add_edge(MelvinMFile *mfile, Node *from, Node *to, bool direction
 /* Process universal input through graph via wave propagation (writes to universal output) */
 bool melvin_m_process_input(MelvinMFile *mfile);
 
+/* Process universal input with a wall-clock budget in microseconds (0 = no deadline) */
+/* Propagation and output generation stop when time runs out; output holds the best so far */
+bool melvin_m_process_input_deadline(MelvinMFile *mfile, uint64_t budget_us);
+
+/* Streaming variant: emit receives each output payload as soon as generation appends it, so a */
+/* consumer can start writing before the output is complete. The whole output still lands in */
+/* universal output. emit returning false stops generation early; it must not call into mfile */
+bool melvin_m_process_input_stream(MelvinMFile *mfile, OutputStreamFunc emit, void *ctx);
+
+/* True if the most recent process_input call was truncated by its deadline */
+bool melvin_m_last_process_truncated(MelvinMFile *mfile);
+
+/* Seed this brain's output sampling PRNG (xoshiro256**). Each file has its own stream, so */
+/* brains sample without a shared lock and a fixed seed reproduces outputs run to run */
+void melvin_m_set_seed(MelvinMFile *mfile, uint64_t seed);
+
+/* Fast output sampling: temperature is applied with a fast pow approximation (quantized to 1/32) and */
+/* nodes with at least alias_min_degree outgoing edges keep a Walker alias table, so a generation step */
+/* samples in O(1). Tables are rebuilt after the node's edge weights change. 0 = exact sampling (default) */
+void melvin_m_set_fast_sampling(MelvinMFile *mfile, size_t alias_min_degree);
+
+/* Decoding: how each output step is chosen, with hard caps for predictable latency */
+/*   MELVIN_DECODE_SAMPLE  - sample the whole candidate distribution (default) */
+/*   MELVIN_DECODE_NUCLEUS - sample only the top_k most likely candidates within top_p of the mass */
+/*   MELVIN_DECODE_BEAM    - deterministic: keep the beam_width most likely paths, emit the best */
+/* max_bytes / max_steps cap the output in every mode (0 = uncapped). Beam output is emitted */
+/* to a stream consumer once the search ends. NULL restores unbounded sampling */
+void melvin_m_set_decoding(MelvinMFile *mfile, const MelvinDecodeConfig *config);
+
+/* Process input with this call's decoding (NULL = the brain's default) and optional streaming */
+bool melvin_m_process_input_decode(MelvinMFile *mfile, const MelvinDecodeConfig *decode,
+                                   OutputStreamFunc emit, void *ctx);
+
+/* Growth governor: cap the optional structure (combined and generalization nodes, inherited and */
+/* law-created edges) one process_input call may add. Nodes: nodes_per_byte per input byte; edges: */
+/* that times log2 of the graph's node count. 0 = uncapped */
+/* While capped, the laws (context, similarity, generalization, combination, homeostatic) only */
+/* propose during the input; after propagation all proposals are ranked together - by how */
+/* clearly each clears its own law's threshold - and admitted strongest first. A combined node */
+/* brings its inherited edges (strongest first) with it. Proposed structure appears once the */
+/* wave has finished, not during it */
+void melvin_m_set_growth_budget(MelvinMFile *mfile, float nodes_per_byte);
+
+/* Cumulative accepted vs suppressed growth (counted whether or not a cap is set) */
+GrowthStats melvin_m_get_growth_stats(MelvinMFile *mfile);
+
+/* Output memoization: keep the last `capacity` outputs in an LRU keyed by start node, a hash of the */
+/* input context (last_activated) and the graph's structure version. A repeat input whose start */
+/* node and context match, with no node or edge added since, replays the stored output instead of */
+/* walking again (weight drift alone doesn't invalidate; the output PRNG isn't advanced). Deadline */
+/* truncated or consumer-stopped outputs aren't stored. 0 = off (default); false if allocation fails */
+bool melvin_m_set_output_cache(MelvinMFile *mfile, size_t capacity);
+
+/* Cumulative output cache hits, misses and evictions */
+OutputCacheStats melvin_m_get_output_cache_stats(MelvinMFile *mfile);
+
+/* Segmentation cache: remember the node sequence each input segmented into, in `slots` slots (rounded */
+/* up to a power of two, one input per slot by hash of its bytes). Byte-identical input arriving in */
+/* the same context (last_activated) with no node or edge added since replays that sequence instead */
+/* of repeating the neighbor searches. Inputs whose segmentation grew the graph aren't stored. */
+/* 0 = off (default); false if allocation fails */
+bool melvin_m_set_segment_cache(MelvinMFile *mfile, size_t slots);
+
+/* Cumulative segmentation cache hits, misses and uncached misses */
+SegmentCacheStats melvin_m_get_segment_cache_stats(MelvinMFile *mfile);
+
+/* Read-only query: segment, propagate and generate without learning or mutating the graph */
+/* All input bytes are segmented: frame it the way the brain was trained - port byte first after */
+/* universal_input_write, payload only after universal_input_write_payload (what ports learn) */
+/* Output is malloc'd (caller frees). Concurrent queries on one file are safe; not alongside learning */
+bool melvin_m_query(MelvinMFile *mfile, const uint8_t *input, size_t input_size,
+                    uint8_t **output, size_t *output_size);
+
+/* Read-only query with a wall-clock budget (0 = none); truncated (may be NULL) reports a deadline stop */
+bool melvin_m_query_deadline(MelvinMFile *mfile, const uint8_t *input, size_t input_size, uint64_t budget_us,
+                             uint8_t **output, size_t *output_size, bool *truncated);
+
+/* Cumulative query count, seeds matched and nodes reached beyond the seeds */
+QueryStats melvin_m_get_query_stats(MelvinMFile *mfile);
+
 /* ========================================
  * ADAPTIVE OPERATIONS
  * ======================================== */
@@ -107,8 +198,11 @@ uint64_t melvin_m_get_adaptation_count(MelvinMFile *mfile);
  * ======================================== */
 
 /* Get last input port ID from the most recent process_input call (for output routing) */
-/* Port ID is extracted from input buffer (CAN bus format: first byte is port_id) */
+/* Port ID comes from the input's metadata, or the input buffer's first byte (CAN bus format) */
 uint8_t melvin_m_get_last_input_port_id(MelvinMFile *mfile);
 
+/* Timestamp of the most recent process_input call's input (0 = written without metadata) */
+uint64_t melvin_m_get_last_input_timestamp(MelvinMFile *mfile);
+
 #endif /* MELVIN_M_H */
 
@@ -9,6 +9,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <pthread.h>
 
 #ifdef __APPLE__
 #include <mach/mach_time.h>
@@ -85,6 +86,23 @@ PortFrame* melvin_port_frame_deserialize(const uint8_t *buffer, size_t buffer_si
     return frame;
 }
 
+/* FRAMING: Header fields and payload of a serialized frame, read in place (no allocation) */
+/* Returns the payload (data_size bytes), NULL if the buffer is shorter than the frame claims */
+static const uint8_t* port_frame_payload(const uint8_t *buffer, size_t buffer_size,
+                                         MelvinInputMeta *meta, size_t *data_size) {
+    size_t header_size = sizeof(uint8_t) + sizeof(uint64_t) + sizeof(uint32_t);
+    if (!buffer || buffer_size < header_size) return NULL;
+    
+    uint32_t size;
+    meta->port_id = buffer[0];
+    memcpy(&meta->timestamp, buffer + sizeof(uint8_t), sizeof(uint64_t));
+    memcpy(&size, buffer + sizeof(uint8_t) + sizeof(uint64_t), sizeof(uint32_t));
+    if (buffer_size < header_size + size) return NULL;
+    
+    *data_size = size;
+    return buffer + header_size;
+}
+
 void melvin_port_frame_free(PortFrame *frame) {
     if (frame) {
         free(frame);
@@ -184,6 +202,9 @@ MelvinPortManager* melvin_port_manager_create(MelvinMFile *mfile) {
 void melvin_port_manager_free(MelvinPortManager *manager) {
     if (!manager) return;
     
+    /* Stop reader thread before ports go away */
+    melvin_port_manager_disable_pipeline(manager);
+    
     /* Close and free all ports */
     for (size_t i = 0; i < manager->port_count; i++) {
         if (manager->ports[i]) {
@@ -201,117 +222,397 @@ void melvin_port_manager_free(MelvinPortManager *manager) {
     free(manager);
 }
 
+/* Routed output port for an input port (NULL = no route, or the port is missing/closed) */
+static MelvinPort* port_manager_output_port(MelvinPortManager *manager, uint8_t input_port_id) {
+    uint8_t output_port_id = melvin_port_get_route(manager, input_port_id);
+    if (output_port_id == 0) return NULL;
+    
+    /* Production optimization: O(1) output port lookup via cache */
+    MelvinPort *output_port = manager->output_port_cache[output_port_id];
+    
+    /* Cache miss - do lookup and cache it */
+    if (!output_port) {
+        output_port = melvin_port_find(manager, output_port_id);
+        if (output_port) {
+            manager->output_port_cache[output_port_id] = output_port;
+        }
+    }
+    
+    if (!output_port || !output_port->is_open) return NULL;
+    return output_port;
+}
+
+/* STREAMING: Where generated payloads go while one input is processed */
+typedef struct PortStreamTarget {
+    MelvinPortManager *manager;
+    MelvinPort *port;
+} PortStreamTarget;
+
+/* STREAMING: Write one generated payload to the routed port as its own frame */
+/* The frame is built in the reusable output buffer (zero allocations per payload) */
+static bool port_stream_emit(const uint8_t *bytes, size_t size, void *ctx) {
+    PortStreamTarget *target = (PortStreamTarget*)ctx;
+    MelvinPortManager *manager = target->manager;
+    
+    size_t frame_size = sizeof(PortFrame) + size;
+    if (frame_size > manager->output_buffer_capacity) {
+        size_t new_capacity = frame_size * 2;
+        uint8_t *new_buf = (uint8_t*)realloc(manager->output_buffer, new_capacity);
+        if (!new_buf) return false;  /* End the output here rather than skip bytes mid-stream */
+        manager->output_buffer = new_buf;
+        manager->output_buffer_capacity = new_capacity;
+    }
+    
+    PortFrame *frame = (PortFrame*)manager->output_buffer;
+    frame->port_id = target->port->port_id;
+    frame->timestamp = melvin_port_get_timestamp();
+    frame->data_size = (uint32_t)size;
+    memcpy(frame->data, bytes, size);
+    melvin_port_write_frame(target->port, frame);
+    return true;
+}
+
+/* Process one serialized input frame through the .m file and route its output */
+/* Runs on the graph-owning thread only (serial loop or pipeline stage 2) */
+static bool port_manager_process_serialized(MelvinPortManager *manager,
+                                            const uint8_t *serialized, size_t size) {
+    /* FRAMING: Only the device payload is learned - port ID and timestamp go in as metadata */
+    MelvinInputMeta meta;
+    size_t payload_size = 0;
+    const uint8_t *payload = port_frame_payload(serialized, size, &meta, &payload_size);
+    if (!payload) return false;
+    
+    /* FRAMING: A header-only frame has no payload to learn from - consumed, nothing to do */
+    if (payload_size == 0) return true;
+    if (!melvin_m_universal_input_write_payload(manager->mfile, &meta, payload, payload_size)) {
+        return false;
+    }
+    
+    /* Route output to appropriate port (the frame's port ID is the input port ID) */
+    /* Resolved up front: the output port picks the decoding and may take streamed output */
+    MelvinPort *output_port = port_manager_output_port(manager, meta.port_id);
+    const MelvinDecodeConfig *decode = (output_port && output_port->has_decode) ? &output_port->decode : NULL;
+    
+    /* STREAMING: Output flows to the port while it is generated */
+    if (__atomic_load_n(&manager->stream_output, __ATOMIC_RELAXED) && output_port) {
+        PortStreamTarget target = { manager, output_port };
+        return melvin_m_process_input_decode(manager->mfile, decode, port_stream_emit, &target);
+    }
+    
+    /* Process through .m file */
+    if (!melvin_m_process_input_decode(manager->mfile, decode, NULL, NULL)) return false;
+    if (!output_port) return true;
+    uint8_t output_port_id = output_port->port_id;
+    
+    /* Read output from .m file */
+    size_t output_size = melvin_m_universal_output_size(manager->mfile);
+    if (output_size == 0) return true;
+    
+    /* Production optimization: Reuse output buffer (zero allocations) */
+    if (output_size > manager->output_buffer_capacity) {
+        size_t new_capacity = output_size * 2;
+        uint8_t *new_buf = (uint8_t*)realloc(manager->output_buffer, new_capacity);
+        if (!new_buf) return true;  /* Input was processed; only routing failed */
+        manager->output_buffer = new_buf;
+        manager->output_buffer_capacity = new_capacity;
+    }
+    
+    size_t read = melvin_m_universal_output_read(manager->mfile,
+                                                 manager->output_buffer,
+                                                 manager->output_buffer_capacity);
+    if (read > 0) {
+        /* Create output frame with output port ID */
+        /* Note: .m file output is raw data, not a PortFrame */
+        /* We wrap it in a PortFrame for the output port */
+        PortFrame *output_frame = melvin_port_frame_create(output_port_id,
+                                                            manager->output_buffer,
+                                                            read);
+        if (output_frame) {
+            /* Write to output port */
+            melvin_port_write_frame(output_port, output_frame);
+            melvin_port_frame_free(output_frame);
+        }
+    }
+    
+    return true;
+}
+
+/* Read one frame from port and serialize it into a growable buffer */
+/* Returns serialized size, 0 if the port had nothing (or on error) */
+static size_t port_read_serialized(MelvinPort *port, uint8_t **buffer, size_t *capacity) {
+    PortFrame *frame = NULL;
+    size_t frame_size = melvin_port_read_frame(port, &frame);
+    if (!frame || frame_size == 0) return 0;
+    
+    /* Production optimization: Reuse serialization buffer (zero allocations) */
+    size_t serialized_size = melvin_port_frame_serialized_size(frame);
+    if (serialized_size > *capacity) {
+        size_t new_capacity = serialized_size * 2;
+        uint8_t *new_buf = (uint8_t*)realloc(*buffer, new_capacity);
+        if (!new_buf) {
+            melvin_port_frame_free(frame);
+            return 0;
+        }
+        *buffer = new_buf;
+        *capacity = new_capacity;
+    }
+    
+    /* Serialize into reusable buffer, free input frame early (before processing) */
+    size_t written = melvin_port_frame_serialize(frame, *buffer, *capacity);
+    melvin_port_frame_free(frame);
+    
+    return written;
+}
+
+/* Input ports have a read callback (output-only ports have write_func but no read_func) */
+static bool port_is_input(MelvinPort *port) {
+    return port && port->is_open && !(port->write_func && !port->read_func);
+}
+
+static bool port_pipeline_process_staged(MelvinPortManager *manager);
+
 bool melvin_port_manager_process_all(MelvinPortManager *manager) {
     if (!manager || !manager->mfile) return false;
     
+    /* PIPELINED: Frames were read ahead by the reader thread - process staged frames */
+    if (manager->pipeline) {
+        return port_pipeline_process_staged(manager);
+    }
+    
     bool any_processed = false;
     
     /* Process all input ports (mic, camera, CAN bus) */
     for (size_t i = 0; i < manager->port_count; i++) {
         MelvinPort *port = manager->ports[i];
-        if (!port || !port->is_open) continue;
+        if (!port_is_input(port)) continue;
         
-        /* Only process input ports (skip output-only ports) */
-        /* Output-only ports have write_func but no read_func */
-        if (port->write_func && !port->read_func) continue;
+        /* Read frame from port and serialize for .m file */
+        size_t written = port_read_serialized(port, &manager->serialize_buffer,
+                                              &manager->serialize_buffer_capacity);
+        if (written == 0) continue;
         
-        /* Read frame from port */
-        PortFrame *frame = NULL;
-        size_t frame_size = melvin_port_read_frame(port, &frame);
+        if (port_manager_process_serialized(manager, manager->serialize_buffer, written)) {
+            any_processed = true;
+        }
         
-        if (frame && frame_size > 0) {
-            /* Serialize frame for .m file */
-            size_t serialized_size = melvin_port_frame_serialized_size(frame);
-            if (serialized_size > 0) {
-                /* Production optimization: Reuse serialization buffer (zero allocations) */
-                if (serialized_size > manager->serialize_buffer_capacity) {
-                    size_t new_capacity = serialized_size * 2;
-                    uint8_t *new_buf = (uint8_t*)realloc(manager->serialize_buffer, new_capacity);
-                    if (!new_buf) {
-                        melvin_port_frame_free(frame);
-                        continue;
-                    }
-                    manager->serialize_buffer = new_buf;
-                    manager->serialize_buffer_capacity = new_capacity;
-                }
-                
-                /* Serialize into reusable buffer */
-                size_t written = melvin_port_frame_serialize(frame, 
-                                                             manager->serialize_buffer, 
-                                                             manager->serialize_buffer_capacity);
-                /* Free input frame early (before processing) */
-                melvin_port_frame_free(frame);
-                
-                if (written > 0) {
-                    melvin_m_universal_input_write(manager->mfile, 
-                                                   manager->serialize_buffer, 
-                                                   written);
-                    
-                    /* Process through .m file */
-                    if (melvin_m_process_input(manager->mfile)) {
-                        any_processed = true;
-                        
-                        /* Route output to appropriate port */
-                        uint8_t input_port_id = melvin_m_get_last_input_port_id(manager->mfile);
-                        uint8_t output_port_id = melvin_port_get_route(manager, input_port_id);
-                        
-                        if (output_port_id != 0) {
-                            /* Production optimization: O(1) output port lookup via cache */
-                            MelvinPort *output_port = manager->output_port_cache[output_port_id];
-                            
-                            /* Cache miss - do lookup and cache it */
-                            if (!output_port) {
-                                output_port = melvin_port_find(manager, output_port_id);
-                                if (output_port) {
-                                    manager->output_port_cache[output_port_id] = output_port;
-                                }
-                            }
-                            
-                            if (output_port && output_port->is_open) {
-                                /* Read output from .m file */
-                                size_t output_size = melvin_m_universal_output_size(manager->mfile);
-                                if (output_size > 0) {
-                                    /* Production optimization: Reuse output buffer (zero allocations) */
-                                    if (output_size > manager->output_buffer_capacity) {
-                                        size_t new_capacity = output_size * 2;
-                                        uint8_t *new_buf = (uint8_t*)realloc(manager->output_buffer, new_capacity);
-                                        if (!new_buf) continue;
-                                        manager->output_buffer = new_buf;
-                                        manager->output_buffer_capacity = new_capacity;
-                                    }
-                                    
-                                    size_t read = melvin_m_universal_output_read(manager->mfile,
-                                                                                 manager->output_buffer,
-                                                                                 manager->output_buffer_capacity);
-                                    if (read > 0) {
-                                        /* Create output frame with output port ID */
-                                        /* Note: .m file output is raw data, not a PortFrame */
-                                        /* We wrap it in a PortFrame for the output port */
-                                        PortFrame *output_frame = melvin_port_frame_create(output_port_id,
-                                                                                            manager->output_buffer,
-                                                                                            read);
-                                        if (output_frame) {
-                                            /* Write to output port */
-                                            melvin_port_write_frame(output_port, output_frame);
-                                            melvin_port_frame_free(output_frame);
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            } else {
-                melvin_port_frame_free(frame);
+        port->frames_read++;
+    }
+    
+    return any_processed;
+}
+
+/* ========================================
+ * STAGED PIPELINE
+ * ======================================== */
+
+/* Staging slot: one serialized frame owned by the reader until published */
+typedef struct {
+    MelvinPort *port;
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+} StagedFrame;
+
+/* Bounded FIFO ring between reader thread (producer) and graph thread (consumer) */
+struct MelvinPortPipeline {
+    pthread_t reader_thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty;       /* Signaled when a frame is staged or a sweep came up empty */
+    pthread_cond_t not_full;        /* Signaled when the consumer releases a slot */
+    pthread_cond_t sweep_wake;      /* Signaled when the consumer requests another sweep */
+    
+    StagedFrame *slots;
+    size_t depth;
+    size_t head;                    /* Oldest staged frame (consumer side) */
+    size_t count;                   /* Staged frames, including the one being processed */
+    
+    bool sweep_requested;           /* Reader keeps sweeping while true */
+    bool sweep_empty;               /* Last sweep read nothing - reader is parked */
+    bool stop;
+};
+
+/* Stage 1: sweep input ports in index order, stage each frame (never touches the graph) */
+static void* port_pipeline_reader(void *arg) {
+    MelvinPortManager *manager = (MelvinPortManager*)arg;
+    MelvinPortPipeline *pl = manager->pipeline;
+    
+    pthread_mutex_lock(&pl->mutex);
+    while (!pl->stop) {
+        /* Park after an empty sweep until the graph thread polls again (same cadence as serial) */
+        while (!pl->stop && !pl->sweep_requested) {
+            pthread_cond_wait(&pl->sweep_wake, &pl->mutex);
+        }
+        if (pl->stop) break;
+        pthread_mutex_unlock(&pl->mutex);
+        
+        bool produced = false;
+        for (size_t i = 0; i < manager->port_count; i++) {
+            MelvinPort *port = manager->ports[i];
+            if (!port_is_input(port)) continue;
+            
+            /* Bounded read-ahead: wait for a free slot */
+            pthread_mutex_lock(&pl->mutex);
+            while (!pl->stop && pl->count == pl->depth) {
+                pthread_cond_wait(&pl->not_full, &pl->mutex);
+            }
+            if (pl->stop) {
+                pthread_mutex_unlock(&pl->mutex);
+                break;
             }
+            StagedFrame *slot = &pl->slots[(pl->head + pl->count) % pl->depth];
+            pthread_mutex_unlock(&pl->mutex);
             
-            port->frames_read++;
+            /* Read + serialize outside the lock (free slot is reader-owned until published) */
+            size_t written = port_read_serialized(port, &slot->data, &slot->capacity);
+            if (written == 0) continue;
+            slot->port = port;
+            slot->size = written;
+            
+            /* Publish */
+            pthread_mutex_lock(&pl->mutex);
+            pl->count++;
+            pthread_cond_signal(&pl->not_empty);
+            pthread_mutex_unlock(&pl->mutex);
+            produced = true;
+        }
+        
+        pthread_mutex_lock(&pl->mutex);
+        if (!produced) {
+            pl->sweep_requested = false;
+            pl->sweep_empty = true;
+            pthread_cond_signal(&pl->not_empty);
+        }
+    }
+    pthread_mutex_unlock(&pl->mutex);
+    
+    return NULL;
+}
+
+/* Stage 2 helper: process the oldest staged frame, then release its slot */
+static bool port_pipeline_process_head(MelvinPortManager *manager) {
+    MelvinPortPipeline *pl = manager->pipeline;
+    
+    /* Head slot stays counted while processing, so the reader cannot overwrite it */
+    StagedFrame *slot = &pl->slots[pl->head];
+    bool processed = port_manager_process_serialized(manager, slot->data, slot->size);
+    slot->port->frames_read++;
+    
+    pthread_mutex_lock(&pl->mutex);
+    pl->head = (pl->head + 1) % pl->depth;
+    pl->count--;
+    pthread_cond_signal(&pl->not_full);
+    pthread_mutex_unlock(&pl->mutex);
+    
+    return processed;
+}
+
+/* Stage 2: process frames staged so far (waits for the reader if none are ready yet) */
+static bool port_pipeline_process_staged(MelvinPortManager *manager) {
+    MelvinPortPipeline *pl = manager->pipeline;
+    
+    pthread_mutex_lock(&pl->mutex);
+    while (pl->count == 0 && !pl->sweep_empty) {
+        pthread_cond_wait(&pl->not_empty, &pl->mutex);
+    }
+    
+    if (pl->count == 0) {
+        /* Reader's last sweep read nothing: report it like serial mode, re-arm the next sweep */
+        pl->sweep_empty = false;
+        pl->sweep_requested = true;
+        pthread_cond_signal(&pl->sweep_wake);
+        pthread_mutex_unlock(&pl->mutex);
+        return false;
+    }
+    
+    /* Only frames staged at entry (bounded work per call, like one serial sweep) */
+    size_t available = pl->count;
+    pthread_mutex_unlock(&pl->mutex);
+    
+    bool any_processed = false;
+    for (size_t i = 0; i < available; i++) {
+        if (port_pipeline_process_head(manager)) {
+            any_processed = true;
         }
     }
     
     return any_processed;
 }
 
+bool melvin_port_manager_enable_pipeline(MelvinPortManager *manager, size_t depth) {
+    if (!manager || !manager->mfile) return false;
+    if (manager->pipeline) return true;  /* Already running */
+    
+    MelvinPortPipeline *pl = (MelvinPortPipeline*)calloc(1, sizeof(MelvinPortPipeline));
+    if (!pl) return false;
+    
+    /* Default: double buffering (frame N processing while frame N+1 is read) */
+    pl->depth = (depth > 0) ? depth : 2;
+    pl->slots = (StagedFrame*)calloc(pl->depth, sizeof(StagedFrame));
+    if (!pl->slots) {
+        free(pl);
+        return false;
+    }
+    
+    pthread_mutex_init(&pl->mutex, NULL);
+    pthread_cond_init(&pl->not_empty, NULL);
+    pthread_cond_init(&pl->not_full, NULL);
+    pthread_cond_init(&pl->sweep_wake, NULL);
+    pl->sweep_requested = true;  /* Start reading ahead immediately */
+    
+    manager->pipeline = pl;
+    if (pthread_create(&pl->reader_thread, NULL, port_pipeline_reader, manager) != 0) {
+        manager->pipeline = NULL;
+        pthread_cond_destroy(&pl->sweep_wake);
+        pthread_cond_destroy(&pl->not_full);
+        pthread_cond_destroy(&pl->not_empty);
+        pthread_mutex_destroy(&pl->mutex);
+        free(pl->slots);
+        free(pl);
+        return false;
+    }
+    
+    return true;
+}
+
+void melvin_port_manager_disable_pipeline(MelvinPortManager *manager) {
+    if (!manager || !manager->pipeline) return;
+    MelvinPortPipeline *pl = manager->pipeline;
+    
+    pthread_mutex_lock(&pl->mutex);
+    pl->stop = true;
+    pthread_cond_broadcast(&pl->sweep_wake);
+    pthread_cond_broadcast(&pl->not_full);
+    pthread_mutex_unlock(&pl->mutex);
+    pthread_join(pl->reader_thread, NULL);
+    
+    /* Drain: frames already read from devices are processed, in order (no input lost) */
+    while (pl->count > 0) {
+        port_pipeline_process_head(manager);
+    }
+    
+    for (size_t i = 0; i < pl->depth; i++) {
+        free(pl->slots[i].data);
+    }
+    pthread_cond_destroy(&pl->sweep_wake);
+    pthread_cond_destroy(&pl->not_full);
+    pthread_cond_destroy(&pl->not_empty);
+    pthread_mutex_destroy(&pl->mutex);
+    free(pl->slots);
+    free(pl);
+    manager->pipeline = NULL;
+}
+
+bool melvin_port_manager_pipeline_enabled(MelvinPortManager *manager) {
+    return manager && manager->pipeline;
+}
+
+/* STREAMING: Takes effect with the next processed input (safe while the pipeline runs - */
+/* written atomically here, read atomically by the graph-owning thread) */
+void melvin_port_manager_set_streaming(MelvinPortManager *manager, bool enabled) {
+    if (!manager) return;
+    __atomic_store_n(&manager->stream_output, enabled, __ATOMIC_RELAXED);
+}
+
 /* ========================================
  * PORT REGISTRATION
  * ======================================== */
@@ -324,6 +625,9 @@ MelvinPort* melvin_port_register(MelvinPortManager *manager,
         return NULL;
     }
     
+    /* Reader thread iterates the ports array - no changes while pipelined */
+    if (manager->pipeline) return NULL;
+    
     /* Check if port_id already exists */
     if (melvin_port_find(manager, port_id) != NULL) {
         return NULL;  /* Port ID already in use */
@@ -370,7 +674,7 @@ MelvinPort* melvin_port_register(MelvinPortManager *manager,
 }
 
 bool melvin_port_unregister(MelvinPortManager *manager, uint8_t port_id) {
-    if (!manager) return false;
+    if (!manager || manager->pipeline) return false;  /* No changes while pipelined */
     
     /* Find port */
     for (size_t i = 0; i < manager->port_count; i++) {
@@ -446,6 +750,13 @@ bool melvin_port_is_open(MelvinPort *port) {
     return port && port->is_open;
 }
 
+/* DECODING: Applies from the next input whose output is routed to this port */
+void melvin_port_set_decoding(MelvinPort *port, const MelvinDecodeConfig *config) {
+    if (!port) return;
+    port->has_decode = (config != NULL);
+    if (config) port->decode = *config;
+}
+
 /* ========================================
  * PORT DATA I/O
  * ======================================== */
@@ -500,23 +811,17 @@ bool melvin_port_process_input(MelvinPort *port, MelvinMFile *mfile) {
     
     if (!frame || frame_size == 0) return false;
     
-    /* Serialize and write to .m file */
-    uint8_t *serialized = (uint8_t*)malloc(frame_size);
-    if (!serialized) {
+    /* FRAMING: A header-only frame has no payload to learn from - consumed, nothing to do */
+    if (frame->data_size == 0) {
         melvin_port_frame_free(frame);
-        return false;
+        return true;
     }
     
-    size_t written = melvin_port_frame_serialize(frame, serialized, frame_size);
+    /* FRAMING: Write the payload to .m file, frame header as metadata (not learned) */
+    MelvinInputMeta meta = { frame->port_id, frame->timestamp };
+    bool written = melvin_m_universal_input_write_payload(mfile, &meta, frame->data, frame->data_size);
     melvin_port_frame_free(frame);
-    
-    if (written == 0) {
-        free(serialized);
-        return false;
-    }
-    
-    melvin_m_universal_input_write(mfile, serialized, written);
-    free(serialized);
+    if (!written) return false;
     
     return melvin_m_process_input(mfile);
 }
@@ -72,8 +72,15 @@ struct MelvinPort {
     uint8_t *read_buffer;
     size_t read_buffer_size;
     size_t read_buffer_capacity;
+    
+    /* Decoding for output routed to this port (false = the brain's default) */
+    bool has_decode;
+    MelvinDecodeConfig decode;
 };
 
+/* Staged pipeline state (opaque - see melvin_port_manager_enable_pipeline) */
+typedef struct MelvinPortPipeline MelvinPortPipeline;
+
 /* Port Manager */
 typedef struct {
     MelvinPort **ports;
@@ -94,6 +101,12 @@ typedef struct {
     
     /* Production optimization: Output port cache (O(1) lookup instead of O(n)) */
     MelvinPort *output_port_cache[256];  /* Maps port_id -> port* for output ports */
+    
+    /* Staged pipeline: reader thread stages frames while this thread processes (NULL = serial) */
+    MelvinPortPipeline *pipeline;
+    
+    /* Streaming output: routed ports get one frame per generated payload (false = one frame per input) */
+    bool stream_output;  /* Atomic access: set from any thread, read on the graph-owning thread */
 } MelvinPortManager;
 
 /* ========================================
@@ -106,9 +119,54 @@ MelvinPortManager* melvin_port_manager_create(MelvinMFile *mfile);
 /* Free port manager and all ports */
 void melvin_port_manager_free(MelvinPortManager *manager);
 
-/* Process all ports: read inputs, send to .m file, route outputs */
+/* Process all ports: read inputs, send payloads to .m file (frame header as metadata), route outputs */
+/* Pipelined mode: processes the frames staged by the reader thread instead of reading inline */
 bool melvin_port_manager_process_all(MelvinPortManager *manager);
 
+/* ========================================
+ * STAGED PIPELINE
+ * ========================================
+ * Stage 1 (reader thread): read device frame -> serialize into a staging slot.
+ * Stage 2 (calling thread): segmentation -> edge formation -> propagation -> output -> route.
+ *
+ * Staging point: the serialized frame. The reader never touches the .m file or graph,
+ * so reading frame N+1 overlaps with processing frame N.
+ *
+ * Ordering rules:
+ *   - Frames are processed in staging order (FIFO), which is the serial sweep order
+ *     (port index order within a sweep, sweeps in sequence).
+ *   - The graph has a single owner: the thread calling process_all. Segmentation of
+ *     frame N+1 starts only after frame N finished (it matches against frame N's
+ *     last_activated context and creates nodes), so results equal serial mode.
+ *   - Read-ahead is bounded by the staging depth; the reader blocks when all slots are full.
+ *   - Port registration/unregistration is refused while the pipeline runs.
+ *   - Port bytes_read statistics are updated by the reader thread.
+ *
+ * Scope: only reading and serialization overlap with processing. Segmentation is not
+ * staged, not even as a read-only pre-pass: it reads node adjacency and payloads that
+ * stage 2 is reallocating and rewriting, so it would need a graph snapshot or a lock
+ * held across propagation (which serializes the stages again). Segmentation is also a
+ * small share of processing - about 5% of process_input time on text, against about
+ * 90% for propagation - so staging it would bound throughput gains at that share. */
+
+/* Start reader thread with `depth` staging slots (0 = double buffering) */
+bool melvin_port_manager_enable_pipeline(MelvinPortManager *manager, size_t depth);
+
+/* Stop reader thread; frames already staged are processed first (no input is lost) */
+void melvin_port_manager_disable_pipeline(MelvinPortManager *manager);
+
+/* Check if staged pipeline mode is active */
+bool melvin_port_manager_pipeline_enabled(MelvinPortManager *manager);
+
+/* ========================================
+ * STREAMING OUTPUT
+ * ========================================
+ * Routed output ports receive a frame for each payload as output generation emits it,
+ * instead of one frame after the whole output is built. Bytes reach the device in the
+ * same order; only the frame boundaries differ. Universal output still holds the full
+ * output after each input. Off by default. */
+void melvin_port_manager_set_streaming(MelvinPortManager *manager, bool enabled);
+
 /* ========================================
  * PORT REGISTRATION
  * ======================================== */
@@ -138,6 +196,10 @@ void melvin_port_close(MelvinPort *port);
 /* Check if port is open */
 bool melvin_port_is_open(MelvinPort *port);
 
+/* Decoding mode and caps for output routed to this port, e.g. bounded nucleus for a speaker */
+/* (NULL = use the brain's default set with melvin_m_set_decoding) */
+void melvin_port_set_decoding(MelvinPort *port, const MelvinDecodeConfig *config);
+
 /* ========================================
  * PORT DATA I/O
  * ======================================== */
@@ -150,7 +212,7 @@ size_t melvin_port_read_frame(MelvinPort *port, PortFrame **frame_out);
 /* Returns bytes written to device, 0 on error */
 size_t melvin_port_write_frame(MelvinPort *port, const PortFrame *frame);
 
-/* Process input from port: read, package, send to .m file, process */
+/* Process input from port: read, send payload to .m file (frame header as metadata), process */
 bool melvin_port_process_input(MelvinPort *port, MelvinMFile *mfile);
 
 /* ========================================
@@ -0,0 +1,65 @@
+/*
+ * Test Corpus: shared reference corpus for the benchmark and check programs
+ */
+
+#define _POSIX_C_SOURCE 200809L  /* strdup */
+
+#include "test_corpus.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *builtin_corpus[] = {
+    "the cat sat on the mat",
+    "the cat ran to the hat",
+    "a dog sat on the log",
+    "the dog ran after the cat",
+    "hello world",
+    "hello there world",
+    "world of hello and cats",
+    "cats and dogs sat together",
+};
+
+char** test_corpus_load(const char *path, size_t *count) {
+    *count = 0;
+
+    if (!path) {
+        size_t n = sizeof(builtin_corpus) / sizeof(builtin_corpus[0]);
+        char **lines = (char**)malloc(n * sizeof(char*));
+        if (!lines) return NULL;
+        for (size_t i = 0; i < n; i++) lines[i] = strdup(builtin_corpus[i]);
+        *count = n;
+        return lines;
+    }
+
+    size_t capacity = 1;  /* Minimal context: start at 1 */
+    char **lines = (char**)malloc(capacity * sizeof(char*));
+    if (!lines) return NULL;
+
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        free(lines);
+        return NULL;
+    }
+    char buffer[4096];
+    while (fgets(buffer, sizeof(buffer), f)) {
+        size_t len = strcspn(buffer, "\r\n");
+        if (len == 0) continue;
+        buffer[len] = '\0';
+        if (*count >= capacity) {
+            capacity *= 2;
+            char **new_lines = (char**)realloc(lines, capacity * sizeof(char*));
+            if (!new_lines) break;
+            lines = new_lines;
+        }
+        lines[(*count)++] = strdup(buffer);
+    }
+    fclose(f);
+    return lines;
+}
+
+void test_corpus_free(char **lines, size_t count) {
+    if (!lines) return;
+    for (size_t i = 0; i < count; i++) free(lines[i]);
+    free(lines);
+}
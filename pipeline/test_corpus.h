@@ -0,0 +1,19 @@
+/*
+ * Test Corpus: shared reference corpus for the benchmark and check programs
+ *
+ * One training sample per line, from a file or the built-in corpus.
+ */
+
+#ifndef TEST_CORPUS_H
+#define TEST_CORPUS_H
+
+#include <stddef.h>
+
+/* Load corpus lines from path (NULL = built-in corpus); NULL on failure */
+/* Caller frees with test_corpus_free */
+char** test_corpus_load(const char *path, size_t *count);
+
+/* Free lines returned by test_corpus_load */
+void test_corpus_free(char **lines, size_t count);
+
+#endif /* TEST_CORPUS_H */
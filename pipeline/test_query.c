@@ -0,0 +1,136 @@
+/*
+ * Read-only Query Check: queries answer without learning, and still propagate
+ *
+ * Trains a brain on a reference corpus, then runs the first half of each
+ * sample through melvin_m_query (single-threaded, then from several threads
+ * at once) and checks:
+ *   - node count, edge count and every edge weight are unchanged
+ *   - the file is not marked dirty
+ *   - propagation reached nodes beyond the seeds the inputs matched
+ *
+ * Usage: query [corpus.txt] [work.m]
+ *   corpus.txt   one training sample per line (default or "": built-in corpus)
+ *   work.m       brain file to create (default: query.m)
+ *
+ * Exits non-zero if any check fails.
+ */
+
+#include "melvin_m.h"
+#include "test_corpus.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#define TRAIN_PASSES 10
+#define QUERY_THREADS 4
+#define QUERIES_PER_THREAD 50
+#define PORT_ID 1
+
+static char **lines = NULL;
+static size_t line_count = 0;
+static MelvinMFile *brain = NULL;
+
+/* Frame text as universal input (first byte is the port) */
+static size_t frame_sample(const char *text, size_t len, uint8_t *input, size_t input_size) {
+    if (len > input_size - 1) len = input_size - 1;
+    input[0] = PORT_ID;
+    memcpy(input + 1, text, len);
+    return len + 1;
+}
+
+/* Query the first half of sample i */
+static bool run_query(size_t i) {
+    uint8_t input[4097];
+    size_t size = frame_sample(lines[i], (strlen(lines[i]) + 1) / 2, input, sizeof(input));
+    uint8_t *output = NULL;
+    size_t output_size = 0;
+    bool ok = melvin_m_query(brain, input, size, &output, &output_size);
+    free(output);
+    return ok;
+}
+
+static void* query_worker(void *arg) {
+    size_t offset = (size_t)(uintptr_t)arg;
+    for (size_t r = 0; r < QUERIES_PER_THREAD; r++) {
+        run_query((offset + r) % line_count);
+    }
+    return NULL;
+}
+
+/* Order-sensitive sum of every edge weight */
+static double weight_signature(MelvinGraph *g) {
+    double sum = 0.0;
+    for (size_t i = 0; i < g->edge_count; i++) {
+        sum += (double)g->edges[i]->weight * (double)(i + 1);
+    }
+    return sum;
+}
+
+int main(int argc, char **argv) {
+    const char *corpus_path = (argc > 1 && argv[1][0]) ? argv[1] : NULL;  /* "" = built-in */
+    const char *path = (argc > 2) ? argv[2] : "query.m";
+
+    lines = test_corpus_load(corpus_path, &line_count);
+    if (!lines || line_count == 0) {
+        fprintf(stderr, "Error: could not load corpus %s\n", corpus_path ? corpus_path : "(built-in)");
+        return 1;
+    }
+
+    remove(path);
+    brain = melvin_m_create(path);
+    if (!brain) {
+        fprintf(stderr, "Error: could not create %s\n", path);
+        return 1;
+    }
+    melvin_m_set_seed(brain, 1);
+
+    uint8_t input[4097];
+    for (int pass = 0; pass < TRAIN_PASSES; pass++) {
+        for (size_t i = 0; i < line_count; i++) {
+            size_t size = frame_sample(lines[i], strlen(lines[i]), input, sizeof(input));
+            melvin_m_universal_input_write(brain, input, size);
+            melvin_m_process_input(brain);
+        }
+    }
+    melvin_m_save(brain);
+
+    MelvinGraph *g = melvin_m_get_graph(brain);
+    size_t nodes_before = g->node_count;
+    size_t edges_before = g->edge_count;
+    double signature_before = weight_signature(g);
+
+    size_t failed_queries = 0;
+    for (size_t i = 0; i < line_count; i++) {
+        if (!run_query(i)) failed_queries++;
+    }
+
+    pthread_t threads[QUERY_THREADS];
+    for (size_t t = 0; t < QUERY_THREADS; t++) {
+        pthread_create(&threads[t], NULL, query_worker, (void*)(uintptr_t)t);
+    }
+    for (size_t t = 0; t < QUERY_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    QueryStats stats = melvin_m_get_query_stats(brain);
+    bool unchanged = g->node_count == nodes_before && g->edge_count == edges_before &&
+                     weight_signature(g) == signature_before;
+    bool clean = !melvin_m_is_dirty(brain);
+    bool propagated = stats.queries > 0 && stats.reached > 0;
+
+    printf("=== Read-only Query Check ===\n");
+    printf("Corpus: %s (%zu samples, %d passes)\n", corpus_path ? corpus_path : "built-in",
+           line_count, TRAIN_PASSES);
+    printf("Graph: %zu nodes, %zu edges\n", nodes_before, edges_before);
+    printf("Queries: %llu answered (%zu failed), %llu seeds, %llu nodes reached beyond seeds\n",
+           (unsigned long long)stats.queries, failed_queries,
+           (unsigned long long)stats.seeds, (unsigned long long)stats.reached);
+    printf("Graph unchanged: %s\n", unchanged ? "yes" : "NO");
+    printf("File clean: %s\n", clean ? "yes" : "NO");
+    printf("Propagated beyond seeds: %s\n", propagated ? "yes" : "NO");
+
+    melvin_m_close(brain);
+    test_corpus_free(lines, line_count);
+    return (failed_queries == 0 && unchanged && clean && propagated) ? 0 : 1;
+}
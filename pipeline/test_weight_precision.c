@@ -0,0 +1,176 @@
+/*
+ * Weight Precision Benchmark: half-precision edge weights vs fp32
+ *
+ * Trains a brain on a reference corpus, then stores the edge section twice:
+ * once as fp32 and once as IEEE half (MELVIN_M_FLAG_HALF_WEIGHTS). Both files
+ * are reopened and compared:
+ *   - per-edge weight error (max absolute, mean relative)
+ *   - output agreement when the same probes are run through both brains
+ *   - file size and in-memory edge record size
+ *
+ * Usage: weight_precision [corpus.txt] [work_prefix]
+ *   corpus.txt   one training sample per line (default or "": built-in corpus)
+ *   work_prefix  path prefix for the two .m files (default: weight_precision)
+ *
+ * Build with `make compact weight_precision` to run the same corpus with
+ * half weights in memory as well; compare its report against the fp32 build.
+ */
+
+#include "melvin_m.h"
+#include "test_corpus.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/stat.h>
+
+#define TRAIN_PASSES 20
+#define PORT_ID 1
+
+/* Feed one sample through the brain; returns output size (output copied to out) */
+static size_t run_sample(MelvinMFile *mfile, const char *text, size_t len, uint8_t *out, size_t out_size) {
+    uint8_t input[4097];
+    if (len > sizeof(input) - 1) len = sizeof(input) - 1;
+    input[0] = PORT_ID;  /* CAN-style frame: first byte is the port */
+    memcpy(input + 1, text, len);
+
+    melvin_m_universal_input_write(mfile, input, len + 1);
+    melvin_m_process_input(mfile);
+    return melvin_m_universal_output_read(mfile, out, out_size);
+}
+
+static bool copy_file(const char *from, const char *to) {
+    FILE *in = fopen(from, "rb");
+    if (!in) return false;
+    FILE *out = fopen(to, "wb");
+    if (!out) {
+        fclose(in);
+        return false;
+    }
+    char buffer[65536];
+    size_t n;
+    bool ok = true;
+    while ((n = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+        if (fwrite(buffer, 1, n, out) != n) {
+            ok = false;
+            break;
+        }
+    }
+    fclose(in);
+    fclose(out);
+    return ok;
+}
+
+static long file_size(const char *path) {
+    struct stat st;
+    return (stat(path, &st) == 0) ? (long)st.st_size : -1;
+}
+
+int main(int argc, char **argv) {
+    const char *corpus_path = (argc > 1 && argv[1][0]) ? argv[1] : NULL;  /* "" = built-in */
+    const char *prefix = (argc > 2) ? argv[2] : "weight_precision";
+
+    char path_f32[1024], path_f16[1024];
+    snprintf(path_f32, sizeof(path_f32), "%s_f32.m", prefix);
+    snprintf(path_f16, sizeof(path_f16), "%s_f16.m", prefix);
+
+    size_t line_count = 0;
+    char **lines = test_corpus_load(corpus_path, &line_count);
+    if (!lines || line_count == 0) {
+        fprintf(stderr, "Error: could not load corpus %s\n", corpus_path ? corpus_path : "(built-in)");
+        return 1;
+    }
+
+    /* Train the reference brain (fp32 edge section) */
+    remove(path_f32);
+    MelvinMFile *train = melvin_m_create(path_f32);
+    if (!train) {
+        fprintf(stderr, "Error: could not create %s\n", path_f32);
+        return 1;
+    }
+    melvin_m_set_half_weights(train, false);
+    melvin_m_set_seed(train, 1);
+
+    uint8_t out[4096];
+    for (int pass = 0; pass < TRAIN_PASSES; pass++) {
+        for (size_t i = 0; i < line_count; i++) {
+            run_sample(train, lines[i], strlen(lines[i]), out, sizeof(out));
+        }
+    }
+    melvin_m_close(train);  /* Saves */
+
+    /* Same brain, edge section re-encoded as half */
+    if (!copy_file(path_f32, path_f16)) {
+        fprintf(stderr, "Error: could not copy %s\n", path_f32);
+        return 1;
+    }
+    MelvinMFile *convert = melvin_m_open(path_f16);
+    if (!convert) {
+        fprintf(stderr, "Error: could not open %s\n", path_f16);
+        return 1;
+    }
+    melvin_m_set_half_weights(convert, true);
+    melvin_m_save(convert);
+    melvin_m_close(convert);
+
+    MelvinMFile *ref = melvin_m_open(path_f32);
+    MelvinMFile *half = melvin_m_open(path_f16);
+    if (!ref || !half) {
+        fprintf(stderr, "Error: could not reopen brains\n");
+        return 1;
+    }
+    MelvinGraph *g32 = melvin_m_get_graph(ref);
+    MelvinGraph *g16 = melvin_m_get_graph(half);
+
+    /* Weight error (edges load in file order, so index i is the same edge in both) */
+    size_t compared = (g32->edge_count < g16->edge_count) ? g32->edge_count : g16->edge_count;
+    double max_abs = 0.0, sum_rel = 0.0;
+    size_t rel_count = 0;
+    for (size_t i = 0; i < compared; i++) {
+        double w32 = g32->edges[i]->weight;
+        double w16 = g16->edges[i]->weight;
+        double err = fabs(w32 - w16);
+        if (err > max_abs) max_abs = err;
+        if (w32 != 0.0) {
+            sum_rel += err / fabs(w32);
+            rel_count++;
+        }
+    }
+
+    /* Output agreement: same probes, same random stream, both brains keep learning */
+    size_t exact = 0, bytes_same = 0, bytes_total = 0;
+    for (size_t i = 0; i < line_count; i++) {
+        size_t probe_len = (strlen(lines[i]) + 1) / 2;  /* First half of each sample */
+        uint8_t out32[4096], out16[4096];
+        melvin_m_set_seed(ref, i + 1);
+        size_t n32 = run_sample(ref, lines[i], probe_len, out32, sizeof(out32));
+        melvin_m_set_seed(half, i + 1);
+        size_t n16 = run_sample(half, lines[i], probe_len, out16, sizeof(out16));
+
+        if (n32 == n16 && memcmp(out32, out16, n32) == 0) exact++;
+        size_t longest = (n32 > n16) ? n32 : n16;
+        size_t shortest = (n32 < n16) ? n32 : n16;
+        for (size_t b = 0; b < shortest; b++) {
+            if (out32[b] == out16[b]) bytes_same++;
+        }
+        bytes_total += longest;
+    }
+
+    printf("=== Weight Precision Benchmark ===\n");
+    printf("Corpus: %s (%zu samples, %d passes)\n", corpus_path ? corpus_path : "built-in",
+           line_count, TRAIN_PASSES);
+    printf("In-memory weights: %s (Edge record %zu bytes)\n",
+           sizeof(EdgeWeight) == 2 ? "half" : "fp32", sizeof(Edge));
+    printf("Graph: %zu nodes, %zu edges (half file: %zu edges)\n",
+           g32->node_count, g32->edge_count, g16->edge_count);
+    printf("File size: fp32 %ld bytes, half %ld bytes\n", file_size(path_f32), file_size(path_f16));
+    printf("Edge weight error: max abs %.3g, mean rel %.3g\n",
+           max_abs, rel_count > 0 ? sum_rel / (double)rel_count : 0.0);
+    printf("Output agreement: %zu/%zu probes identical, %.1f%% bytes identical\n",
+           exact, line_count, bytes_total > 0 ? 100.0 * (double)bytes_same / (double)bytes_total : 100.0);
+
+    melvin_m_close(ref);
+    melvin_m_close(half);
+    test_corpus_free(lines, line_count);
+    return 0;
+}